@@ -0,0 +1,517 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// C++ Wrappers for a complex ball arithmetic [acb_t]().
+
+#ifndef LIBARBXX_ACB_HPP
+#define LIBARBXX_ACB_HPP
+
+#include <acb.h>
+#include <flint/flintxx/frandxx.h>
+#include <gmpxx.h>
+
+#include <complex>
+#include <iosfwd>
+#include <optional>
+#include <string>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A wrapper for [::acb_t]() elements, i.e., complex numbers whose real and
+/// imaginary parts are [Arb]() balls, so we get C++ style memory management.
+/// Like for `Arb`, arithmetic operators build expressions with Yap that are
+/// evaluated once a precision is supplied:
+///
+///     #include <arbxx/yap/acb.hpp>
+///
+///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{2}}, y{3};
+///     std::cout << (x * y)(64);
+///     // -> 3.00000 + 6.00000*I
+///
+/// The real and imaginary parts can be read and modified in place without
+/// copying them:
+///
+///     x.imag() = 0;
+///     std::cout << x;
+///     // -> 1.00000
+///
+/// Note that methods here are usually named as their counterparts in acb.h
+/// with the leading acb_ removed.
+class LIBARBXX_API Acb {
+ public:
+  /// Create an exact zero element.
+  ///
+  ///     arbxx::Acb x;
+  ///     std::cout << x;
+  ///     // -> 0
+  ///
+  Acb() noexcept;
+
+  /// Create a copy of `x`.
+  ///
+  ///     arbxx::Acb x{1337};
+  ///     arbxx::Acb y{x};
+  ///     x.equal(y)
+  ///     // -> true
+  ///
+  Acb(const Acb&) noexcept;
+
+  /// Create a new element from `x`.
+  ///
+  ///     arbxx::Acb x{1337};
+  ///     arbxx::Acb y{std::move(x)};
+  ///     std::cout << y;
+  ///     // -> 1337.00
+  ///
+  Acb(Acb&&) noexcept;
+
+  /// Create a real element equal to `x`, see [acb_set_arb]().
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{mpq_class{1, 2}}};
+  ///     std::cout << x;
+  ///     // -> 0.500000
+  ///
+  explicit Acb(const Arb&);
+
+  /// Create the element `real + imag*I`, see [acb_set_arb_arb]().
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{-2}};
+  ///     std::cout << x;
+  ///     // -> 1.00000 - 2.00000*I
+  ///
+  Acb(const Arb& real, const Arb& imag);
+
+  /// Create an exact real element equal to `x`, see [arb_set_arf]().
+  ///
+  ///     arbxx::Acb x{arbxx::Arf{mpz_class{1}, -1}};
+  ///     std::cout << x;
+  ///     // -> 0.500000
+  ///
+  explicit Acb(const Arf&);
+
+  /// Create the exact element `real + imag*I`.
+  ///
+  ///     arbxx::Acb x{arbxx::Arf{1}, arbxx::Arf{-2}};
+  ///     std::cout << x;
+  ///     // -> 1.00000 - 2.00000*I
+  ///
+  Acb(const Arf& real, const Arf& imag);
+
+  /// Create an exact element equal to this integer.
+  ///
+  ///     arbxx::Acb x{mpz_class{1337}};
+  ///     std::cout << x;
+  ///     // -> 1337.00
+  ///
+  explicit Acb(const mpz_class&);
+
+  /// Create an element containing this rational, see [Arb::Arb(const
+  /// mpq_class&)]().
+  ///
+  ///     arbxx::Acb x{mpq_class{1, 2}};
+  ///     std::cout << x;
+  ///     // -> 0.500000
+  ///
+  explicit Acb(const mpq_class&);
+
+  /// Create an element containing this rational using [acb_set_fmpq](),
+  /// i.e., by performing the division of numerator and denominator with
+  /// precision `prec`.
+  ///
+  ///     arbxx::Acb x{mpq_class{1, 3}, 256};
+  ///     x.is_exact()
+  ///     // -> false
+  ///
+  Acb(const mpq_class&, const prec);
+
+  /// ==* `Acb(integer)` *==
+  /// Create an exact element, equal to this integer.
+  ///
+  ///     arbxx::Acb x{1};
+  ///     std::cout << x;
+  ///     // -> 1.00000
+  ///
+  explicit Acb(short);
+  explicit Acb(unsigned short);
+  explicit Acb(int);
+  explicit Acb(unsigned int);
+  explicit Acb(long);
+  explicit Acb(unsigned long);
+  explicit Acb(long long);
+  explicit Acb(unsigned long long);
+
+  /// Create an element from the strings of its real and imaginary part, see
+  /// [arb_set_str]().
+  ///
+  ///     arbxx::Acb x{"[3.25 +/- 0.0001]", "1", 64};
+  ///     std::cout << x;
+  ///     // -> [3.25000 +/- 1.01e-4] + 1.00000*I
+  ///
+  Acb(const std::string& real, const std::string& imag, const prec);
+
+  ~Acb() noexcept;
+
+  /// ==* `operator=(Acb)` *==
+  /// Reset this element to the one given.
+  ///
+  ///     arbxx::Acb x{1}, y;
+  ///     y = std::move(x);
+  ///     std::cout << y;
+  ///     // -> 1.00000
+  ///
+  ///     x = y;
+  ///     std::cout << y;
+  ///     // -> 1.00000
+  ///
+  Acb& operator=(const Acb&) noexcept;
+  Acb& operator=(Acb&&) noexcept;
+
+  /// ==* `operator=(real)` *==
+  /// Reset this element to a real element, exact unless an inexact `Arb` is
+  /// given.
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{1}};
+  ///     x = 2;
+  ///     std::cout << x;
+  ///     // -> 2.00000
+  ///
+  Acb& operator=(const Arb&);
+  Acb& operator=(short);
+  Acb& operator=(unsigned short);
+  Acb& operator=(int);
+  Acb& operator=(unsigned int);
+  Acb& operator=(long);
+  Acb& operator=(unsigned long);
+  Acb& operator=(long long);
+  Acb& operator=(unsigned long long);
+  Acb& operator=(const mpz_class&);
+
+  /// ==* In-place Arithmetic *==
+  /// Replace this element with the result of the operation performed with
+  /// the working precision of the current thread, see [PrecisionScope]().
+  /// Real operands are not promoted to an `Acb` first but passed to
+  /// [acb_add_arb](), [acb_mul_si]() and friends directly.
+  ///
+  ///     #include <arbxx/precision.hpp>
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{1}};
+  ///     arbxx::PrecisionScope scope{256};
+  ///     x *= x;
+  ///     x += 1;
+  ///     std::cout << x;
+  ///     // -> 1.00000 + 2.00000*I
+  ///
+  Acb& operator+=(const Acb&);
+  Acb& operator+=(const Arb&);
+  Acb& operator+=(short);
+  Acb& operator+=(unsigned short);
+  Acb& operator+=(int);
+  Acb& operator+=(unsigned int);
+  Acb& operator+=(long);
+  Acb& operator+=(unsigned long);
+  Acb& operator+=(long long);
+  Acb& operator+=(unsigned long long);
+  Acb& operator+=(const mpz_class&);
+  Acb& operator-=(const Acb&);
+  Acb& operator-=(const Arb&);
+  Acb& operator-=(short);
+  Acb& operator-=(unsigned short);
+  Acb& operator-=(int);
+  Acb& operator-=(unsigned int);
+  Acb& operator-=(long);
+  Acb& operator-=(unsigned long);
+  Acb& operator-=(long long);
+  Acb& operator-=(unsigned long long);
+  Acb& operator-=(const mpz_class&);
+  Acb& operator*=(const Acb&);
+  Acb& operator*=(const Arb&);
+  Acb& operator*=(short);
+  Acb& operator*=(unsigned short);
+  Acb& operator*=(int);
+  Acb& operator*=(unsigned int);
+  Acb& operator*=(long);
+  Acb& operator*=(unsigned long);
+  Acb& operator*=(long long);
+  Acb& operator*=(unsigned long long);
+  Acb& operator*=(const mpz_class&);
+  Acb& operator/=(const Acb&);
+  Acb& operator/=(const Arb&);
+  Acb& operator/=(short);
+  Acb& operator/=(unsigned short);
+  Acb& operator/=(int);
+  Acb& operator/=(unsigned int);
+  Acb& operator/=(long);
+  Acb& operator/=(unsigned long);
+  Acb& operator/=(long long);
+  Acb& operator/=(unsigned long long);
+  Acb& operator/=(const mpz_class&);
+
+  /// Return the negative of this element.
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{1}};
+  ///     std::cout << -x;
+  ///     // -> -1.00000 - 1.00000*I
+  ///
+  Acb operator-() const;
+
+  /// ==* Comparison Operators *==
+  /// The comparison operators return a value if the relation is true for all
+  /// elements in the complex balls, they return false if the relation is
+  /// false for all elements, and nothing otherwise, see [acb_eq]() and
+  /// [acb_ne](). Since complex numbers are not ordered, only equality is
+  /// provided.
+  /// Comparisons with real elements, integers and rationals are performed
+  /// exactly on the real part, see the corresponding operators of [Arb]().
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{mpq_class{1, 3}}, arbxx::Arb{1}};
+  ///     *(x != 0)
+  ///     // -> true
+  ///
+  ///     (x == x).has_value()
+  ///     // -> false
+  ///
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, const Arb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, const Arb&);
+  LIBARBXX_API friend std::optional<bool> operator==(const Arb&, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Arb&, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, short);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, short);
+  LIBARBXX_API friend std::optional<bool> operator==(short, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(short, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, unsigned short);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, unsigned short);
+  LIBARBXX_API friend std::optional<bool> operator==(unsigned short, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(unsigned short, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, int);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, int);
+  LIBARBXX_API friend std::optional<bool> operator==(int, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(int, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, unsigned int);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, unsigned int);
+  LIBARBXX_API friend std::optional<bool> operator==(unsigned int, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(unsigned int, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, long);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, long);
+  LIBARBXX_API friend std::optional<bool> operator==(long, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(long, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, unsigned long);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, unsigned long);
+  LIBARBXX_API friend std::optional<bool> operator==(unsigned long, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(unsigned long, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, long long);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, long long);
+  LIBARBXX_API friend std::optional<bool> operator==(long long, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(long long, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, unsigned long long);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, unsigned long long);
+  LIBARBXX_API friend std::optional<bool> operator==(unsigned long long, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(unsigned long long, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, const mpz_class&);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, const mpz_class&);
+  LIBARBXX_API friend std::optional<bool> operator==(const mpz_class&, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(const mpz_class&, const Acb&);
+
+  LIBARBXX_API friend std::optional<bool> operator==(const Acb&, const mpq_class&);
+  LIBARBXX_API friend std::optional<bool> operator!=(const Acb&, const mpq_class&);
+  LIBARBXX_API friend std::optional<bool> operator==(const mpq_class&, const Acb&);
+  LIBARBXX_API friend std::optional<bool> operator!=(const mpq_class&, const Acb&);
+
+  /// ==* `real()`, `imag()` *==
+  /// Return the real and the imaginary part of this element, see
+  /// [acb_realref]() and [acb_imagref](). No copy is made; the returned
+  /// references point into this element and remain valid as long as it
+  /// lives.
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{2}};
+  ///     x.real() += 1;
+  ///     std::cout << x.real() << ", " << x.imag();
+  ///     // -> 2.00000, 2.00000
+  ///
+  Arb& real() noexcept;
+  const Arb& real() const noexcept;
+  Arb& imag() noexcept;
+  const Arb& imag() const noexcept;
+
+  /// Return whether the real and the imaginary part of this element are
+  /// exact, see [acb_is_exact]().
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{2}};
+  ///     x.is_exact()
+  ///     // -> true
+  ///
+  ///     arbxx::Acb y{mpq_class{1, 3}};
+  ///     y.is_exact()
+  ///     // -> false
+  ///
+  bool is_exact() const;
+
+  /// Return whether neither the real nor the imaginary part of this element
+  /// contain plus or minus infinity, see [acb_is_finite]().
+  ///
+  ///     arbxx::Acb x{1};
+  ///     x.is_finite()
+  ///     // -> true
+  ///
+  bool is_finite() const;
+
+  /// Return whether the imaginary part of this element is exactly zero, see
+  /// [acb_is_real]().
+  ///
+  ///     arbxx::Acb::one().is_real()
+  ///     // -> true
+  ///
+  ///     arbxx::Acb::i().is_real()
+  ///     // -> false
+  ///
+  bool is_real() const;
+
+  /// Return the midpoints of the real and the imaginary part rounded to the
+  /// closest double, see [Arb::operator double]().
+  ///
+  ///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{mpq_class{1, 2}}};
+  ///     static_cast<std::complex<double>>(x)
+  ///     // -> (1,0.5)
+  ///
+  explicit operator std::complex<double>() const;
+
+  /// Write this element to the output stream as `real + imag*I`, in the
+  /// same format as [acb_printn](). The parts are written like an [Arb]().
+  LIBARBXX_API friend std::ostream& operator<<(std::ostream&, const Acb&);
+
+  /// Return a reference to the underlying [acb_t]() element for direct
+  /// manipulation with the C API of Arb.
+  ::acb_t& acb_t();
+
+  /// Return a const reference to the underlying [acb_t]() element for direct
+  /// manipulation with the C API of Arb.
+  const ::acb_t& acb_t() const;
+
+  /// Return an exact zero element.
+  ///
+  ///     std::cout << arbxx::Acb::zero();
+  ///     // -> 0
+  ///
+  static Acb zero();
+
+  /// Return an exact one element.
+  ///
+  ///     std::cout << arbxx::Acb::one();
+  ///     // -> 1.00000
+  ///
+  static Acb one();
+
+  /// Return the imaginary unit, see [acb_onei]().
+  ///
+  ///     std::cout << arbxx::Acb::i();
+  ///     // -> 1.00000*I
+  ///
+  static Acb i();
+
+  /// Return an indeterminate, i.e., an element whose real and imaginary part
+  /// are [NaN±∞], see [acb_indeterminate]().
+  ///
+  ///     std::cout << arbxx::Acb::indeterminate();
+  ///     // -> nan + nan*I
+  ///
+  static Acb indeterminate();
+
+  /// Return a random element, see [acb_randtest]().
+  ///
+  ///     #include <flint/flintxx/frandxx.h>
+  ///
+  ///     flint::frandxx rand;
+  ///     auto a = arbxx::Acb::randtest(rand, 64, 16);
+  ///     auto b = arbxx::Acb::randtest(rand, 64, 16);
+  ///     a.equal(b)
+  ///     // -> false
+  ///
+  static Acb randtest(flint::frandxx&, prec precision, prec magbits);
+
+  /// Return a random element whose real and imaginary part are exact, see
+  /// [arb_randtest_exact]().
+  ///
+  ///     #include <flint/flintxx/frandxx.h>
+  ///
+  ///     flint::frandxx rand;
+  ///     arbxx::Acb::randtest_exact(rand, 64, 16).is_exact()
+  ///     // -> true
+  ///
+  static Acb randtest_exact(flint::frandxx&, prec precision, prec magbits);
+
+  /// Return whether elements have the same midpoints and radii, see
+  /// [acb_equal]().
+  ///
+  ///     arbxx::Acb a;
+  ///     a.equal(a)
+  ///     // -> true
+  ///
+  bool equal(const Acb&) const;
+
+  /// Swap two elements efficiently, see [acb_swap]().
+  ///
+  ///     arbxx::Acb a{1}, b;
+  ///     swap(a, b);
+  ///     std::cout << "a = " << a << ", b = " << b;
+  ///     // -> a = 0, b = 1.00000
+  ///
+  LIBARBXX_API friend void swap(Acb&, Acb&);
+
+  // Syntactic sugar for Yap, so that x(64) rounds x to 64 bits just like
+  // (x + y)(64) evaluates an expression at 64 bits. Defined in yap/acb.hpp.
+  template <typename... Args>
+  LIBARBXX_LOCAL decltype(auto) operator()(Args&&...) const;
+
+ private:
+  // The underlying acb_t; use acb_t() to get a reference to it.
+  ::acb_t t;
+};
+
+}  // namespace arbxx
+
+namespace std {
+
+/// Hashes an [Acb]() consistently with [Acb::equal](), i.e., elements with
+/// the same midpoints and radii have the same hash.
+///
+///     arbxx::Acb x{mpq_class{1, 3}, 256};
+///     std::hash<arbxx::Acb>()(x) == std::hash<arbxx::Acb>()(arbxx::Acb{mpq_class{1, 3}, 256})
+///     // -> true
+///
+template <>
+struct LIBARBXX_API hash<arbxx::Acb> {
+  size_t LIBARBXX_API operator()(const arbxx::Acb&) const;
+};
+
+}  // namespace std
+
+#endif
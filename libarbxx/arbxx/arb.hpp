@@ -41,7 +41,6 @@ namespace arbxx {
 // changing the performance of certain calls slightly.
 inline constexpr const prec ARB_PRECISION_FAST = 64;
 
-/// TODO
 /// A wrapper for [::arb_t]() elements, i.e., floating point numbers surrounded
 /// by a real ball of imprecision, so we get C++ style memory management. We
 /// use some Yap magic to get nice operators (which is tricky otherwise because
@@ -55,17 +54,17 @@ inline constexpr const prec ARB_PRECISION_FAST = 64;
 ///
 ///     arb_add(x.arb_t(), x.arb_t(), y.arb_t(), 64);
 ///
-/// Using yap this can be rewritten as any of the following:
+/// Using yap this can be rewritten as:
 ///
 ///     #include <arbxx/yap/arb.hpp>
 ///
 ///     arbxx::Arb x, y;
 ///
-///     x += y(64);
 ///     x = (x + y)(64);
 ///
-/// Note that the latter might use an additional temporary Arb. See the
-/// yap/arb.hpp header for more details.
+/// The expression is evaluated in a single pass and maps to fused kernels such
+/// as [arb_addmul]() where possible. See the yap/arb.hpp header for more
+/// details.
 ///
 /// Note that methods here are usually named as their counterparts in arb.h with
 /// the leading arb_ removed.
@@ -224,6 +223,60 @@ class LIBARBXX_API Arb {
   Arb& operator=(unsigned long long);
   Arb& operator=(const mpz_class&);
 
+  /// ==* In-place Arithmetic *==
+  /// Replace this element with the result of the operation performed with
+  /// the working precision of the current thread, see [PrecisionScope]().
+  ///
+  ///     #include <arbxx/precision.hpp>
+  ///
+  ///     arbxx::Arb x{1};
+  ///     arbxx::PrecisionScope scope{256};
+  ///     x += 1;
+  ///     x *= x;
+  ///     std::cout << x;
+  ///     // -> 4.00000
+  ///
+  Arb& operator+=(const Arb&);
+  Arb& operator+=(short);
+  Arb& operator+=(unsigned short);
+  Arb& operator+=(int);
+  Arb& operator+=(unsigned int);
+  Arb& operator+=(long);
+  Arb& operator+=(unsigned long);
+  Arb& operator+=(long long);
+  Arb& operator+=(unsigned long long);
+  Arb& operator+=(const mpz_class&);
+  Arb& operator-=(const Arb&);
+  Arb& operator-=(short);
+  Arb& operator-=(unsigned short);
+  Arb& operator-=(int);
+  Arb& operator-=(unsigned int);
+  Arb& operator-=(long);
+  Arb& operator-=(unsigned long);
+  Arb& operator-=(long long);
+  Arb& operator-=(unsigned long long);
+  Arb& operator-=(const mpz_class&);
+  Arb& operator*=(const Arb&);
+  Arb& operator*=(short);
+  Arb& operator*=(unsigned short);
+  Arb& operator*=(int);
+  Arb& operator*=(unsigned int);
+  Arb& operator*=(long);
+  Arb& operator*=(unsigned long);
+  Arb& operator*=(long long);
+  Arb& operator*=(unsigned long long);
+  Arb& operator*=(const mpz_class&);
+  Arb& operator/=(const Arb&);
+  Arb& operator/=(short);
+  Arb& operator/=(unsigned short);
+  Arb& operator/=(int);
+  Arb& operator/=(unsigned int);
+  Arb& operator/=(long);
+  Arb& operator/=(unsigned long);
+  Arb& operator/=(long long);
+  Arb& operator/=(unsigned long long);
+  Arb& operator/=(const mpz_class&);
+
   /// Return the negative of this element.
   /// This method returns a ball whose lower and upper bound is the negative of
   /// the upper and lower bound, respectively.
@@ -241,6 +294,8 @@ class LIBARBXX_API Arb {
   /// the relation is false for every element in x and y, and nothing otherwise.
   /// Note that this is different from the semantic in Arb where false is
   /// returned in both of the latter cases.
+  /// Comparisons with integers and rationals are performed exactly, i.e.,
+  /// the other operand is not rounded to a ball first.
   ///
   ///     arbxx::Arb x{mpq_class{1, 3}};
   ///     (x < 1).has_value()
@@ -527,6 +582,27 @@ class LIBARBXX_API Arb {
   ///
   static Arb unit_interval();
 
+  /// ==* Constants *==
+  /// Return the constants π, log(2), e, and Euler's constant γ at precision
+  /// `prec`, see [arb_const_pi](), [arb_const_log2](), [arb_const_e](), and
+  /// [arb_const_euler]().
+  ///
+  /// The constants are cached at least at the highest precision that has
+  /// been requested so far; lower precisions are served by rounding the
+  /// cached value. When more precision is requested, the cached precision is
+  /// at least doubled, so rising requests only recompute a constant a
+  /// logarithmic number of times. The cache can be read concurrently from
+  /// many threads without locking.
+  ///
+  ///     auto pi = arbxx::Arb::pi(64);
+  ///     *(pi > 3) && *(pi < mpq_class{22, 7})
+  ///     // -> true
+  ///
+  static Arb pi(prec);
+  static Arb log2(prec);
+  static Arb e(prec);
+  static Arb euler(prec);
+
   /// Return a random element, see [arb_randtest]().
   ///
   ///     #include <flint/flintxx/frandxx.h>
@@ -572,7 +648,8 @@ class LIBARBXX_API Arb {
   ///
   LIBARBXX_API friend void swap(Arb&, Arb&);
 
-  // Syntactic sugar for Yap, so that expresions such as x += y(64, Arf::Rount::NEAR) work.
+  // Syntactic sugar for Yap, so that x(64) rounds x to 64 bits just like
+  // (x + y)(64) evaluates an expression at 64 bits. Defined in yap/arb.hpp.
   template <typename... Args>
   LIBARBXX_LOCAL decltype(auto) operator()(Args&&...) const;
 
@@ -584,4 +661,20 @@ class LIBARBXX_API Arb {
 
 }  // namespace arbxx
 
+namespace std {
+
+/// Hashes an [Arb]() consistently with [Arb::equal](), i.e., elements with
+/// the same midpoint and radius have the same hash.
+///
+///     arbxx::Arb x{mpq_class{1, 3}, 256};
+///     std::hash<arbxx::Arb>()(x) == std::hash<arbxx::Arb>()(arbxx::Arb{mpq_class{1, 3}, 256})
+///     // -> true
+///
+template <>
+struct LIBARBXX_API hash<arbxx::Arb> {
+  size_t LIBARBXX_API operator()(const arbxx::Arb&) const;
+};
+
+}  // namespace std
+
 #endif
@@ -0,0 +1,220 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Data-parallel arithmetic on many balls of low precision.
+
+#ifndef LIBARBXX_ARB_BATCH_HPP
+#define LIBARBXX_ARB_BATCH_HPP
+
+#include <iosfwd>
+#include <optional>
+#include <vector>
+
+#include "arb.hpp"
+#include "forward.hpp"
+
+namespace arbxx {
+
+/// A fixed size batch of balls whose midpoints and radii are doubles, stored
+/// as two separate arrays.
+///
+/// The elementwise operations of a batch do not call into Arb at all.
+/// Instead, they run vectorized kernels that use AVX-512 or AVX2 if the CPU
+/// supports it, and a portable scalar implementation otherwise. Like the
+/// results of [arb_add]() and [arb_mul]() at 53 bits of precision, the
+/// results are rigorous enclosures, though possibly with slightly larger
+/// radii.
+///
+///     #include <arbxx/arb_batch.hpp>
+///
+///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+///     x.add(x);
+///     std::cout << x;
+///     // -> [2.00000, 4.00000]
+///
+/// Results that are exact remain exact; otherwise the radii account for the
+/// rounding errors of the midpoints and the radii:
+///
+///     x.mul(arbxx::ArbBatch{std::vector{arbxx::Arb{mpq_class{1, 3}, 64}, arbxx::Arb{1}}});
+///     x[0].is_exact()
+///     // -> false
+///
+///     x[1].is_exact()
+///     // -> true
+///
+/// Elements that are not exactly representable in this format, e.g.,
+/// because they have more than 53 bits of precision, are enclosed when they
+/// are put into a batch:
+///
+///     arbxx::Arb third{mpq_class{1, 3}, 256};
+///     arbxx::ArbBatch y{std::vector{third}};
+///     arb_contains(y[0].arb_t(), third.arb_t())
+///     // -> 1
+///
+/// These kernels assume that the floating point environment is in its
+/// default state, i.e., rounding to nearest.
+class LIBARBXX_API ArbBatch {
+ public:
+  /// Create an empty batch.
+  ///
+  ///     arbxx::ArbBatch x;
+  ///     x.size()
+  ///     // -> 0
+  ///
+  ArbBatch() noexcept;
+
+  /// Create a batch of `length` exact zeros.
+  ///
+  ///     arbxx::ArbBatch x{3};
+  ///     std::cout << x;
+  ///     // -> [0, 0, 0]
+  ///
+  explicit ArbBatch(::arbxx::size length);
+
+  /// ==* `ArbBatch(std::vector<Arb>)` *==
+  /// Create a batch of elements enclosing these elements.
+  ///
+  ///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     std::cout << x;
+  ///     // -> [1.00000, 2.00000]
+  ///
+  ///     arbxx::ArbBatch y{arbxx::ArbVector{std::vector<long>{1, 2}}};
+  ///     std::cout << y;
+  ///     // -> [1.00000, 2.00000]
+  ///
+  explicit ArbBatch(const std::vector<Arb>&);
+  explicit ArbBatch(const ArbVector&);
+
+  /// Return the number of elements in this batch.
+  ///
+  ///     arbxx::ArbBatch x{3};
+  ///     x.size()
+  ///     // -> 3
+  ///
+  ::arbxx::size size() const noexcept;
+
+  /// Return whether this batch has no elements.
+  ///
+  ///     arbxx::ArbBatch x;
+  ///     x.empty()
+  ///     // -> true
+  ///
+  bool empty() const noexcept;
+
+  /// Return the element at position `i` as an exact copy. No bounds checking
+  /// is performed.
+  ///
+  ///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     std::cout << x[1];
+  ///     // -> 2.00000
+  ///
+  Arb operator[](::arbxx::size i) const;
+
+  /// ==* `midpoints()`, `radii()` *==
+  /// Return the underlying arrays of midpoints and radii.
+  ///
+  ///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     x.midpoints()[1]
+  ///     // -> 2
+  ///
+  ///     x.radii()[1]
+  ///     // -> 0
+  ///
+  const double* midpoints() const noexcept;
+  const double* radii() const noexcept;
+
+  /// Replace this batch with the elementwise sum with `rhs`. The batches
+  /// must have the same length.
+  ///
+  ///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     x.add(x);
+  ///     x.midpoints()[1]
+  ///     // -> 4
+  ///
+  ArbBatch& add(const ArbBatch& rhs);
+
+  /// Replace this batch with the elementwise product with `rhs`. The batches
+  /// must have the same length.
+  ///
+  ///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     x.mul(x);
+  ///     x.midpoints()[1]
+  ///     // -> 4
+  ///
+  ArbBatch& mul(const ArbBatch& rhs);
+
+  /// Return for each element whether it is less than the corresponding
+  /// element of `rhs`. Like for [Arb]() relations, an entry is empty if this
+  /// cannot be decided. The batches must have the same length.
+  ///
+  ///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     arbxx::ArbBatch y{std::vector{arbxx::Arb{2}, arbxx::Arb{1}}};
+  ///     *x.lt(y)[0]
+  ///     // -> true
+  ///
+  ///     *x.lt(y)[1]
+  ///     // -> false
+  ///
+  std::vector<std::optional<bool>> lt(const ArbBatch& rhs) const;
+
+  /// Return the elements of this batch as exact copies.
+  ///
+  ///     arbxx::ArbBatch x{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     static_cast<std::vector<arbxx::Arb>>(x).size()
+  ///     // -> 2
+  ///
+  explicit operator std::vector<Arb>() const;
+
+  /// Return the name of the kernels that were selected for this CPU, i.e.,
+  /// one of `"avx512"`, `"avx2"`, and `"scalar"`.
+  ///
+  /// By default, the fastest kernels that the CPU supports are used. Other
+  /// kernels can be requested by setting the environment variable
+  /// `LIBARBXX_ARB_BATCH_KERNELS` to their name. Requests for kernels that
+  /// the CPU does not support are ignored.
+  static const char* kernels() noexcept;
+
+  /// Write this batch to the output stream.
+  LIBARBXX_API friend std::ostream& operator<<(std::ostream&, const ArbBatch&);
+
+  /// Swap two batches without copying any elements.
+  LIBARBXX_API friend void swap(ArbBatch&, ArbBatch&) noexcept;
+
+ private:
+  // The midpoints of the elements. All midpoints are finite.
+  std::vector<double> mid;
+
+  // The radii of the elements. All radii are non-negative and possibly
+  // infinite.
+  std::vector<double> rad;
+};
+
+namespace detail {
+
+// Use the kernels called `name` for all batches from now on. Returns false
+// and leaves the kernels unchanged if the CPU does not support them.
+// Operations that are already running may still use the previous kernels.
+// This is meant for testing all the kernels that the CPU supports.
+LIBARBXX_API bool use_arb_batch_kernels(const char* name);
+
+}  // namespace detail
+
+}  // namespace arbxx
+
+#endif
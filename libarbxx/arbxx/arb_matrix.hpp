@@ -0,0 +1,234 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// C++ Wrappers for a dense matrix of balls [arb_mat_t]().
+
+#ifndef LIBARBXX_ARB_MATRIX_HPP
+#define LIBARBXX_ARB_MATRIX_HPP
+
+#include <arb_mat.h>
+#include <flint/flintxx/frandxx.h>
+
+#include <iosfwd>
+#include <optional>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A wrapper for [arb_mat_t]() elements, i.e., dense matrices of [Arb]()
+/// elements, so we get C++ style memory management.
+///
+///     #include <arbxx/arb_matrix.hpp>
+///
+///     auto A = arbxx::ArbMatrix::one(2);
+///     A(0, 1) = 1;
+///     std::cout << A;
+///     // -> [[1.00000, 1.00000], [0, 1.00000]]
+///
+///     std::cout << A.mul(A, 64);
+///     // -> [[1.00000, 2.00000], [0, 1.00000]]
+///
+/// Products of large matrices can use several threads. The number of threads
+/// is controlled by a [ThreadScope]():
+///
+///     #include <arbxx/threads.hpp>
+///
+///     arbxx::ThreadScope threads{4};
+///     auto B = A.mul(A, 256);
+///
+/// Note that methods here are usually named as their counterparts in
+/// arb_mat.h with the leading arb_mat_ removed.
+class LIBARBXX_API ArbMatrix {
+ public:
+  /// The algorithms that can be used to multiply matrices.
+  enum class Algorithm {
+    /// Let Arb pick an algorithm depending on the size of the matrices, the
+    /// precision, and the number of threads of the current [ThreadScope](),
+    /// see [arb_mat_mul]().
+    AUTOMATIC,
+    /// See [arb_mat_mul_classical]().
+    CLASSICAL,
+    /// Distribute the classical multiplication over the threads of the
+    /// current [ThreadScope](), see [arb_mat_mul_threaded]().
+    THREADED,
+    /// Multiply blocks of entries with similar exponents exactly as integer
+    /// matrices, see [arb_mat_mul_block]().
+    BLOCK,
+  };
+
+  /// Create a 0×0 matrix.
+  ///
+  ///     arbxx::ArbMatrix A;
+  ///     A.nrows()
+  ///     // -> 0
+  ///
+  ArbMatrix() noexcept;
+
+  /// Create a `rows`×`cols` matrix of exact zeros.
+  ///
+  ///     arbxx::ArbMatrix A{2, 3};
+  ///     std::cout << A;
+  ///     // -> [[0, 0, 0], [0, 0, 0]]
+  ///
+  ArbMatrix(::arbxx::size rows, ::arbxx::size cols);
+
+  /// Create a copy of `A`.
+  ///
+  ///     auto A = arbxx::ArbMatrix::one(2);
+  ///     arbxx::ArbMatrix B{A};
+  ///     A.equal(B)
+  ///     // -> true
+  ///
+  ArbMatrix(const ArbMatrix&);
+
+  /// Create a matrix from `A` and leave `A` as a 0×0 matrix.
+  ///
+  ///     auto A = arbxx::ArbMatrix::one(2);
+  ///     arbxx::ArbMatrix B{std::move(A)};
+  ///     std::cout << B;
+  ///     // -> [[1.00000, 0], [0, 1.00000]]
+  ///
+  ArbMatrix(ArbMatrix&&) noexcept;
+
+  ~ArbMatrix() noexcept;
+
+  /// ==* `operator=(ArbMatrix)` *==
+  /// Reset this matrix to the one given.
+  ///
+  ///     arbxx::ArbMatrix A;
+  ///     A = arbxx::ArbMatrix::one(2);
+  ///     std::cout << A;
+  ///     // -> [[1.00000, 0], [0, 1.00000]]
+  ///
+  ArbMatrix& operator=(const ArbMatrix&);
+  ArbMatrix& operator=(ArbMatrix&&) noexcept;
+
+  /// Return the `n`×`n` identity matrix, see [arb_mat_one]().
+  ///
+  ///     std::cout << arbxx::ArbMatrix::one(2);
+  ///     // -> [[1.00000, 0], [0, 1.00000]]
+  ///
+  static ArbMatrix one(::arbxx::size n);
+
+  /// Return a random `rows`×`cols` matrix, see [arb_mat_randtest]().
+  static ArbMatrix randtest(flint::frandxx&, ::arbxx::size rows, ::arbxx::size cols, prec precision, prec magbits);
+
+  /// Return the number of rows of this matrix.
+  ///
+  ///     arbxx::ArbMatrix A{2, 3};
+  ///     A.nrows()
+  ///     // -> 2
+  ///
+  ::arbxx::size nrows() const noexcept;
+
+  /// Return the number of columns of this matrix.
+  ///
+  ///     arbxx::ArbMatrix A{2, 3};
+  ///     A.ncols()
+  ///     // -> 3
+  ///
+  ::arbxx::size ncols() const noexcept;
+
+  /// ==* `operator()(i, j)` *==
+  /// Return a reference to the entry in row `i` and column `j`. The
+  /// reference points into the storage of this matrix, so no copy of the
+  /// entry is made. No bounds checking is performed.
+  ///
+  ///     arbxx::ArbMatrix A{2, 2};
+  ///     A(1, 0) = 3;
+  ///     std::cout << A(1, 0);
+  ///     // -> 3.00000
+  ///
+  Arb& operator()(::arbxx::size i, ::arbxx::size j) noexcept;
+  const Arb& operator()(::arbxx::size i, ::arbxx::size j) const noexcept;
+
+  /// Return the product of this matrix with `rhs`.
+  ///
+  ///     auto A = arbxx::ArbMatrix::one(2);
+  ///     A(0, 1) = 1;
+  ///     std::cout << A.mul(A, 64, arbxx::ArbMatrix::Algorithm::BLOCK);
+  ///     // -> [[1.00000, 2.00000], [0, 1.00000]]
+  ///
+  ArbMatrix mul(const ArbMatrix& rhs, prec, Algorithm = Algorithm::AUTOMATIC) const;
+
+  /// Return a matrix `X` such that this matrix times `X` contains `rhs`, see
+  /// [arb_mat_solve](). Returns nothing if this matrix could not be shown to
+  /// be invertible at this precision.
+  ///
+  ///     auto A = arbxx::ArbMatrix::one(2);
+  ///     A(0, 1) = 1;
+  ///     std::cout << *A.solve(arbxx::ArbMatrix::one(2), 64);
+  ///     // -> [[1.00000, -1.00000], [0, 1.00000]]
+  ///
+  ///     arbxx::ArbMatrix{2, 2}.solve(arbxx::ArbMatrix::one(2), 64).has_value()
+  ///     // -> false
+  ///
+  std::optional<ArbMatrix> solve(const ArbMatrix& rhs, prec) const;
+
+  /// Return the inverse of this matrix, see [arb_mat_inv](). Returns nothing
+  /// if this matrix could not be shown to be invertible at this precision.
+  ///
+  ///     auto A = arbxx::ArbMatrix::one(2);
+  ///     A(0, 1) = 1;
+  ///     std::cout << *A.inv(64);
+  ///     // -> [[1.00000, -1.00000], [0, 1.00000]]
+  ///
+  std::optional<ArbMatrix> inv(prec) const;
+
+  /// Return the determinant of this square matrix, see [arb_mat_det]().
+  ///
+  ///     auto A = arbxx::ArbMatrix::one(2);
+  ///     A(0, 1) = 1;
+  ///     std::cout << A.det(64);
+  ///     // -> 1.00000
+  ///
+  Arb det(prec) const;
+
+  /// Return whether the matrices have the same shape and all entries have the
+  /// same midpoint and radius, see [arb_mat_equal]().
+  ///
+  ///     auto A = arbxx::ArbMatrix::one(2);
+  ///     A.equal(A)
+  ///     // -> true
+  ///
+  bool equal(const ArbMatrix&) const;
+
+  /// Return a reference to the underlying [arb_mat_t]() element for direct
+  /// manipulation with the C API of Arb.
+  ::arb_mat_t& arb_mat_t() noexcept;
+
+  /// Return a const reference to the underlying [arb_mat_t]() element for
+  /// direct manipulation with the C API of Arb.
+  const ::arb_mat_t& arb_mat_t() const noexcept;
+
+  /// Write this matrix to the output stream.
+  LIBARBXX_API friend std::ostream& operator<<(std::ostream&, const ArbMatrix&);
+
+  /// Swap two matrices without copying any entries, see [arb_mat_swap]().
+  LIBARBXX_API friend void swap(ArbMatrix&, ArbMatrix&) noexcept;
+
+ private:
+  /// The underlying arb_mat_t; use arb_mat_t() to get a reference to it.
+  ::arb_mat_t t;
+};
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,202 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// C++ Wrappers for a univariate polynomial with ball coefficients
+/// [arb_poly_t]().
+
+#ifndef LIBARBXX_ARB_POLY_HPP
+#define LIBARBXX_ARB_POLY_HPP
+
+#include <arb_poly.h>
+#include <flint/flintxx/frandxx.h>
+
+#include <iosfwd>
+#include <vector>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A wrapper for [arb_poly_t]() elements, i.e., polynomials with [Arb]()
+/// coefficients, so we get C++ style memory management.
+///
+///     #include <arbxx/arb_poly.hpp>
+///
+///     arbxx::ArbPoly f{{arbxx::Arb{1}, arbxx::Arb{2}, arbxx::Arb{3}}};
+///     std::cout << f;
+///     // -> [1.00000, 2.00000, 3.00000]
+///
+///     std::cout << f.evaluate(arbxx::Arb{2}, 64);
+///     // -> 17.0000
+///
+/// Evaluation at many points at once picks an algorithm depending on the
+/// degree and the number of points:
+///
+///     auto y = f.evaluate(std::vector<arbxx::Arb>{arbxx::Arb{0}, arbxx::Arb{1}}, 64);
+///     std::cout << y[1];
+///     // -> 6.00000
+///
+/// Note that methods here are usually named as their counterparts in
+/// arb_poly.h with the leading arb_poly_ removed.
+class LIBARBXX_API ArbPoly {
+ public:
+  /// The algorithms that can be used to evaluate a polynomial at many
+  /// points.
+  enum class Algorithm {
+    /// Use fast multipoint evaluation if the degree and the number of points
+    /// are both large and Horner's method otherwise.
+    AUTOMATIC,
+    /// Horner's method for each point. The points are processed in blocks so
+    /// that each coefficient is read once per block, and the blocks are
+    /// distributed over the threads of the current [ThreadScope]().
+    HORNER,
+    /// Fast multipoint evaluation with a subproduct tree, see
+    /// [arb_poly_evaluate_vec_fast](). This needs fewer operations for large
+    /// degrees and many points but often produces wider balls than Horner's
+    /// method.
+    FAST,
+  };
+
+  /// Create the zero polynomial.
+  ///
+  ///     arbxx::ArbPoly f;
+  ///     f.length()
+  ///     // -> 0
+  ///
+  ArbPoly() noexcept;
+
+  /// Create the polynomial with these coefficients, the constant coefficient
+  /// first.
+  ///
+  ///     arbxx::ArbPoly f{{arbxx::Arb{1}, arbxx::Arb{0}}};
+  ///     f.degree()
+  ///     // -> 0
+  ///
+  explicit ArbPoly(const std::vector<Arb>& coefficients);
+
+  /// Create a copy of `f`.
+  ArbPoly(const ArbPoly&);
+
+  /// Create a polynomial from `f` and leave `f` as the zero polynomial.
+  ArbPoly(ArbPoly&&) noexcept;
+
+  ~ArbPoly() noexcept;
+
+  /// ==* `operator=(ArbPoly)` *==
+  /// Reset this polynomial to the one given.
+  ArbPoly& operator=(const ArbPoly&);
+  ArbPoly& operator=(ArbPoly&&) noexcept;
+
+  /// Return a random polynomial with at most `length` coefficients, see
+  /// [arb_poly_randtest]().
+  static ArbPoly randtest(flint::frandxx&, ::arbxx::size length, prec precision, prec magbits);
+
+  /// Return the number of coefficients of this polynomial, i.e., one more
+  /// than its degree.
+  ::arbxx::size length() const noexcept;
+
+  /// Return the degree of this polynomial; the degree of the zero polynomial
+  /// is -1.
+  ///
+  ///     arbxx::ArbPoly f{{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     f.degree()
+  ///     // -> 1
+  ///
+  ::arbxx::size degree() const noexcept;
+
+  /// Return the coefficient of `x^n`, see [arb_poly_get_coeff_arb]().
+  ///
+  ///     arbxx::ArbPoly f{{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     std::cout << f.get_coeff(1) << ", " << f.get_coeff(7);
+  ///     // -> 2.00000, 0
+  ///
+  Arb get_coeff(::arbxx::size n) const;
+
+  /// Set the coefficient of `x^n` to `c`, see [arb_poly_set_coeff_arb]().
+  ///
+  ///     arbxx::ArbPoly f;
+  ///     f.set_coeff(2, arbxx::Arb{1});
+  ///     std::cout << f;
+  ///     // -> [0, 0, 1.00000]
+  ///
+  void set_coeff(::arbxx::size n, const Arb& c);
+
+  /// ==* Arithmetic *==
+  /// Return the sum, difference, or product of this polynomial with `rhs`,
+  /// see [arb_poly_add](), [arb_poly_sub](), and [arb_poly_mul]().
+  ///
+  ///     arbxx::ArbPoly f{{arbxx::Arb{1}, arbxx::Arb{1}}};
+  ///     std::cout << f.mul(f, 64).sub(f, 64);
+  ///     // -> [0, 1.00000, 1.00000]
+  ///
+  ArbPoly add(const ArbPoly& rhs, prec) const;
+  ArbPoly sub(const ArbPoly& rhs, prec) const;
+  ArbPoly mul(const ArbPoly& rhs, prec) const;
+
+  /// Return the negative of this polynomial.
+  ArbPoly neg() const;
+
+  /// ==* `evaluate()` *==
+  /// Return the value of this polynomial at `x`, see [arb_poly_evaluate]().
+  Arb evaluate(const Arb& x, prec) const;
+
+  /// Return the values of this polynomial at the `length` points starting at
+  /// `x`.
+  ///
+  ///     arbxx::ArbPoly f{{arbxx::Arb{0}, arbxx::Arb{1}}};
+  ///     std::vector<arbxx::Arb> x{arbxx::Arb{1}, arbxx::Arb{2}, arbxx::Arb{3}};
+  ///     auto y = f.evaluate(x, 64, arbxx::ArbPoly::Algorithm::FAST);
+  ///     std::cout << y[2];
+  ///     // -> 3.00000
+  ///
+  std::vector<Arb> evaluate(const Arb* x, ::arbxx::size length, prec, Algorithm = Algorithm::AUTOMATIC) const;
+  std::vector<Arb> evaluate(const std::vector<Arb>& x, prec, Algorithm = Algorithm::AUTOMATIC) const;
+
+  /// Write the values of this polynomial at the `length` points starting at
+  /// `x` to the elements starting at `y`. The ranges must not overlap.
+  void evaluate(Arb* y, const Arb* x, ::arbxx::size length, prec, Algorithm = Algorithm::AUTOMATIC) const;
+
+  /// Return whether the polynomials have the same coefficients, see
+  /// [arb_poly_equal]().
+  bool equal(const ArbPoly&) const;
+
+  /// Return a reference to the underlying [arb_poly_t]() element for direct
+  /// manipulation with the C API of Arb.
+  ::arb_poly_t& arb_poly_t() noexcept;
+
+  /// Return a const reference to the underlying [arb_poly_t]() element for
+  /// direct manipulation with the C API of Arb.
+  const ::arb_poly_t& arb_poly_t() const noexcept;
+
+  /// Write the coefficients of this polynomial to the output stream, the
+  /// constant coefficient first.
+  LIBARBXX_API friend std::ostream& operator<<(std::ostream&, const ArbPoly&);
+
+  /// Swap two polynomials without copying any coefficients, see
+  /// [arb_poly_swap]().
+  LIBARBXX_API friend void swap(ArbPoly&, ArbPoly&) noexcept;
+
+ private:
+  /// The underlying arb_poly_t; use arb_poly_t() to get a reference to it.
+  ::arb_poly_t t;
+};
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,375 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Non-owning views of [arb_struct]() and [arf_struct]() elements that are
+/// owned by C code.
+
+#ifndef LIBARBXX_ARB_REF_HPP
+#define LIBARBXX_ARB_REF_HPP
+
+#include <arb.h>
+
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "arb.hpp"
+#include "arf.hpp"
+
+namespace arbxx {
+
+// We hand out references to arb_struct and arf_struct as references to Arb
+// and Arf, so these must be nothing but the underlying structs.
+static_assert(sizeof(Arb) == sizeof(arb_struct), "Arb must have the same layout as arb_struct");
+static_assert(sizeof(Arf) == sizeof(arf_struct), "Arf must have the same layout as arf_struct");
+
+class ArbRef;
+class ArfRef;
+
+/// A read-only view of an [arb_struct]() that is owned by somebody else.
+///
+/// Such a view behaves like a `const Arb&`: it can be compared, converted,
+/// and printed, but it does not copy or free the element it refers to.
+///
+///     #include <arbxx/arb_ref.hpp>
+///
+///     arb_ptr v = _arb_vec_init(2);
+///     arb_set_si(v + 1, 2);
+///
+///     arbxx::ArbCRef x{v + 1};
+///     std::cout << x;
+///     // -> 2.00000
+///
+///     *(x > 1)
+///     // -> true
+///
+///     _arb_vec_clear(v, 2);
+///
+class ArbCRef {
+ public:
+  /// Create a view of the element `x`.
+  explicit ArbCRef(arb_srcptr x) noexcept : ptr(x) {}
+
+  /// Create a view of the element `x` which must outlive this view.
+  ArbCRef(const Arb& x) noexcept : ptr(x.arb_t()) {}
+
+  /// Return the element as a `const Arb&`.
+  const Arb& operator*() const noexcept { return *reinterpret_cast<const Arb*>(ptr); }
+  const Arb* operator->() const noexcept { return reinterpret_cast<const Arb*>(ptr); }
+  operator const Arb&() const noexcept { return **this; }
+
+  /// Return the [arb_t]() this view refers to for use with the C API.
+  arb_srcptr arb_t() const noexcept { return ptr; }
+
+  /// Return a view of the midpoint, see [arb_midref]().
+  ///
+  ///     arbxx::Arb x{1};
+  ///     std::cout << arbxx::ArbCRef{x}.mid();
+  ///     // -> 1
+  ///
+  inline class ArfCRef mid() const noexcept;
+
+  /// ==* Conversion Operators *==
+  /// Conversions that are available for [Arb]().
+  ///
+  ///     arbxx::Arb x{1};
+  ///     static_cast<double>(arbxx::ArbCRef{x})
+  ///     // -> 1
+  ///
+  explicit operator double() const { return static_cast<double>(**this); }
+  explicit operator Arf() const { return static_cast<Arf>(**this); }
+  explicit operator std::pair<Arf, Arf>() const { return static_cast<std::pair<Arf, Arf>>(**this); }
+
+  /// Return whether the element has the same midpoint and radius as `rhs`.
+  bool equal(const Arb& rhs) const { return (**this).equal(rhs); }
+
+  bool is_exact() const { return (**this).is_exact(); }
+  bool is_finite() const { return (**this).is_finite(); }
+
+  friend std::ostream& operator<<(std::ostream& os, const ArbCRef& self) { return os << *self; }
+
+ private:
+  arb_srcptr ptr;
+};
+
+/// A mutable view of an [arb_struct]() that is owned by somebody else.
+///
+/// Such a view behaves like an `Arb&`, in particular, assignment writes to
+/// the element it refers to:
+///
+///     arb_mat_t m;
+///     arb_mat_init(m, 2, 2);
+///
+///     arbxx::ArbRef x{arb_mat_entry(m, 0, 1)};
+///     x = 2;
+///     x *= 3;
+///     std::cout << arbxx::ArbCRef{arb_mat_entry(m, 0, 1)};
+///     // -> 6.00000
+///
+///     arb_mat_clear(m);
+///
+class ArbRef {
+ public:
+  /// Create a view of the element `x`.
+  explicit ArbRef(arb_ptr x) noexcept : ptr(x) {}
+
+  /// Create a view of the element `x` which must outlive this view.
+  ArbRef(Arb& x) noexcept : ptr(x.arb_t()) {}
+
+  /// Copying a view creates another view of the same element.
+  ArbRef(const ArbRef&) noexcept = default;
+
+  /// ==* Assignment *==
+  /// Assign to the element this view refers to.
+  ///
+  ///     arbxx::Arb x, y{1};
+  ///     arbxx::ArbRef{x} = arbxx::ArbCRef{y};
+  ///     std::cout << x;
+  ///     // -> 1.00000
+  ///
+  ArbRef& operator=(const ArbRef& rhs) {
+    **this = *rhs;
+    return *this;
+  }
+
+  template <typename T>
+  auto operator=(T&& rhs) -> decltype(std::declval<Arb&>() = std::forward<T>(rhs), std::declval<ArbRef&>()) {
+    **this = std::forward<T>(rhs);
+    return *this;
+  }
+
+  ArbRef& operator=(ArbCRef rhs) {
+    **this = *rhs;
+    return *this;
+  }
+
+  /// ==* Arithmetic *==
+  /// In-place arithmetic on the element this view refers to, see the
+  /// corresponding operators of [Arb]().
+  template <typename T>
+  auto operator+=(const T& rhs) -> decltype(std::declval<Arb&>() += rhs, std::declval<ArbRef&>()) {
+    **this += rhs;
+    return *this;
+  }
+
+  template <typename T>
+  auto operator-=(const T& rhs) -> decltype(std::declval<Arb&>() -= rhs, std::declval<ArbRef&>()) {
+    **this -= rhs;
+    return *this;
+  }
+
+  template <typename T>
+  auto operator*=(const T& rhs) -> decltype(std::declval<Arb&>() *= rhs, std::declval<ArbRef&>()) {
+    **this *= rhs;
+    return *this;
+  }
+
+  template <typename T>
+  auto operator/=(const T& rhs) -> decltype(std::declval<Arb&>() /= rhs, std::declval<ArbRef&>()) {
+    **this /= rhs;
+    return *this;
+  }
+
+  /// Return the element as an `Arb&`.
+  Arb& operator*() const noexcept { return *reinterpret_cast<Arb*>(ptr); }
+  Arb* operator->() const noexcept { return reinterpret_cast<Arb*>(ptr); }
+  operator Arb&() const noexcept { return **this; }
+  operator ArbCRef() const noexcept { return ArbCRef{ptr}; }
+
+  /// Return the [arb_t]() this view refers to for use with the C API.
+  arb_ptr arb_t() const noexcept { return ptr; }
+
+  /// Return a mutable view of the midpoint, see [arb_midref]().
+  ///
+  ///     arbxx::Arb x{1};
+  ///     arbxx::ArbRef{x}.mid() = 2;
+  ///     std::cout << x;
+  ///     // -> 2.00000
+  ///
+  inline ArfRef mid() const noexcept;
+
+  explicit operator double() const { return static_cast<double>(**this); }
+  explicit operator Arf() const { return static_cast<Arf>(**this); }
+  explicit operator std::pair<Arf, Arf>() const { return static_cast<std::pair<Arf, Arf>>(**this); }
+
+  bool equal(const Arb& rhs) const { return (**this).equal(rhs); }
+
+  bool is_exact() const { return (**this).is_exact(); }
+  bool is_finite() const { return (**this).is_finite(); }
+
+  friend std::ostream& operator<<(std::ostream& os, const ArbRef& self) { return os << *self; }
+
+  /// Swap the elements that two views refer to.
+  friend void swap(ArbRef lhs, ArbRef rhs) noexcept { arb_swap(lhs.ptr, rhs.ptr); }
+
+ private:
+  arb_ptr ptr;
+};
+
+/// A read-only view of an [arf_struct]() that is owned by somebody else,
+/// typically the midpoint of a ball.
+///
+///     arbxx::Arb x{mpq_class{1, 2}};
+///     arbxx::ArfCRef mid{arb_midref(x.arb_t())};
+///     mid < 1
+///     // -> true
+///
+class ArfCRef {
+ public:
+  explicit ArfCRef(arf_srcptr x) noexcept : ptr(x) {}
+  ArfCRef(const Arf& x) noexcept : ptr(x.arf_t()) {}
+
+  const Arf& operator*() const noexcept { return *reinterpret_cast<const Arf*>(ptr); }
+  const Arf* operator->() const noexcept { return reinterpret_cast<const Arf*>(ptr); }
+  operator const Arf&() const noexcept { return **this; }
+
+  arf_srcptr arf_t() const noexcept { return ptr; }
+
+  explicit operator double() const { return static_cast<double>(**this); }
+
+  friend std::ostream& operator<<(std::ostream& os, const ArfCRef& self) { return os << *self; }
+
+ private:
+  arf_srcptr ptr;
+};
+
+/// A mutable view of an [arf_struct]() that is owned by somebody else,
+/// typically the midpoint of a ball.
+///
+///     arbxx::Arb x{1};
+///     arbxx::ArfRef mid{arb_midref(x.arb_t())};
+///     mid <<= 1;
+///     std::cout << x;
+///     // -> 2.00000
+///
+class ArfRef {
+ public:
+  explicit ArfRef(arf_ptr x) noexcept : ptr(x) {}
+  ArfRef(Arf& x) noexcept : ptr(x.arf_t()) {}
+  ArfRef(const ArfRef&) noexcept = default;
+
+  ArfRef& operator=(const ArfRef& rhs) {
+    **this = *rhs;
+    return *this;
+  }
+
+  template <typename T>
+  auto operator=(T&& rhs) -> decltype(std::declval<Arf&>() = std::forward<T>(rhs), std::declval<ArfRef&>()) {
+    **this = std::forward<T>(rhs);
+    return *this;
+  }
+
+  ArfRef& operator=(ArfCRef rhs) {
+    **this = *rhs;
+    return *this;
+  }
+
+  template <typename T>
+  auto operator<<=(const T& rhs) -> decltype(std::declval<Arf&>() <<= rhs, std::declval<ArfRef&>()) {
+    **this <<= rhs;
+    return *this;
+  }
+
+  template <typename T>
+  auto operator>>=(const T& rhs) -> decltype(std::declval<Arf&>() >>= rhs, std::declval<ArfRef&>()) {
+    **this >>= rhs;
+    return *this;
+  }
+
+  Arf& operator*() const noexcept { return *reinterpret_cast<Arf*>(ptr); }
+  Arf* operator->() const noexcept { return reinterpret_cast<Arf*>(ptr); }
+  operator Arf&() const noexcept { return **this; }
+  operator ArfCRef() const noexcept { return ArfCRef{ptr}; }
+
+  arf_ptr arf_t() const noexcept { return ptr; }
+
+  explicit operator double() const { return static_cast<double>(**this); }
+
+  friend std::ostream& operator<<(std::ostream& os, const ArfRef& self) { return os << *self; }
+
+ private:
+  arf_ptr ptr;
+};
+
+ArfCRef ArbCRef::mid() const noexcept { return ArfCRef{arb_midref(ptr)}; }
+
+ArfRef ArbRef::mid() const noexcept { return ArfRef{arb_midref(ptr)}; }
+
+namespace detail {
+
+template <typename T>
+struct is_ref : std::false_type {};
+
+template <>
+struct is_ref<ArbRef> : std::true_type {};
+
+template <>
+struct is_ref<ArbCRef> : std::true_type {};
+
+template <>
+struct is_ref<ArfRef> : std::true_type {};
+
+template <>
+struct is_ref<ArfCRef> : std::true_type {};
+
+// Return the element a view refers to, or the argument itself if it is not
+// a view. (This is not called unref() to not compete with the helper of the
+// same name for expression templates in yap/arb.hpp.)
+template <typename T>
+decltype(auto) deref_view(const T& x) noexcept {
+  if constexpr (is_ref<T>::value)
+    return *x;
+  else
+    return (x);
+}
+
+template <typename L, typename R>
+using enable_if_ref = std::enable_if_t<is_ref<L>::value || is_ref<R>::value, int>;
+
+}  // namespace detail
+
+/// ==* Comparison Operators *==
+/// Views can be compared with anything that the elements they refer to can
+/// be compared with, see the corresponding operators of [Arb]() and [Arf]().
+///
+///     arbxx::Arb x{1}, y{2};
+///     *(arbxx::ArbCRef{x} < arbxx::ArbRef{y})
+///     // -> true
+///
+///     *(arbxx::ArbCRef{x} == 1)
+///     // -> true
+///
+#define LIBARBXX_REF_RELATION(OP)                                                                              \
+  template <typename L, typename R, detail::enable_if_ref<L, R> = 0>                                           \
+  auto operator OP(const L& lhs, const R& rhs)->decltype(detail::deref_view(lhs) OP detail::deref_view(rhs)) { \
+    return detail::deref_view(lhs) OP detail::deref_view(rhs);                                                 \
+  }
+
+LIBARBXX_REF_RELATION(==)
+LIBARBXX_REF_RELATION(!=)
+LIBARBXX_REF_RELATION(<)
+LIBARBXX_REF_RELATION(>)
+LIBARBXX_REF_RELATION(<=)
+LIBARBXX_REF_RELATION(>=)
+
+#undef LIBARBXX_REF_RELATION
+
+}  // namespace arbxx
+
+#endif
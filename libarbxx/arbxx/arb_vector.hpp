@@ -0,0 +1,293 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// C++ Wrappers for a contiguous vector of [arb_t]() elements.
+
+#ifndef LIBARBXX_ARB_VECTOR_HPP
+#define LIBARBXX_ARB_VECTOR_HPP
+
+#include <arb.h>
+#include <gmpxx.h>
+
+#include <iosfwd>
+#include <vector>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A fixed size vector of [Arb]() elements that live in a single block of
+/// memory allocated with [_arb_vec_init]().
+///
+/// Compared to a `std::vector<Arb>`, this saves one call into the library per
+/// element when the vector is created and destroyed, and the bulk operations
+/// below perform a single call into the library for the entire vector.
+///
+///     #include <arbxx/arb_vector.hpp>
+///
+///     arbxx::ArbVector v{std::vector<long>{1, 2, 3}};
+///     std::cout << v;
+///     // -> [1.00000, 2.00000, 3.00000]
+///
+///     std::cout << v.dot(v, 64);
+///     // -> 14.0000
+///
+/// The elements of the vector are [Arb]() elements that can be accessed and
+/// modified directly:
+///
+///     arbxx::ArbVector v{3};
+///     v[1] = 1;
+///     std::cout << v;
+///     // -> [0, 1.00000, 0]
+///
+/// Note that methods here are usually named as their counterparts in arb.h
+/// with the leading _arb_vec_ removed.
+class LIBARBXX_API ArbVector {
+ public:
+  using value_type = Arb;
+  using iterator = Arb*;
+  using const_iterator = const Arb*;
+
+  /// Create an empty vector.
+  ///
+  ///     arbxx::ArbVector v;
+  ///     v.size()
+  ///     // -> 0
+  ///
+  ArbVector() noexcept;
+
+  /// Create a vector of `length` exact zeros.
+  ///
+  ///     arbxx::ArbVector v{3};
+  ///     std::cout << v;
+  ///     // -> [0, 0, 0]
+  ///
+  explicit ArbVector(::arbxx::size length);
+
+  /// Create a vector of exact elements equal to these integers.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     std::cout << v;
+  ///     // -> [1.00000, 2.00000]
+  ///
+  ///     arbxx::ArbVector w{std::vector<mpz_class>{1, 2}};
+  ///     std::cout << w;
+  ///     // -> [1.00000, 2.00000]
+  ///
+  explicit ArbVector(const std::vector<long>&);
+  explicit ArbVector(const std::vector<mpz_class>&);
+
+  /// Create a vector with copies of these elements.
+  ///
+  ///     arbxx::ArbVector v{std::vector{arbxx::Arb{1}, arbxx::Arb{2}}};
+  ///     std::cout << v;
+  ///     // -> [1.00000, 2.00000]
+  ///
+  explicit ArbVector(const std::vector<Arb>&);
+
+  /// Create a copy of this vector.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     arbxx::ArbVector w{v};
+  ///     w.equal(v)
+  ///     // -> true
+  ///
+  ArbVector(const ArbVector&);
+
+  /// Create a vector from `v` and leave `v` empty.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     arbxx::ArbVector w{std::move(v)};
+  ///     std::cout << w;
+  ///     // -> [1.00000, 2.00000]
+  ///
+  ArbVector(ArbVector&&) noexcept;
+
+  ~ArbVector() noexcept;
+
+  /// ==* `operator=(ArbVector)` *==
+  /// Reset this vector to the one given.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}}, w;
+  ///     w = v;
+  ///     std::cout << w;
+  ///     // -> [1.00000, 2.00000]
+  ///
+  ArbVector& operator=(const ArbVector&);
+  ArbVector& operator=(ArbVector&&) noexcept;
+
+  /// Return the number of elements in this vector.
+  ///
+  ///     arbxx::ArbVector v{3};
+  ///     v.size()
+  ///     // -> 3
+  ///
+  ::arbxx::size size() const noexcept;
+
+  /// Return whether this vector has no elements.
+  ///
+  ///     arbxx::ArbVector v;
+  ///     v.empty()
+  ///     // -> true
+  ///
+  bool empty() const noexcept;
+
+  /// ==* `operator[]` *==
+  /// Return a reference to the element at position `i`. No bounds checking
+  /// is performed.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     std::cout << v[1];
+  ///     // -> 2.00000
+  ///
+  Arb& operator[](::arbxx::size i) noexcept;
+  const Arb& operator[](::arbxx::size i) const noexcept;
+
+  /// ==* `begin()`, `end()` *==
+  /// Return iterators to the elements of this vector.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     for (auto& x : v) std::cout << x << " ";
+  ///     // -> 1.00000 2.00000
+  ///
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  /// Return a pointer to the underlying [arb_struct]() elements for direct
+  /// manipulation with the C API of Arb.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     _arb_vec_neg(v.arb_ptr(), v.arb_ptr(), v.size());
+  ///     std::cout << v;
+  ///     // -> [-1.00000, -2.00000]
+  ///
+  ::arb_ptr arb_ptr() noexcept;
+  ::arb_srcptr arb_ptr() const noexcept;
+
+  /// Replace this vector with the elementwise sum with `rhs`, see
+  /// [_arb_vec_add](). The vectors must have the same length.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     v.add(v, 64);
+  ///     std::cout << v;
+  ///     // -> [2.00000, 4.00000]
+  ///
+  ArbVector& add(const ArbVector& rhs, prec);
+
+  /// Replace this vector with the elementwise difference with `rhs`, see
+  /// [_arb_vec_sub](). The vectors must have the same length.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     v.sub(v, 64);
+  ///     std::cout << v;
+  ///     // -> [0, 0]
+  ///
+  ArbVector& sub(const ArbVector& rhs, prec);
+
+  /// Replace this vector with the elementwise product with `rhs`. The vectors
+  /// must have the same length.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     v.mul(v, 64);
+  ///     std::cout << v;
+  ///     // -> [1.00000, 4.00000]
+  ///
+  ArbVector& mul(const ArbVector& rhs, prec);
+
+  /// Replace this vector with its negative, see [_arb_vec_neg]().
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     v.neg();
+  ///     std::cout << v;
+  ///     // -> [-1.00000, -2.00000]
+  ///
+  ArbVector& neg();
+
+  /// Multiply every element of this vector with `c`, see
+  /// [_arb_vec_scalar_mul]().
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     v.scalar_mul(arbxx::Arb{3}, 64);
+  ///     std::cout << v;
+  ///     // -> [3.00000, 6.00000]
+  ///
+  ArbVector& scalar_mul(const Arb& c, prec);
+
+  /// Add `c` times `rhs` to this vector, see [_arb_vec_scalar_addmul](). The
+  /// vectors must have the same length.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     v.scalar_addmul(v, arbxx::Arb{2}, 64);
+  ///     std::cout << v;
+  ///     // -> [3.00000, 6.00000]
+  ///
+  ArbVector& scalar_addmul(const ArbVector& rhs, const Arb& c, prec);
+
+  /// Return the dot product of this vector with `rhs`, see [arb_dot](). The
+  /// vectors must have the same length.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     std::cout << v.dot(v, 64);
+  ///     // -> 5.00000
+  ///
+  Arb dot(const ArbVector& rhs, prec) const;
+
+  /// Return the sum of the elements of this vector, see [arb_dot_si]().
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     std::cout << v.sum(64);
+  ///     // -> 3.00000
+  ///
+  Arb sum(prec) const;
+
+  /// Return whether all elements have the same midpoint and radius as the
+  /// corresponding elements of `rhs`.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     v.equal(v)
+  ///     // -> true
+  ///
+  bool equal(const ArbVector&) const;
+
+  /// Return the midpoints of the elements rounded to the closest double.
+  ///
+  ///     arbxx::ArbVector v{std::vector<long>{1, 2}};
+  ///     static_cast<std::vector<double>>(v)[1]
+  ///     // -> 2
+  ///
+  explicit operator std::vector<double>() const;
+
+  /// Write this vector to the output stream.
+  LIBARBXX_API friend std::ostream& operator<<(std::ostream&, const ArbVector&);
+
+  /// Swap two vectors without copying any elements.
+  LIBARBXX_API friend void swap(ArbVector&, ArbVector&) noexcept;
+
+ private:
+  // The underlying block of memory created with _arb_vec_init or nullptr if
+  // the vector is empty.
+  ::arb_ptr data;
+  ::arbxx::size length;
+};
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,364 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Balls [arb_t]() whose precision is fixed at compile time.
+
+#ifndef LIBARBXX_ARBP_HPP
+#define LIBARBXX_ARBP_HPP
+
+#include <arb.h>
+
+#include <iosfwd>
+#include <optional>
+#include <type_traits>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A ball like [Arb]() whose arithmetic is always performed with a working
+/// precision of `Bits` bits.
+///
+///     #include <arbxx/arbp.hpp>
+///
+///     arbxx::ArbP<64> x{1}, y{3};
+///     auto z = x / y;
+///     z.is_exact()
+///     // -> false
+///
+/// Unlike arithmetic on `Arb`, which builds expressions that are evaluated
+/// once a precision is supplied, arithmetic on `ArbP` is performed
+/// immediately. All methods are defined in this header so that the compiler
+/// can inline everything down to the calls into Arb's C API.
+///
+/// Since all results are rounded to `Bits` bits, for `Bits` up to 128 (on
+/// 64-bit platforms) the midpoint of the ball is always stored inline in
+/// the underlying [arb_t]() and arithmetic causes no heap allocations
+/// unless exponents become huge. In this case, elements are also copied
+/// without calling into Arb, see `inline_mantissa`.
+///
+/// Conversion from and to `Arb` is explicit:
+///
+///     arbxx::ArbP<64> w{arbxx::Arb{1337}};
+///     std::cout << static_cast<arbxx::Arb>(w);
+///     // -> 1337.00
+///
+template <prec Bits>
+class ArbP {
+  static_assert(Bits >= 2, "precision of ArbP must be at least two bits");
+
+  // The integer types that can be used as operands without conversion.
+  template <typename T>
+  using enable_if_integer = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= sizeof(slong)>;
+
+ public:
+  /// The working precision of all operations on this type.
+  static constexpr prec precision = Bits;
+
+  /// Whether the midpoint of every element fits into the limbs that an
+  /// [arf_t]() provides inline, i.e., whether arithmetic does not need to
+  /// allocate memory for the mantissa.
+  static constexpr bool inline_mantissa = Bits <= ARF_NOPTR_LIMBS * FLINT_BITS;
+
+  /// Create an exact zero element.
+  ///
+  ///     arbxx::ArbP<64> x;
+  ///     std::cout << x;
+  ///     // -> 0
+  ///
+  ArbP() noexcept { arb_init(t); }
+
+  /// Create a copy of `x`.
+  ArbP(const ArbP& x) noexcept {
+    if constexpr (inline_mantissa) {
+      if (shallow(x.t)) {
+        *t = *x.t;
+        return;
+      }
+    }
+    arb_init(t);
+    arb_set(t, x.t);
+  }
+
+  /// Create a new element from `x`, leaving `x` as an exact zero.
+  ArbP(ArbP&& x) noexcept {
+    *t = *x.t;
+    arb_init(x.t);
+  }
+
+  /// Create an element equal to this integer, rounded to `Bits` bits.
+  ///
+  ///     arbxx::ArbP<2> x{7};
+  ///     x.is_exact()
+  ///     // -> false
+  ///
+  template <typename T, typename = enable_if_integer<T>>
+  explicit ArbP(T x) noexcept {
+    arb_init(t);
+    if constexpr (std::is_signed_v<T>)
+      arb_set_si(t, x);
+    else
+      arb_set_ui(t, x);
+    if constexpr (Bits < FLINT_BITS)
+      arb_set_round(t, t, Bits);
+  }
+
+  /// Create an element from `x`, rounded to `Bits` bits, see
+  /// [arb_set_round]().
+  ///
+  ///     arbxx::Arb x{mpq_class{1, 3}, 256};
+  ///     std::cout << arbxx::ArbP<16>{x};
+  ///     // -> [0.33333 +/- 4.58e-6]
+  ///
+  explicit ArbP(const Arb& x) noexcept {
+    arb_init(t);
+    arb_set_round(t, x.arb_t(), Bits);
+  }
+
+  ~ArbP() noexcept { arb_clear(t); }
+
+  /// ==* `operator=(ArbP)` *==
+  /// Reset this element to the one given.
+  ArbP& operator=(const ArbP& x) noexcept {
+    if (this == &x)
+      return *this;
+
+    if constexpr (inline_mantissa) {
+      if (shallow(t) && shallow(x.t)) {
+        *t = *x.t;
+        return *this;
+      }
+    }
+    arb_set(t, x.t);
+    return *this;
+  }
+
+  ArbP& operator=(ArbP&& x) noexcept {
+    arb_swap(t, x.t);
+    return *this;
+  }
+
+  /// Return an `Arb` with the same midpoint and radius as this element.
+  explicit operator Arb() const {
+    Arb ret;
+    arb_set(ret.arb_t(), t);
+    return ret;
+  }
+
+  /// ==* Arithmetic *==
+  /// Arithmetic with other elements and with integers is performed
+  /// immediately with a working precision of `Bits` bits.
+  ///
+  ///     arbxx::ArbP<128> x{1}, y{2};
+  ///     std::cout << (x + y) * 3;
+  ///     // -> 9.00000
+  ///
+  ///     std::cout << 1 / y;
+  ///     // -> 0.500000
+  ///
+  ///     x *= y;
+  ///     std::cout << x;
+  ///     // -> 2.00000
+  ///
+  ArbP& operator+=(const ArbP& rhs) noexcept {
+    arb_add(t, t, rhs.t, Bits);
+    return *this;
+  }
+
+  ArbP& operator-=(const ArbP& rhs) noexcept {
+    arb_sub(t, t, rhs.t, Bits);
+    return *this;
+  }
+
+  ArbP& operator*=(const ArbP& rhs) noexcept {
+    arb_mul(t, t, rhs.t, Bits);
+    return *this;
+  }
+
+  ArbP& operator/=(const ArbP& rhs) noexcept {
+    arb_div(t, t, rhs.t, Bits);
+    return *this;
+  }
+
+  template <typename T, typename = enable_if_integer<T>>
+  ArbP& operator+=(T rhs) noexcept {
+    if constexpr (std::is_signed_v<T>)
+      arb_add_si(t, t, rhs, Bits);
+    else
+      arb_add_ui(t, t, rhs, Bits);
+    return *this;
+  }
+
+  template <typename T, typename = enable_if_integer<T>>
+  ArbP& operator-=(T rhs) noexcept {
+    if constexpr (std::is_signed_v<T>)
+      arb_sub_si(t, t, rhs, Bits);
+    else
+      arb_sub_ui(t, t, rhs, Bits);
+    return *this;
+  }
+
+  template <typename T, typename = enable_if_integer<T>>
+  ArbP& operator*=(T rhs) noexcept {
+    if constexpr (std::is_signed_v<T>)
+      arb_mul_si(t, t, rhs, Bits);
+    else
+      arb_mul_ui(t, t, rhs, Bits);
+    return *this;
+  }
+
+  template <typename T, typename = enable_if_integer<T>>
+  ArbP& operator/=(T rhs) noexcept {
+    if constexpr (std::is_signed_v<T>)
+      arb_div_si(t, t, rhs, Bits);
+    else
+      arb_div_ui(t, t, rhs, Bits);
+    return *this;
+  }
+
+  /// Return the negative of this element, see [arb_neg]().
+  ArbP operator-() const noexcept {
+    ArbP ret;
+    arb_neg(ret.t, t);
+    return ret;
+  }
+
+  friend ArbP operator+(const ArbP& lhs, const ArbP& rhs) noexcept {
+    ArbP ret;
+    arb_add(ret.t, lhs.t, rhs.t, Bits);
+    return ret;
+  }
+
+  friend ArbP operator-(const ArbP& lhs, const ArbP& rhs) noexcept {
+    ArbP ret;
+    arb_sub(ret.t, lhs.t, rhs.t, Bits);
+    return ret;
+  }
+
+  friend ArbP operator*(const ArbP& lhs, const ArbP& rhs) noexcept {
+    ArbP ret;
+    arb_mul(ret.t, lhs.t, rhs.t, Bits);
+    return ret;
+  }
+
+  friend ArbP operator/(const ArbP& lhs, const ArbP& rhs) noexcept {
+    ArbP ret;
+    arb_div(ret.t, lhs.t, rhs.t, Bits);
+    return ret;
+  }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator+(ArbP lhs, T rhs) noexcept { return lhs += rhs; }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator+(T lhs, ArbP rhs) noexcept { return rhs += lhs; }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator-(ArbP lhs, T rhs) noexcept { return lhs -= rhs; }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator-(T lhs, ArbP rhs) noexcept {
+    // Rounding is symmetric, so this is the same as computing lhs - rhs.
+    rhs -= lhs;
+    arb_neg(rhs.t, rhs.t);
+    return rhs;
+  }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator*(ArbP lhs, T rhs) noexcept { return lhs *= rhs; }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator*(T lhs, ArbP rhs) noexcept { return rhs *= lhs; }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator/(ArbP lhs, T rhs) noexcept { return lhs /= rhs; }
+
+  template <typename T, typename = enable_if_integer<T>>
+  friend ArbP operator/(T lhs, const ArbP& rhs) noexcept {
+    // The numerator is not rounded to Bits; a single limb is stored inline.
+    ArbP ret;
+    if constexpr (std::is_signed_v<T>)
+      arb_set_si(ret.t, lhs);
+    else
+      arb_set_ui(ret.t, lhs);
+    arb_div(ret.t, ret.t, rhs.t, Bits);
+    return ret;
+  }
+
+  /// ==* Relational Operators *==
+  /// Relations between elements are decided like for `Arb`, i.e., they
+  /// return nothing if the relation cannot be decided from the balls.
+  ///
+  ///     arbxx::ArbP<64> x{1}, y{2};
+  ///     *(x < y)
+  ///     // -> true
+  ///
+  ///     (x / 3 < x / 3).has_value()
+  ///     // -> false
+  ///
+  friend std::optional<bool> operator==(const ArbP& lhs, const ArbP& rhs) noexcept { return relation(arb_eq(lhs.t, rhs.t), arb_ne(lhs.t, rhs.t)); }
+  friend std::optional<bool> operator!=(const ArbP& lhs, const ArbP& rhs) noexcept { return relation(arb_ne(lhs.t, rhs.t), arb_eq(lhs.t, rhs.t)); }
+  friend std::optional<bool> operator<(const ArbP& lhs, const ArbP& rhs) noexcept { return relation(arb_lt(lhs.t, rhs.t), arb_ge(lhs.t, rhs.t)); }
+  friend std::optional<bool> operator>(const ArbP& lhs, const ArbP& rhs) noexcept { return relation(arb_gt(lhs.t, rhs.t), arb_le(lhs.t, rhs.t)); }
+  friend std::optional<bool> operator<=(const ArbP& lhs, const ArbP& rhs) noexcept { return relation(arb_le(lhs.t, rhs.t), arb_gt(lhs.t, rhs.t)); }
+  friend std::optional<bool> operator>=(const ArbP& lhs, const ArbP& rhs) noexcept { return relation(arb_ge(lhs.t, rhs.t), arb_lt(lhs.t, rhs.t)); }
+
+  /// Return whether this element has the same midpoint and radius as `rhs`,
+  /// see [arb_equal]().
+  bool equal(const ArbP& rhs) const noexcept { return arb_equal(t, rhs.t); }
+
+  /// Return whether this element is exact, i.e., has radius zero, see
+  /// [arb_is_exact]().
+  bool is_exact() const noexcept { return arb_is_exact(t); }
+
+  /// Return a reference to the underlying [arb_t]() element for direct
+  /// manipulation with the C API of Arb.
+  ::arb_t& arb_t() noexcept { return t; }
+
+  /// Return a const reference to the underlying [arb_t]() element for
+  /// direct manipulation with the C API of Arb.
+  const ::arb_t& arb_t() const noexcept { return t; }
+
+  /// Swap two elements without copying their mantissas, see [arb_swap]().
+  friend void swap(ArbP& lhs, ArbP& rhs) noexcept { arb_swap(lhs.t, rhs.t); }
+
+  /// Write this element to the output stream.
+  friend std::ostream& operator<<(std::ostream& os, const ArbP& self) { return os << static_cast<Arb>(self); }
+
+ private:
+  // Return whether x owns no memory, i.e., whether its mantissa is stored
+  // inline and neither of its exponents is a big integer. Such an element
+  // can be copied and overwritten with a plain struct copy.
+  static bool shallow(arb_srcptr x) noexcept {
+    return !ARF_HAS_PTR(arb_midref(x)) && !COEFF_IS_MPZ(ARF_EXP(arb_midref(x))) && !COEFF_IS_MPZ(MAG_EXP(arb_radref(x)));
+  }
+
+  static std::optional<bool> relation(bool holds, bool fails) noexcept {
+    if (holds) return true;
+    if (fails) return false;
+    return std::nullopt;
+  }
+
+  // The underlying arb_t; use arb_t() to get a reference to it.
+  ::arb_t t;
+};
+
+}  // namespace arbxx
+
+#endif
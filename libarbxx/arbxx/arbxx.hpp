@@ -26,8 +26,30 @@
 #ifndef LIBARBXX_EXACT_REAL_HPP
 #define LIBARBXX_EXACT_REAL_HPP
 
+#include "acb.hpp"
 #include "arb.hpp"
+#include "arb_batch.hpp"
+#include "arb_matrix.hpp"
+#include "arb_poly.hpp"
+#include "arb_ref.hpp"
+#include "arb_vector.hpp"
+#include "arbp.hpp"
+#include "arena.hpp"
 #include "arf.hpp"
+#include "compare.hpp"
+#include "decide.hpp"
+#include "hybrid_arb.hpp"
+#include "interval_index.hpp"
+#include "mapped_arb_array.hpp"
+#include "parallel.hpp"
+#include "parse.hpp"
+#include "precision.hpp"
+#include "shared_arb.hpp"
+#include "threads.hpp"
+#include "to_chars.hpp"
+#include "yap/acb.hpp"
+#include "yap/arb.hpp"
+#include "yap/arf.hpp"
 
 // Do not include extensions to the API which integrate with other libraries.
 // #include "cereal.hpp"
@@ -0,0 +1,123 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Allocate the memory of [Arb]() and [Arf]() elements from an arena.
+
+#ifndef LIBARBXX_ARENA_HPP
+#define LIBARBXX_ARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "local.hpp"
+
+namespace arbxx {
+
+/// Routes the memory that FLINT allocates in the current thread, such as the
+/// limbs of the mantissas of [Arb]() and [Arf]() elements, to an arena for
+/// the lifetime of this object.
+///
+/// The arena hands out memory from large chunks by bumping a pointer. When
+/// all the memory handed out from a chunk has been freed, the chunk is
+/// reused. This makes workloads that create many temporaries at high
+/// precision considerably cheaper than going through the system allocator
+/// for each of them.
+///
+///     #include <arbxx/arena.hpp>
+///
+///     arbxx::Arb x{mpq_class{1, 3}, 65536};
+///     {
+///       arbxx::Arena arena;
+///       for (int i = 0; i < 1024; i++) {
+///         arbxx::Arb y = x;
+///         y *= x;
+///       }
+///     }
+///
+/// Elements may safely outlive the arena their memory was allocated from.
+/// When the arena is destroyed, only chunks without any live allocations
+/// are returned to the system. The remaining chunks are returned once the
+/// last element using them is destroyed (in any thread). Such elements
+/// therefore keep their entire chunk alive, so results that are supposed to
+/// outlive the arena should preferably be created outside of it.
+///
+/// Arenas can be nested; allocations go to the innermost arena of the
+/// current thread. Like the [PrecisionScope](), arenas are thread local, so
+/// threads do not contend on the arena when allocating. Freeing memory does
+/// not take any locks either, only creating and releasing chunks does.
+///
+/// Note that FLINT's memory functions are replaced for the entire process
+/// when the first arena is created. Afterwards, outside of an arena, FLINT
+/// allocations go to the original memory functions with a small overhead.
+class LIBARBXX_API Arena {
+ public:
+  /// The default size of the chunks of memory that an arena allocates from
+  /// the system.
+  static constexpr std::size_t DEFAULT_CHUNK_SIZE = std::size_t(1) << 20;
+
+  /// Route allocations of the current thread to this arena until it is
+  /// destroyed. Allocations that are larger than half of `chunk_size` are
+  /// not served from the arena.
+  explicit Arena(std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /// Restore the arena that was active when this arena was created and
+  /// release all chunks that are not used by any live allocation anymore.
+  ~Arena() noexcept;
+
+  /// Return the number of allocations served by this arena so far.
+  ///
+  ///     arbxx::Arena arena;
+  ///     arbxx::Arb x{mpq_class{1, 3}, 1024};
+  ///     arena.allocations() > 0
+  ///     // -> true
+  ///
+  std::size_t allocations() const noexcept;
+
+  /// Return whether an arena is active in the current thread.
+  ///
+  ///     arbxx::Arena::active()
+  ///     // -> false
+  ///
+  ///     arbxx::Arena arena;
+  ///     arbxx::Arena::active()
+  ///     // -> true
+  ///
+  static bool active() noexcept;
+
+ private:
+  struct Chunk;
+
+  friend struct ArenaAllocator;
+
+  Arena* previous;
+  std::size_t chunk_size;
+
+  // The chunks owned by this arena; allocations are served from the last
+  // one.
+  std::vector<Chunk*> chunks;
+
+  std::size_t served = 0;
+};
+
+}  // namespace arbxx
+
+#endif
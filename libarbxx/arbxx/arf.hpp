@@ -192,6 +192,60 @@ class LIBARBXX_API Arf : boost::totally_ordered<Arf>,
   ///
   Arf& operator=(double);
 
+  /// ==* In-place Arithmetic *==
+  /// Replace this element with the result of the operation performed with
+  /// the working precision and rounding mode of the current thread, see
+  /// [PrecisionScope]().
+  ///
+  ///     #include <arbxx/precision.hpp>
+  ///
+  ///     arbxx::Arf x{1};
+  ///     arbxx::PrecisionScope scope{2, arbxx::Arf::Round::DOWN};
+  ///     x /= 3;
+  ///     std::cout << x;
+  ///     // -> 0.25=1p-2
+  ///
+  Arf& operator+=(const Arf&);
+  Arf& operator+=(short);
+  Arf& operator+=(unsigned short);
+  Arf& operator+=(int);
+  Arf& operator+=(unsigned int);
+  Arf& operator+=(long);
+  Arf& operator+=(unsigned long);
+  Arf& operator+=(long long);
+  Arf& operator+=(unsigned long long);
+  Arf& operator+=(const mpz_class&);
+  Arf& operator-=(const Arf&);
+  Arf& operator-=(short);
+  Arf& operator-=(unsigned short);
+  Arf& operator-=(int);
+  Arf& operator-=(unsigned int);
+  Arf& operator-=(long);
+  Arf& operator-=(unsigned long);
+  Arf& operator-=(long long);
+  Arf& operator-=(unsigned long long);
+  Arf& operator-=(const mpz_class&);
+  Arf& operator*=(const Arf&);
+  Arf& operator*=(short);
+  Arf& operator*=(unsigned short);
+  Arf& operator*=(int);
+  Arf& operator*=(unsigned int);
+  Arf& operator*=(long);
+  Arf& operator*=(unsigned long);
+  Arf& operator*=(long long);
+  Arf& operator*=(unsigned long long);
+  Arf& operator*=(const mpz_class&);
+  Arf& operator/=(const Arf&);
+  Arf& operator/=(short);
+  Arf& operator/=(unsigned short);
+  Arf& operator/=(int);
+  Arf& operator/=(unsigned int);
+  Arf& operator/=(long);
+  Arf& operator/=(unsigned long);
+  Arf& operator/=(long long);
+  Arf& operator/=(unsigned long long);
+  Arf& operator/=(const mpz_class&);
+
   /// Return the negative of this value, see [arf_neg]().
   ///
   ///     arbxx::Arf x{1};
@@ -383,6 +437,12 @@ class LIBARBXX_API Arf : boost::totally_ordered<Arf>,
   /// manipulation with C API of Arb.
   const ::arf_t& arf_t() const;
 
+  // Syntactic sugar for Yap, so that x(64, Round::NEAR) rounds x to 64 bits
+  // just like (x + y)(64, Round::NEAR) evaluates an expression at 64 bits.
+  // Defined in yap/arf.hpp.
+  template <typename... Args>
+  LIBARBXX_LOCAL decltype(auto) operator()(Args&&...) const;
+
  private:
   // The underlying arf_t; use arf_t() to get a reference to it.
   // TODO: Mention implicit cast.
@@ -21,27 +21,241 @@
 #ifndef LIBARBXX_CEREAL_HPP
 #define LIBARBXX_CEREAL_HPP
 
+#include <arb.h>
+#include <arf.h>
+#include <mag.h>
+
 #include <cereal/cereal.hpp>
+#include <cereal/types/string.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "acb.hpp"
 #include "arb.hpp"
 #include "arf.hpp"
 
 namespace arbxx {
 
+namespace detail {
+
+// The version of the format written to binary archives. Text archives
+// contain the output of arb_dump_str() and a double approximation instead.
+inline constexpr std::uint8_t CEREAL_BINARY_VERSION = 1;
+
+// Marks an exponent that does not fit into a word. Since small fmpz are
+// strictly bigger than COEFF_MIN, this cannot be a small exponent.
+inline constexpr std::int64_t CEREAL_LARGE_EXPONENT = std::numeric_limits<std::int64_t>::min();
+
+// The kinds of arf_t in the binary format.
+enum class CerealArfKind : std::uint8_t {
+  ZERO,
+  POSITIVE_INFINITY,
+  NEGATIVE_INFINITY,
+  NOT_A_NUMBER,
+  POSITIVE,
+  NEGATIVE,
+};
+
+// Write the header of the binary format, i.e., its version and the size of a
+// limb on this platform.
+template <typename Archive>
+void save_header(Archive& archive) {
+  archive(CEREAL_BINARY_VERSION, static_cast<std::uint8_t>(FLINT_BITS));
+}
+
+template <typename Archive>
+void load_header(Archive& archive) {
+  std::uint8_t version, bits;
+  archive(version, bits);
+
+  if (version != CEREAL_BINARY_VERSION)
+    throw std::logic_error("malformed archive, unsupported version " + std::to_string(version) + " of binary format");
+  if (bits != FLINT_BITS)
+    throw std::logic_error("cannot load archive created on a platform with " + std::to_string(bits) + " bit limbs");
+}
+
+// Write an exponent. Exponents are almost always small, so they are written
+// as a single word. Large exponents are followed by their signed limb count
+// and their limbs.
+template <typename Archive>
+void save_exponent(Archive& archive, const fmpz_t exponent) {
+  if (!COEFF_IS_MPZ(*exponent)) {
+    archive(static_cast<std::int64_t>(*exponent));
+    return;
+  }
+
+  const __mpz_struct* z = COEFF_TO_PTR(*exponent);
+  archive(CEREAL_LARGE_EXPONENT, static_cast<std::int64_t>(z->_mp_size));
+  archive(cereal::binary_data(static_cast<const mp_limb_t*>(z->_mp_d), std::abs(z->_mp_size) * sizeof(mp_limb_t)));
+}
+
+template <typename Archive>
+void load_exponent(Archive& archive, fmpz_t exponent) {
+  std::int64_t value;
+  archive(value);
+
+  if (value != CEREAL_LARGE_EXPONENT) {
+    fmpz_set_si(exponent, static_cast<slong>(value));
+    return;
+  }
+
+  std::int64_t size;
+  archive(size);
+
+  std::vector<mp_limb_t> limbs(std::abs(size));
+  archive(cereal::binary_data(limbs.data(), limbs.size() * sizeof(mp_limb_t)));
+
+  fmpz_set_ui_array(exponent, limbs.data(), static_cast<slong>(limbs.size()));
+  if (size < 0)
+    fmpz_neg(exponent, exponent);
+}
+
+// Write an arf_t as its kind, exponent, and the limbs of its mantissa. The
+// number of limbs is written as 32 bit integer which is more than enough for
+// any mantissa that fits into memory.
+template <typename Archive>
+void save_arf(Archive& archive, const arf_t value) {
+  if (arf_is_special(value)) {
+    CerealArfKind kind = CerealArfKind::NOT_A_NUMBER;
+    if (arf_is_zero(value))
+      kind = CerealArfKind::ZERO;
+    else if (arf_is_pos_inf(value))
+      kind = CerealArfKind::POSITIVE_INFINITY;
+    else if (arf_is_neg_inf(value))
+      kind = CerealArfKind::NEGATIVE_INFINITY;
+
+    archive(static_cast<std::uint8_t>(kind));
+    return;
+  }
+
+  archive(static_cast<std::uint8_t>(ARF_SGNBIT(value) ? CerealArfKind::NEGATIVE : CerealArfKind::POSITIVE));
+  save_exponent(archive, ARF_EXPREF(value));
+
+  mp_srcptr limbs;
+  mp_size_t size;
+  ARF_GET_MPN_READONLY(limbs, size, value);
+
+  archive(static_cast<std::uint32_t>(size));
+  archive(cereal::binary_data(static_cast<const mp_limb_t*>(limbs), size * sizeof(mp_limb_t)));
+}
+
+// Read an arf_t written by save_arf(). The limbs are read directly into the
+// mantissa of `value`.
+template <typename Archive>
+void load_arf(Archive& archive, arf_t value) {
+  std::uint8_t kind;
+  archive(kind);
+
+  switch (static_cast<CerealArfKind>(kind)) {
+    case CerealArfKind::ZERO:
+      arf_zero(value);
+      return;
+    case CerealArfKind::POSITIVE_INFINITY:
+      arf_pos_inf(value);
+      return;
+    case CerealArfKind::NEGATIVE_INFINITY:
+      arf_neg_inf(value);
+      return;
+    case CerealArfKind::NOT_A_NUMBER:
+      arf_nan(value);
+      return;
+    case CerealArfKind::POSITIVE:
+    case CerealArfKind::NEGATIVE:
+      break;
+    default:
+      throw std::logic_error("malformed archive, unknown kind of Arf");
+  }
+
+  load_exponent(archive, ARF_EXPREF(value));
+
+  std::uint32_t size;
+  archive(size);
+
+  if (size == 0) {
+    arf_zero(value);
+    throw std::logic_error("malformed archive, Arf without mantissa");
+  }
+
+  mp_ptr limbs;
+  ARF_GET_MPN_WRITE(limbs, static_cast<mp_size_t>(size), value);
+  archive(cereal::binary_data(limbs, size * sizeof(mp_limb_t)));
+
+  // Arb expects the mantissa to be normalized, i.e., the top bit must be set
+  // and the lowest limb must not vanish.
+  if (!(limbs[size - 1] >> (FLINT_BITS - 1)) || !limbs[0]) {
+    arf_zero(value);
+    throw std::logic_error("malformed archive, mantissa of Arf is not normalized");
+  }
+
+  ARF_XSIZE(value) = ARF_MAKE_XSIZE(size, static_cast<CerealArfKind>(kind) == CerealArfKind::NEGATIVE);
+}
+
+// Write a mag_t as its exponent and its MAG_BITS bit mantissa.
+template <typename Archive>
+void save_mag(Archive& archive, const mag_t value) {
+  save_exponent(archive, MAG_EXPREF(value));
+  archive(static_cast<std::uint32_t>(MAG_MAN(value)));
+}
+
+template <typename Archive>
+void load_mag(Archive& archive, mag_t value) {
+  load_exponent(archive, MAG_EXPREF(value));
+
+  std::uint32_t mantissa;
+  archive(mantissa);
+
+  const bool normalized = mantissa ? (mantissa >> (MAG_BITS - 1)) == 1 : (fmpz_is_zero(MAG_EXPREF(value)) || fmpz_equal_si(MAG_EXPREF(value), MAG_EXP_POS_INF));
+  if (!normalized) {
+    mag_zero(value);
+    throw std::logic_error("malformed archive, radius of Arb is not normalized");
+  }
+
+  MAG_MAN(value) = mantissa;
+}
+
+}  // namespace detail
+
+// Text archives, such as JSON, contain the output of arb_dump_str() and a
+// double approximation for readability. Binary archives contain an empty
+// string in place of the former, followed by the limbs of the midpoint and
+// the radius. Since older versions wrote the text format to all archives,
+// loading tells the formats apart by that string.
 template <typename Archive>
 void save(Archive& archive, const Arb& self) {
-  char* serialized = arb_dump_str(self.arb_t());
-  archive(
-      cereal::make_nvp("data", std::string(serialized)),
-      cereal::make_nvp("approximation", static_cast<double>(self)));
-  flint_free(serialized);
+  if constexpr (cereal::traits::is_text_archive<Archive>::value) {
+    char* serialized = arb_dump_str(self.arb_t());
+    archive(
+        cereal::make_nvp("data", std::string(serialized)),
+        cereal::make_nvp("approximation", static_cast<double>(self)));
+    flint_free(serialized);
+  } else {
+    archive(std::string());
+    detail::save_header(archive);
+    detail::save_arf(archive, arb_midref(self.arb_t()));
+    detail::save_mag(archive, arb_radref(self.arb_t()));
+  }
 }
 
 template <typename Archive>
 void load(Archive& archive, Arb& self) {
   std::string data;
+  archive(data);
+
+  if constexpr (!cereal::traits::is_text_archive<Archive>::value) {
+    if (data.empty()) {
+      detail::load_header(archive);
+      detail::load_arf(archive, arb_midref(self.arb_t()));
+      detail::load_mag(archive, arb_radref(self.arb_t()));
+      return;
+    }
+  }
+
   double ignored;
-  archive(data, ignored);
+  archive(ignored);
 
   if (arb_load_str(self.arb_t(), data.c_str())) {
     throw std::logic_error("malformed archive, failed to parse Arb");
@@ -50,24 +264,56 @@ void load(Archive& archive, Arb& self) {
 
 template <typename Archive>
 void save(Archive& archive, const Arf& self) {
-  char* serialized = arf_dump_str(self.arf_t());
-  archive(
-      cereal::make_nvp("data", std::string(serialized)),
-      cereal::make_nvp("approximation", static_cast<double>(self)));
-  flint_free(serialized);
+  if constexpr (cereal::traits::is_text_archive<Archive>::value) {
+    char* serialized = arf_dump_str(self.arf_t());
+    archive(
+        cereal::make_nvp("data", std::string(serialized)),
+        cereal::make_nvp("approximation", static_cast<double>(self)));
+    flint_free(serialized);
+  } else {
+    archive(std::string());
+    detail::save_header(archive);
+    detail::save_arf(archive, self.arf_t());
+  }
 }
 
 template <typename Archive>
 void load(Archive& archive, Arf& self) {
   std::string data;
+  archive(data);
+
+  if constexpr (!cereal::traits::is_text_archive<Archive>::value) {
+    if (data.empty()) {
+      detail::load_header(archive);
+      detail::load_arf(archive, self.arf_t());
+      return;
+    }
+  }
+
   double ignored;
-  archive(data, ignored);
+  archive(ignored);
 
   if (arf_load_str(self.arf_t(), data.c_str())) {
     throw std::logic_error("malformed archive, failed to parse Arf");
   }
 }
 
+// An Acb is written as its real and imaginary part, each in the format of an
+// Arb. The parts are read directly into the element without copying them.
+template <typename Archive>
+void save(Archive& archive, const Acb& self) {
+  archive(
+      cereal::make_nvp("real", self.real()),
+      cereal::make_nvp("imag", self.imag()));
+}
+
+template <typename Archive>
+void load(Archive& archive, Acb& self) {
+  archive(
+      cereal::make_nvp("real", self.real()),
+      cereal::make_nvp("imag", self.imag()));
+}
+
 }  // namespace arbxx
 
 #endif
@@ -0,0 +1,135 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Comparison of many [Arb]() elements at once.
+
+#ifndef LIBARBXX_COMPARE_HPP
+#define LIBARBXX_COMPARE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "arb.hpp"
+#include "forward.hpp"
+
+namespace arbxx {
+
+/// A fixed size sequence of bits, packed into 64-bit words.
+///
+///     #include <arbxx/compare.hpp>
+///
+///     arbxx::Bitmask mask{3};
+///     mask.set(1);
+///     mask[1]
+///     // -> true
+///
+///     mask.count()
+///     // -> 1
+///
+class LIBARBXX_API Bitmask {
+ public:
+  /// Create a mask of `length` bits that are all unset.
+  explicit Bitmask(::arbxx::size length = 0) : length(length), bits(static_cast<size_t>((length + 63) / 64)) {}
+
+  /// Return the number of bits in this mask.
+  ::arbxx::size size() const noexcept { return length; }
+
+  /// Return whether the bit at position `i` is set. No bounds checking is
+  /// performed.
+  bool operator[](::arbxx::size i) const noexcept { return (bits[static_cast<size_t>(i / 64)] >> (i % 64)) & 1; }
+
+  /// Set the bit at position `i`. No bounds checking is performed.
+  void set(::arbxx::size i) noexcept { bits[static_cast<size_t>(i / 64)] |= std::uint64_t(1) << (i % 64); }
+
+  /// Return the number of bits that are set.
+  ::arbxx::size count() const noexcept {
+    ::arbxx::size ret = 0;
+    for (const auto word : bits)
+      ret += __builtin_popcountll(word);
+    return ret;
+  }
+
+  /// Return the positions of the bits that are set in ascending order.
+  ///
+  ///     arbxx::Bitmask mask{128};
+  ///     mask.set(3);
+  ///     mask.set(100);
+  ///     mask.indices()
+  ///     // -> {3, 100}
+  ///
+  std::vector<::arbxx::size> indices() const {
+    std::vector<::arbxx::size> ret;
+    for (size_t w = 0; w < bits.size(); w++)
+      for (auto word = bits[w]; word; word &= word - 1)
+        ret.push_back(static_cast<::arbxx::size>(64 * w + __builtin_ctzll(word)));
+    return ret;
+  }
+
+  /// Return the underlying words; bit `i` is bit `i % 64` of word `i / 64`.
+  const std::uint64_t* words() const noexcept { return bits.data(); }
+
+ private:
+  ::arbxx::size length;
+  std::vector<std::uint64_t> bits;
+};
+
+/// The result of comparing many elements at once with [compare](): for each
+/// element, `lt` is set if it is certainly less than its counterpart, and
+/// `undecided` is set if this cannot be decided from the balls. If neither
+/// is set, the element is certainly not less than its counterpart.
+struct Comparison {
+  Bitmask lt;
+  Bitmask undecided;
+};
+
+/// ==* `compare()` *==
+/// Compare the `length` elements starting at `lhs` to the elements starting
+/// at `rhs` or to the integer `rhs`.
+///
+/// This produces the same results as calling `operator<` for each element
+/// but is faster since most relations are decided by the signs and
+/// exponents of the midpoints and radii alone without looking at any
+/// mantissas.
+///
+///     std::vector<arbxx::Arb> x{arbxx::Arb{1}, arbxx::Arb{mpq_class{1, 3}, 64}, arbxx::Arb{3}};
+///     std::vector<arbxx::Arb> y{arbxx::Arb{2}, arbxx::Arb{mpq_class{1, 3}, 64}, arbxx::Arb{-3}};
+///     auto comparison = arbxx::compare(x, y);
+///     comparison.lt.indices()
+///     // -> {0}
+///
+///     comparison.undecided.indices()
+///     // -> {1}
+///
+/// Typically, the undecided elements are then recomputed with more
+/// precision:
+///
+///     comparison = arbxx::compare(x, 2);
+///     comparison.lt.indices()
+///     // -> {0, 1}
+///
+LIBARBXX_API Comparison compare(const Arb* lhs, const Arb* rhs, ::arbxx::size length);
+LIBARBXX_API Comparison compare(const Arb* lhs, long rhs, ::arbxx::size length);
+LIBARBXX_API Comparison compare(const std::vector<Arb>& lhs, const std::vector<Arb>& rhs);
+LIBARBXX_API Comparison compare(const std::vector<Arb>& lhs, long rhs);
+LIBARBXX_API Comparison compare(const ArbVector& lhs, const ArbVector& rhs);
+LIBARBXX_API Comparison compare(const ArbVector& lhs, long rhs);
+
+}  // namespace arbxx
+
+#endif
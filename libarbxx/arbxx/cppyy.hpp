@@ -25,11 +25,16 @@
 #include <optional>
 #include <sstream>
 
+#include "acb.hpp"
 #include "arb.hpp"
 #include "arf.hpp"
+#include "yap/acb.hpp"
+#include "yap/arb.hpp"
+#include "yap/arf.hpp"
 
 // See https://bitbucket.org/wlav/cppyy/issues/95/lookup-of-friend-operator
 namespace arbxx {
+std::ostream &operator<<(std::ostream &, const arbxx::Acb &);
 std::ostream &operator<<(std::ostream &, const arbxx::Arb &);
 std::ostream &operator<<(std::ostream &, const arbxx::Arf &);
 
@@ -43,6 +48,14 @@ Arb eval(T expression, prec prec) {
   return ret;
 }
 
+template <boost::yap::expr_kind Kind, typename Tuple>
+Acb eval(AcbExpr<Kind, Tuple> expression, prec prec) {
+  Acb ret = std::move(expression)(prec);
+  return ret;
+}
+
+inline Acb eval(Acb value, prec prec) { return value(prec); }
+
 template <typename T>
 Arf eval(T expression, prec prec, Arf::Round round) {
   Arf ret;
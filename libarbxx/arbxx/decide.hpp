@@ -0,0 +1,162 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Decide relations between [Arb]() elements by increasing the working
+/// precision until the relation is decided.
+
+#ifndef LIBARBXX_DECIDE_HPP
+#define LIBARBXX_DECIDE_HPP
+
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// The outcome of a relation that could be decided by [decide]().
+struct Decision {
+  /// Whether the relation holds.
+  bool value;
+
+  /// The precision at which the relation could be decided.
+  prec precision;
+};
+
+/// The largest precision that [decide]() tries by default.
+inline constexpr const prec DECIDE_PRECISION_MAX = 1 << 16;
+
+namespace detail {
+
+// Throw an std::invalid_argument if decide() cannot be run with these
+// precisions.
+LIBARBXX_API void check_decide_precisions(prec start, prec max);
+
+}  // namespace detail
+
+/// Evaluate `relation` at precisions `start`, `2·start`, `4·start`, … until
+/// it returns a value, i.e., until the relation is decided, and return that
+/// value together with the precision at which the relation was decided.
+/// If doubling would exceed `max`, a final attempt is made at `max` itself.
+/// Returns nothing if the relation could not be decided at any precision up
+/// to `max`.
+///
+/// Throws an `std::invalid_argument` unless `1 ≤ start ≤ max`.
+///
+/// The `relation` is a callable taking a precision and returning an
+/// `std::optional<bool>` such as the relations defined on [Arb]().
+///
+///     #include <arbxx/decide.hpp>
+///
+///     mpq_class a{1, 3};
+///     mpq_class b = a + mpq_class{1, mpz_class{1} << 100};
+///     auto decision = arbxx::decide([&](arbxx::prec prec) {
+///       return arbxx::Arb{a, prec} < arbxx::Arb{b, prec};
+///     });
+///     decision->value
+///     // -> true
+///
+///     decision->precision
+///     // -> 128
+///
+/// Since most relations are decided at the initial precision, expensive
+/// computations should be wrapped in an [Approximation]() so that they are
+/// only recomputed when the precision actually increases.
+template <typename Relation>
+std::optional<Decision> decide(Relation&& relation, prec start = ARB_PRECISION_FAST, prec max = DECIDE_PRECISION_MAX) {
+  static_assert(std::is_convertible_v<std::invoke_result_t<Relation&, prec>, std::optional<bool>>, "relation must return an std::optional<bool>");
+
+  detail::check_decide_precisions(start, max);
+
+  prec precision = start;
+  while (true) {
+    const std::optional<bool> value = relation(precision);
+    if (value)
+      return Decision{*value, precision};
+
+    if (precision >= max)
+      return std::nullopt;
+
+    // Doubling must not overflow and must not skip over max.
+    precision = precision > max / 2 ? max : 2 * precision;
+  }
+}
+
+/// A lazily computed approximation of a real number that caches the best
+/// approximation computed so far.
+///
+/// The `approximate` callable takes a precision and returns an [Arb]()
+/// enclosing the number. Requesting the approximation at some precision
+/// only calls `approximate` if no approximation at that precision (or a
+/// higher one) has been computed before and the cached approximation is not
+/// exact.
+///
+///     #include <arbxx/decide.hpp>
+///
+///     int evaluations = 0;
+///     arbxx::Approximation third{[&](arbxx::prec prec) {
+///       evaluations++;
+///       return arbxx::Arb{mpq_class{1, 3}, prec};
+///     }};
+///
+///     third(256);
+///     third(64);
+///     evaluations
+///     // -> 1
+///
+/// Such approximations can then be compared with [decide]():
+///
+///     arbxx::Approximation sixth{[&](arbxx::prec prec) {
+///       return arbxx::Arb{mpq_class{1, 6}, prec};
+///     }};
+///
+///     arbxx::decide([&](arbxx::prec prec) { return sixth(prec) < third(prec); })->value
+///     // -> true
+///
+template <typename Approximate>
+class Approximation {
+ public:
+  explicit Approximation(Approximate approximate) : approximate(std::move(approximate)) {}
+
+  /// Return an approximation of at least precision `prec`, or an exact
+  /// element if one is already known.
+  const Arb& operator()(prec precision) {
+    if (precision > this->precision && !(this->precision && value.is_exact())) {
+      value = approximate(precision);
+      this->precision = precision;
+    }
+    return value;
+  }
+
+ private:
+  Approximate approximate;
+
+  // The precision of the cached value, or zero if nothing has been computed
+  // yet.
+  prec precision = 0;
+  Arb value;
+};
+
+template <typename Approximate>
+Approximation(Approximate) -> Approximation<Approximate>;
+
+}  // namespace arbxx
+
+#endif
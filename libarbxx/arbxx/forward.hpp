@@ -33,11 +33,29 @@ namespace arbxx {
 class Mag;
 class Arf;
 class Arb;
+class ArbVector;
+class ArbRef;
+class ArbCRef;
+class ArfRef;
+class ArfCRef;
+class ArbBatch;
+template <prec Bits>
+class ArbP;
+class HybridArb;
 class Acb;
 class ArbPoly;
 class AcbPoly;
-class ArbMat;
+class ArbMatrix;
 class AcbMat;
+class MappedArbArray;
+class SharedArb;
+class IntervalIndex;
+class Bitmask;
+struct Comparison;
+struct DecimalFormat;
+class DecimalFormatter;
+struct ParseError;
+struct IngestResult;
 
 }  // namespace arbxx
 
@@ -0,0 +1,379 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Intervals of hardware doubles that fall back to [Arb]() when necessary.
+
+#ifndef LIBARBXX_HYBRID_ARB_HPP
+#define LIBARBXX_HYBRID_ARB_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A real number enclosed by an interval of two hardware doubles that
+/// switches to an [Arb]() when doubles are not suitable anymore.
+///
+///     #include <arbxx/hybrid_arb.hpp>
+///
+///     arbxx::HybridArb x{1}, y{3};
+///     auto z = x / y;
+///     z.is_arb()
+///     // -> false
+///
+///     z.is_exact()
+///     // -> false
+///
+/// Arithmetic on intervals of doubles is done in hardware and rounded
+/// outwards using error-free transformations so that the result is the
+/// tightest interval of doubles containing the exact result. This is
+/// usually an order of magnitude faster than the corresponding operation on
+/// `Arb`.
+///
+/// The bounds of the double interval are restricted to modest magnitudes,
+/// namely `0` and `±[2^-MAGNITUDE, 2^MAGNITUDE]`, so that no operation can
+/// overflow or underflow. If a result leaves this range, or when dividing by
+/// an interval that contains zero, the element switches to an `Arb` and
+/// further computations are performed with Arb with a working precision of
+/// `FALLBACK_PRECISION`:
+///
+///     arbxx::HybridArb huge{std::ldexp(1., 400)};
+///     auto w = huge * huge;
+///     w.is_arb()
+///     // -> true
+///
+///     (w / huge / huge).is_arb()
+///     // -> false
+///
+/// Relations are decided like for `Arb`, i.e., they return nothing if the
+/// relation cannot be decided from the enclosures:
+///
+///     *(x < y)
+///     // -> true
+///
+///     (z < z).has_value()
+///     // -> false
+///
+class LIBARBXX_API HybridArb {
+ public:
+  /// The working precision of computations that fall back to `Arb`.
+  static constexpr prec FALLBACK_PRECISION = ARB_PRECISION_FAST;
+
+  /// The binary logarithm of the largest magnitude of a bound of an
+  /// interval of doubles.
+  static constexpr int MAGNITUDE = 480;
+
+  /// Create an exact zero element.
+  ///
+  ///     arbxx::HybridArb x;
+  ///     std::cout << x;
+  ///     // -> 0
+  ///
+  HybridArb() noexcept : lower(0), upper(0) {}
+
+  /// Create an exact element from `x`.
+  ///
+  ///     arbxx::HybridArb x{.5};
+  ///     x.is_exact()
+  ///     // -> true
+  ///
+  explicit HybridArb(double x) : lower(x), upper(x) {
+    if (!representable(x))
+      spill();
+  }
+
+  /// Create an element from the integer `x`. The element is exact if `x` is
+  /// representable as a double.
+  ///
+  ///     arbxx::HybridArb x{1337};
+  ///     std::cout << x;
+  ///     // -> 1337.00
+  ///
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+  explicit HybridArb(T x) : HybridArb() {
+    if constexpr (std::numeric_limits<T>::digits <= std::numeric_limits<double>::digits) {
+      lower = upper = static_cast<double>(x);
+    } else {
+      constexpr T limit = T(1) << std::numeric_limits<double>::digits;
+      if (x <= limit && (std::is_unsigned_v<T> || x >= -limit))
+        lower = upper = static_cast<double>(x);
+      else
+        *this = HybridArb(Arb(x));
+    }
+  }
+
+  /// Create an element enclosing `x`. The element is an interval of doubles
+  /// if `x` is finite and its bounds are of modest magnitude.
+  ///
+  ///     arbxx::Arb x{mpq_class{1, 3}, 256};
+  ///     arbxx::HybridArb y{x};
+  ///     y.is_arb()
+  ///     // -> false
+  ///
+  explicit HybridArb(const Arb& x);
+
+  HybridArb(const HybridArb& x) : lower(x.lower), upper(x.upper), arb(x.arb ? std::make_unique<Arb>(*x.arb) : nullptr) {}
+
+  HybridArb(HybridArb&&) noexcept = default;
+
+  ~HybridArb() noexcept = default;
+
+  /// ==* `operator=(HybridArb)` *==
+  /// Reset this element to the one given.
+  HybridArb& operator=(const HybridArb& x) {
+    if (x.arb)
+      return *this = HybridArb(x);
+    lower = x.lower;
+    upper = x.upper;
+    arb.reset();
+    return *this;
+  }
+
+  HybridArb& operator=(HybridArb&&) noexcept = default;
+
+  /// Return an `Arb` enclosing this element.
+  ///
+  ///     arbxx::HybridArb x{1};
+  ///     std::cout << static_cast<arbxx::Arb>(x);
+  ///     // -> 1.00000
+  ///
+  explicit operator Arb() const;
+
+  /// Return whether this element has fallen back to an `Arb`.
+  bool is_arb() const noexcept { return static_cast<bool>(arb); }
+
+  /// Return whether this element is exact, i.e., a single point.
+  bool is_exact() const noexcept {
+    if (arb)
+      return arb->is_exact();
+    return lower == upper;
+  }
+
+  /// ==* Arithmetic *==
+  /// Arithmetic with other elements; results are enclosed rigorously.
+  ///
+  ///     arbxx::HybridArb x{1}, y{2};
+  ///     std::cout << (x + y) * y;
+  ///     // -> 6.00000
+  ///
+  ///     x -= y;
+  ///     std::cout << x;
+  ///     // -> -1.00000
+  ///
+  HybridArb& operator+=(const HybridArb& rhs) { return *this = *this + rhs; }
+  HybridArb& operator-=(const HybridArb& rhs) { return *this = *this - rhs; }
+  HybridArb& operator*=(const HybridArb& rhs) { return *this = *this * rhs; }
+  HybridArb& operator/=(const HybridArb& rhs) { return *this = *this / rhs; }
+
+  /// Return the negative of this element.
+  HybridArb operator-() const {
+    if (arb)
+      return HybridArb(-*arb);
+    return HybridArb(-upper, -lower);
+  }
+
+  friend HybridArb operator+(const HybridArb& lhs, const HybridArb& rhs) {
+    if (lhs.arb || rhs.arb)
+      return fallback(Operation::ADD, lhs, rhs);
+    return HybridArb(add_down(lhs.lower, rhs.lower), add_up(lhs.upper, rhs.upper));
+  }
+
+  friend HybridArb operator-(const HybridArb& lhs, const HybridArb& rhs) {
+    if (lhs.arb || rhs.arb)
+      return fallback(Operation::SUB, lhs, rhs);
+    return HybridArb(add_down(lhs.lower, -rhs.upper), add_up(lhs.upper, -rhs.lower));
+  }
+
+  friend HybridArb operator*(const HybridArb& lhs, const HybridArb& rhs) {
+    if (lhs.arb || rhs.arb)
+      return fallback(Operation::MUL, lhs, rhs);
+
+    if (lhs.lower >= 0 && rhs.lower >= 0)
+      return HybridArb(mul_down(lhs.lower, rhs.lower), mul_up(lhs.upper, rhs.upper));
+
+    return HybridArb(
+        std::min({mul_down(lhs.lower, rhs.lower), mul_down(lhs.lower, rhs.upper), mul_down(lhs.upper, rhs.lower), mul_down(lhs.upper, rhs.upper)}),
+        std::max({mul_up(lhs.lower, rhs.lower), mul_up(lhs.lower, rhs.upper), mul_up(lhs.upper, rhs.lower), mul_up(lhs.upper, rhs.upper)}));
+  }
+
+  friend HybridArb operator/(const HybridArb& lhs, const HybridArb& rhs) {
+    // Dividing by an interval that contains zero does not produce an
+    // interval of doubles of modest magnitude.
+    if (lhs.arb || rhs.arb || (rhs.lower <= 0 && rhs.upper >= 0))
+      return fallback(Operation::DIV, lhs, rhs);
+
+    if (lhs.lower >= 0 && rhs.lower > 0)
+      return HybridArb(div_down(lhs.lower, rhs.upper), div_up(lhs.upper, rhs.lower));
+
+    return HybridArb(
+        std::min({div_down(lhs.lower, rhs.lower), div_down(lhs.lower, rhs.upper), div_down(lhs.upper, rhs.lower), div_down(lhs.upper, rhs.upper)}),
+        std::max({div_up(lhs.lower, rhs.lower), div_up(lhs.lower, rhs.upper), div_up(lhs.upper, rhs.lower), div_up(lhs.upper, rhs.upper)}));
+  }
+
+  /// ==* Relational Operators *==
+  /// Relations between elements are decided like for `Arb`, i.e., they
+  /// return nothing if the relation cannot be decided from the enclosures.
+  ///
+  ///     arbxx::HybridArb x{1}, y{2}, z{3};
+  ///     *(x <= y)
+  ///     // -> true
+  ///
+  ///     (x / y == x / y).has_value()
+  ///     // -> true
+  ///
+  ///     (x / z == x / z).has_value()
+  ///     // -> false
+  ///
+  friend std::optional<bool> operator==(const HybridArb& lhs, const HybridArb& rhs) {
+    if (lhs.arb || rhs.arb)
+      return static_cast<Arb>(lhs) == static_cast<Arb>(rhs);
+    if (lhs.upper < rhs.lower || rhs.upper < lhs.lower)
+      return false;
+    if (lhs.lower == lhs.upper && rhs.lower == rhs.upper)
+      return true;
+    return std::nullopt;
+  }
+
+  friend std::optional<bool> operator!=(const HybridArb& lhs, const HybridArb& rhs) {
+    const auto eq = lhs == rhs;
+    if (!eq)
+      return std::nullopt;
+    return !*eq;
+  }
+
+  friend std::optional<bool> operator<(const HybridArb& lhs, const HybridArb& rhs) {
+    if (lhs.arb || rhs.arb)
+      return static_cast<Arb>(lhs) < static_cast<Arb>(rhs);
+    if (lhs.upper < rhs.lower)
+      return true;
+    if (lhs.lower >= rhs.upper)
+      return false;
+    return std::nullopt;
+  }
+
+  friend std::optional<bool> operator<=(const HybridArb& lhs, const HybridArb& rhs) {
+    if (lhs.arb || rhs.arb)
+      return static_cast<Arb>(lhs) <= static_cast<Arb>(rhs);
+    if (lhs.upper <= rhs.lower)
+      return true;
+    if (lhs.lower > rhs.upper)
+      return false;
+    return std::nullopt;
+  }
+
+  friend std::optional<bool> operator>(const HybridArb& lhs, const HybridArb& rhs) { return rhs < lhs; }
+
+  friend std::optional<bool> operator>=(const HybridArb& lhs, const HybridArb& rhs) { return rhs <= lhs; }
+
+  /// Write this element to the output stream.
+  LIBARBXX_API friend std::ostream& operator<<(std::ostream&, const HybridArb&);
+
+ private:
+  enum class Operation {
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+  };
+
+  // Create the interval [lower, upper] which must enclose the exact result
+  // of an operation; falls back to an Arb if the bounds are not of modest
+  // magnitude.
+  HybridArb(double lower, double upper) : lower(lower), upper(upper) {
+    if (!representable(lower) || !representable(upper))
+      spill();
+  }
+
+  // Return whether x can be a bound of an interval of doubles, i.e., whether
+  // it is zero or of magnitude in [2^-MAGNITUDE, 2^MAGNITUDE].
+  static bool representable(double x) noexcept {
+    static_assert(MAGNITUDE == 480, "bounds below must be updated when changing MAGNITUDE");
+    const double magnitude = std::abs(x);
+    return x == 0 || (magnitude >= 0x1p-480 && magnitude <= 0x1p480);
+  }
+
+  // Replace the interval [lower, upper] with an Arb enclosing it.
+  void spill();
+
+  // Perform the operation with Arb.
+  static HybridArb fallback(Operation, const HybridArb& lhs, const HybridArb& rhs);
+
+  // The largest double that is ≤ x + error and the smallest double that is
+  // ≥ x + error where error is the (exact) rounding error of x.
+  static double round_down(double x, double error) noexcept { return error < 0 ? std::nextafter(x, -HUGE_VAL) : x; }
+  static double round_up(double x, double error) noexcept { return error > 0 ? std::nextafter(x, HUGE_VAL) : x; }
+
+  // Directed rounding of a + b based on Knuth's TwoSum, which computes the
+  // rounding error of a + b exactly.
+  static double add_error(double a, double b, double sum) noexcept {
+    const double b_ = sum - a;
+    return (a - (sum - b_)) + (b - b_);
+  }
+  static double add_down(double a, double b) noexcept {
+    const double sum = a + b;
+    return round_down(sum, add_error(a, b, sum));
+  }
+  static double add_up(double a, double b) noexcept {
+    const double sum = a + b;
+    return round_up(sum, add_error(a, b, sum));
+  }
+
+  // Directed rounding of a * b; the rounding error of the product is
+  // computed exactly with a fused multiply add. Since the operands are of
+  // modest magnitude, this error does not underflow.
+  static double mul_down(double a, double b) noexcept {
+    const double product = a * b;
+    return round_down(product, std::fma(a, b, -product));
+  }
+  static double mul_up(double a, double b) noexcept {
+    const double product = a * b;
+    return round_up(product, std::fma(a, b, -product));
+  }
+
+  // Directed rounding of a / b; the remainder a - q * b is computed exactly
+  // with a fused multiply add and a / b - q has the sign of remainder / b.
+  static double div_down(double a, double b) noexcept {
+    const double quotient = a / b;
+    const double remainder = std::fma(-quotient, b, a);
+    return round_down(quotient, b > 0 ? remainder : -remainder);
+  }
+  static double div_up(double a, double b) noexcept {
+    const double quotient = a / b;
+    const double remainder = std::fma(-quotient, b, a);
+    return round_up(quotient, b > 0 ? remainder : -remainder);
+  }
+
+  // The interval [lower, upper] enclosing this element unless arb is set.
+  double lower, upper;
+
+  // The enclosure of this element if it could not be represented as an
+  // interval of doubles.
+  std::unique_ptr<Arb> arb;
+};
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,130 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Ordering of [Arb]() elements by their lower endpoints and lookup of the
+/// balls that overlap a value.
+
+#ifndef LIBARBXX_INTERVAL_INDEX_HPP
+#define LIBARBXX_INTERVAL_INDEX_HPP
+
+#include <vector>
+
+#include "arb.hpp"
+#include "arf.hpp"
+#include "forward.hpp"
+
+namespace arbxx {
+
+/// ==* `interval_sort()` *==
+/// Sort the `length` elements starting at `x` by their lower endpoints and
+/// elements with the same lower endpoint by their upper endpoints.
+///
+/// Unlike `operator<`, this is a strict weak order so it can be used to sort
+/// balls that overlap. Return the permutation that has been applied, i.e.,
+/// the element at position `i` after sorting was at position `ret[i]`
+/// before.
+///
+///     #include <arbxx/interval_index.hpp>
+///
+///     std::vector<arbxx::Arb> x{arbxx::Arb{3}, arbxx::Arb{std::pair{arbxx::Arf{1}, arbxx::Arf{4}}}, arbxx::Arb{2}};
+///     arbxx::interval_sort(x)
+///     // -> {1, 2, 0}
+///
+/// Endpoints are computed with [arb_get_interval_arf]() and rounded outwards
+/// if they need many more bits than the midpoint of the ball. Balls with a NaN midpoint are treated like
+/// the whole real line.
+LIBARBXX_API std::vector<::arbxx::size> interval_sort(Arb* x, ::arbxx::size length);
+LIBARBXX_API std::vector<::arbxx::size> interval_sort(std::vector<Arb>& x);
+
+/// ==* `interval_clusters()` *==
+/// Return the clusters of balls that overlap in the `length` elements
+/// starting at `x` which must be sorted with [interval_sort]().
+///
+/// The clusters are consecutive ranges `[ret[i], ret[i + 1])`, i.e., the
+/// last entry of the returned vector is `length`. Each cluster is a
+/// connected component of the overlap relation, so every ball in one
+/// cluster is certainly less than every ball of a later cluster.
+///
+///     std::vector<arbxx::Arb> x{arbxx::Arb{0}, arbxx::Arb{std::pair{arbxx::Arf{1}, arbxx::Arf{2}}}, arbxx::Arb{2}};
+///     arbxx::interval_clusters(x)
+///     // -> {0, 1, 3}
+///
+/// This takes linear time so sorting and clustering takes `O(n log n)`.
+LIBARBXX_API std::vector<::arbxx::size> interval_clusters(const Arb* x, ::arbxx::size length);
+LIBARBXX_API std::vector<::arbxx::size> interval_clusters(const std::vector<Arb>& x);
+
+/// An index over the endpoints of a fixed collection of balls that finds
+/// the balls which overlap a value in logarithmic time.
+///
+/// The index is an interval tree over the endpoints of the balls; it does not
+/// reference the balls themselves after it has been built.
+///
+///     std::vector<arbxx::Arb> x{arbxx::Arb{std::pair{arbxx::Arf{0}, arbxx::Arf{2}}}, arbxx::Arb{std::pair{arbxx::Arf{1}, arbxx::Arf{3}}}, arbxx::Arb{5}};
+///     arbxx::IntervalIndex index{x};
+///     index.containing(arbxx::Arf{1})
+///     // -> {0, 1}
+///
+///     index.overlapping(arbxx::Arb{std::pair{arbxx::Arf{4}, arbxx::Arf{6}}})
+///     // -> {2}
+///
+class LIBARBXX_API IntervalIndex {
+ public:
+  /// Create an index that contains no balls.
+  IntervalIndex() noexcept;
+
+  /// ==* `IntervalIndex(const Arb*, size)` *==
+  /// Create an index over the `length` balls starting at `x`. This takes
+  /// `O(n log n)` time.
+  IntervalIndex(const Arb* x, ::arbxx::size length);
+  explicit IntervalIndex(const std::vector<Arb>& x);
+
+  /// Return the number of balls in this index.
+  ::arbxx::size size() const noexcept;
+
+  /// Return the indices of the balls that contain `x`, ordered by their lower
+  /// endpoints. This takes `O((k + 1) log n)` time where `k` is the number of
+  /// balls returned.
+  std::vector<::arbxx::size> containing(const Arf& x) const;
+
+  /// Return the indices of the balls that overlap `y`, ordered by their lower
+  /// endpoints. These are the balls that may contain the number described by
+  /// `y`. This takes `O((k + 1) log n)` time where `k` is the number of balls
+  /// returned.
+  std::vector<::arbxx::size> overlapping(const Arb& y) const;
+
+ private:
+  // Add the balls in the subtree of the positions [begin, end) that overlap
+  // [lower, upper] to indices.
+  void query(::arbxx::size begin, ::arbxx::size end, const Arf& lower, const Arf& upper, std::vector<::arbxx::size>& indices) const;
+
+  // The endpoints of the balls ordered by their lower endpoints and the
+  // position of each ball in the original collection.
+  std::vector<Arf> lower;
+  std::vector<Arf> upper;
+  std::vector<::arbxx::size> indices;
+
+  // The balls form an implicit binary search tree where the root of the
+  // subtree of positions [begin, end) is at (begin + end) / 2. This is the
+  // largest upper endpoint in the subtree rooted at each position.
+  std::vector<Arf> maximum;
+};
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,125 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// A read-only array of [Arb]() elements that are memory-mapped from a file.
+
+#ifndef LIBARBXX_MAPPED_ARB_ARRAY_HPP
+#define LIBARBXX_MAPPED_ARB_ARRAY_HPP
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "arb.hpp"
+#include "forward.hpp"
+
+namespace arbxx {
+
+/// A read-only array of [Arb]() elements backed by a memory-mapped file, so
+/// that large arrays can be opened without reading or deserializing them.
+///
+/// Files are created with [write]():
+///
+///     #include <arbxx/mapped_arb_array.hpp>
+///
+///     auto path = std::filesystem::temp_directory_path() / "arbxx-doc.arbs";
+///     arbxx::MappedArbArray::write(path, std::vector{arbxx::Arb{1}, arbxx::Arb{mpq_class{1, 3}, 256}});
+///
+///     arbxx::MappedArbArray array{path};
+///     array.size()
+///     // -> 2
+///
+///     std::cout << array[0];
+///     // -> 1.00000
+///
+///     array[1].equal(arbxx::Arb{mpq_class{1, 3}, 256})
+///     // -> true
+///
+/// The file starts with a header of 64 bytes:
+///
+/// * the magic bytes `ARBXXMAP`,
+/// * a 32 bit version of the format, currently 1,
+/// * the 32 bit integer 0x01020304 to detect the byte order,
+/// * the 32 bit number of bits in a limb, i.e., `FLINT_BITS`,
+/// * the 32 bit size of an `arb_struct` in bytes,
+/// * the 64 bit number of elements,
+/// * and zeros up to the end of the header.
+///
+/// The header is followed by one `arb_struct` for each element, exactly as
+/// they are laid out in memory. Mantissas of up to two limbs and exponents
+/// that fit into an `fmpz` are stored inline in an `arb_struct`, so such
+/// elements are used directly from the mapped memory without any copying.
+///
+/// When a mantissa has more limbs, its pointer is replaced by the offset of
+/// its limbs in the file. When an exponent does not fit into an `fmpz`, it is
+/// replaced by its offset in the file, shifted and tagged in the same way as
+/// a pointer in an `fmpz`; there, the exponent is stored as a 64 bit signed
+/// number of limbs, followed by its limbs. These limbs and exponents follow
+/// the last `arb_struct` in the file. When such an element is first
+/// accessed, a shallow copy of its `arb_struct` that points into the mapped
+/// memory is created and kept until the array is destroyed.
+///
+/// Since the file is not converted in any way, it can only be read on
+/// platforms with the same byte order, limb size, and `arb_struct` layout.
+///
+/// All methods of this class can be called concurrently from several
+/// threads. Accessing elements does not take any locks.
+class LIBARBXX_API MappedArbArray {
+ public:
+  using value_type = Arb;
+
+  /// Map the file at `path` into memory. The file is not read, only its
+  /// header is checked.
+  explicit MappedArbArray(const std::filesystem::path& path);
+
+  MappedArbArray(const MappedArbArray&) = delete;
+  MappedArbArray(MappedArbArray&&) noexcept;
+
+  ~MappedArbArray() noexcept;
+
+  MappedArbArray& operator=(const MappedArbArray&) = delete;
+  MappedArbArray& operator=(MappedArbArray&&) noexcept;
+
+  /// Write `values` to the file at `path` so that it can be mapped with a
+  /// [MappedArbArray]().
+  static void write(const std::filesystem::path& path, const std::vector<Arb>& values);
+  static void write(const std::filesystem::path& path, const ArbVector& values);
+
+  /// Return the number of elements in this array.
+  ::arbxx::size size() const noexcept;
+
+  /// Return whether this array has no elements.
+  bool empty() const noexcept;
+
+  /// Return a read-only reference to the `i`-th element. No bounds checking
+  /// is performed.
+  ///
+  /// The reference points into the mapped memory and stays valid until the
+  /// array is destroyed. To modify the element, make a copy of it.
+  const Arb& operator[](::arbxx::size i) const;
+
+ private:
+  struct Implementation;
+
+  std::unique_ptr<Implementation> impl;
+};
+
+}  // namespace arbxx
+
+#endif
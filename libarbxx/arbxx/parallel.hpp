@@ -0,0 +1,74 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Reductions of many [Arb]() elements that use several threads.
+
+#ifndef LIBARBXX_PARALLEL_HPP
+#define LIBARBXX_PARALLEL_HPP
+
+#include <vector>
+
+#include "arb.hpp"
+#include "forward.hpp"
+
+namespace arbxx::parallel {
+
+/// ==* `sum()` *==
+/// Return the sum of the `length` elements starting at `x` computed with
+/// working precision `prec`.
+///
+/// The elements are split into chunks of fixed size which are summed with
+/// [arb_dot]() on the threads made available by the [ThreadScope](). The
+/// partial sums are then combined in a fixed tree order. So, the result is
+/// the same, bit for bit, regardless of the number of threads.
+///
+///     #include <arbxx/parallel.hpp>
+///     #include <arbxx/threads.hpp>
+///
+///     std::vector<arbxx::Arb> x(100000, arbxx::Arb{mpq_class{1, 3}, 64});
+///
+///     auto serial = arbxx::parallel::sum(x, 64);
+///
+///     arbxx::ThreadScope scope{4};
+///     serial.equal(arbxx::parallel::sum(x, 64))
+///     // -> true
+///
+LIBARBXX_API Arb sum(const Arb* x, ::arbxx::size length, prec);
+LIBARBXX_API Arb sum(const std::vector<Arb>& x, prec);
+LIBARBXX_API Arb sum(const ArbVector& x, prec);
+
+/// ==* `dot()` *==
+/// Return the dot product of the `length` elements starting at `x` and `y`
+/// computed with working precision `prec`.
+///
+/// Like [sum](), this is computed in chunks on several threads and the
+/// result does not depend on the number of threads.
+///
+///     std::vector<arbxx::Arb> x{arbxx::Arb{1}, arbxx::Arb{2}};
+///     std::vector<arbxx::Arb> y{arbxx::Arb{3}, arbxx::Arb{4}};
+///     std::cout << arbxx::parallel::dot(x, y, 64);
+///     // -> 11.0000
+///
+LIBARBXX_API Arb dot(const Arb* x, const Arb* y, ::arbxx::size length, prec);
+LIBARBXX_API Arb dot(const std::vector<Arb>& x, const std::vector<Arb>& y, prec);
+LIBARBXX_API Arb dot(const ArbVector& x, const ArbVector& y, prec);
+
+}  // namespace arbxx::parallel
+
+#endif
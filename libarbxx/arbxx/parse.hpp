@@ -0,0 +1,127 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Parsing of [Arb]() elements from decimal strings and from large buffers
+/// of such strings.
+
+#ifndef LIBARBXX_PARSE_HPP
+#define LIBARBXX_PARSE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "forward.hpp"
+
+namespace arbxx {
+
+/// ==* `parse(Arb&, std::string_view, prec)` *==
+/// Set `x` to the value described by `value` and return whether `value` could
+/// be parsed.
+///
+/// Plain decimal numbers such as `-1.25e-3` are parsed directly from
+/// `value`; other strings, such as balls `[1 +/- 0.1]`, `inf`, or `nan`, are
+/// parsed by [arb_set_str](). Surrounding whitespace is ignored.
+///
+///     #include <arbxx/parse.hpp>
+///
+///     arbxx::Arb x;
+///     arbxx::parse(x, " 0.125 ", 64)
+///     // -> true
+///
+///     std::cout << x;
+///     // -> 0.125000
+///
+/// If `value` cannot be parsed, `x` is set to an indeterminate element.
+///
+///     arbxx::parse(x, "1/3", 64)
+///     // -> false
+///
+LIBARBXX_API bool parse(Arb& x, std::string_view value, prec);
+
+/// Return the element described by `value`, see [parse(Arb&,
+/// std::string_view, prec)]().
+///
+///     std::cout << arbxx::parse("[3.25 +/- 0.0001]", 64);
+///     // -> [3.25000 +/- 1.01e-4]
+///
+/// Throws a `std::invalid_argument` if `value` cannot be parsed.
+LIBARBXX_API Arb parse(std::string_view value, prec);
+
+/// A field that could not be parsed by [ingest]().
+struct ParseError {
+  /// The index of the field, i.e., the index of the element that could not be
+  /// set.
+  ::arbxx::size index;
+
+  /// The offset of the first character of the field in the input buffer.
+  std::size_t offset;
+};
+
+/// The outcome of a call to [ingest]() or [ingest_file]().
+struct IngestResult {
+  /// The number of fields that have been found in the input.
+  ::arbxx::size count = 0;
+
+  /// The fields that could not be parsed ordered by their index.
+  std::vector<ParseError> errors;
+};
+
+/// ==* `ingest(Arb*, size, std::string_view, prec)` *==
+/// Parse the fields of `buffer` into consecutive elements starting at `out`.
+///
+/// Fields are separated by newlines or commas and parsed with [parse(Arb&,
+/// std::string_view, prec)](). A trailing separator, e.g., the final newline
+/// of a file, does not start another field. The buffer is split into chunks
+/// that are parsed concurrently on the threads made available by a
+/// [ThreadScope]().
+///
+///     std::vector<arbxx::Arb> x(3);
+///     auto result = arbxx::ingest(x.data(), x.size(), "1.5,2\nx\n", 64);
+///     result.count
+///     // -> 3
+///
+///     result.errors[0].index
+///     // -> 2
+///
+///     result.errors[0].offset
+///     // -> 6
+///
+/// Elements corresponding to fields that could not be parsed are set to an
+/// indeterminate element. Throws a `std::invalid_argument` if `buffer`
+/// contains more than `capacity` fields; in this case no element is
+/// modified.
+LIBARBXX_API IngestResult ingest(Arb* out, ::arbxx::size capacity, std::string_view buffer, prec);
+
+/// Parse the fields of `buffer` into `out` which is resized to the number of
+/// fields, see [ingest(Arb*, size, std::string_view, prec)]().
+LIBARBXX_API IngestResult ingest(std::vector<Arb>& out, std::string_view buffer, prec);
+
+/// Parse the fields of the file at `path` into `out` which is resized to the
+/// number of fields, see [ingest(Arb*, size, std::string_view, prec)](). The
+/// file is mapped into memory and not copied. The offsets of errors are
+/// offsets in the file.
+///
+/// Throws a `std::system_error` if the file cannot be read.
+LIBARBXX_API IngestResult ingest_file(std::vector<Arb>& out, const std::filesystem::path& path, prec);
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,93 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// The working precision used by operations that cannot take a precision
+/// argument, such as `x += y`.
+
+#ifndef LIBARBXX_PRECISION_HPP
+#define LIBARBXX_PRECISION_HPP
+
+#include "arb.hpp"
+#include "arf.hpp"
+
+namespace arbxx {
+
+/// Sets the working precision and rounding mode of the current thread for
+/// the lifetime of this object.
+///
+/// In-place operators such as `+=` on [Arb]() and [Arf]() cannot take a
+/// precision as a parameter so they use the precision (and for `Arf` the
+/// rounding mode) of the innermost scope that is alive in the current
+/// thread. When no scope is alive, they use [ARB_PRECISION_FAST]() and
+/// round to nearest.
+///
+///     #include <arbxx/precision.hpp>
+///
+///     arbxx::Arb x{1};
+///     {
+///       arbxx::PrecisionScope scope{256};
+///       x /= 3;
+///     }
+///     std::cout << std::setprecision(32) << x;
+///     // -> [0.33333333333333333333333333333333 +/- 3.34e-33]
+///
+/// Scopes can be nested; when a scope is destroyed, the precision of the
+/// enclosing scope is restored. The state is thread local, so each thread
+/// has its own independent stack of scopes and threads do not contend on
+/// any shared state.
+class LIBARBXX_API PrecisionScope {
+ public:
+  /// Set the working precision of this thread to `precision` and the
+  /// rounding mode to `round` until this object is destroyed.
+  explicit PrecisionScope(prec precision, Arf::Round round = Arf::Round::NEAR) noexcept;
+
+  PrecisionScope(const PrecisionScope&) = delete;
+  PrecisionScope& operator=(const PrecisionScope&) = delete;
+
+  /// Restore the precision and rounding mode that was active when this scope
+  /// was created.
+  ~PrecisionScope() noexcept;
+
+  /// Return the working precision of the current thread.
+  ///
+  ///     arbxx::PrecisionScope::precision()
+  ///     // -> 64
+  ///
+  ///     arbxx::PrecisionScope scope{256};
+  ///     arbxx::PrecisionScope::precision()
+  ///     // -> 256
+  ///
+  static prec precision() noexcept;
+
+  /// Return the rounding mode of the current thread.
+  ///
+  ///     arbxx::PrecisionScope scope{256, arbxx::Arf::Round::DOWN};
+  ///     arbxx::PrecisionScope::round() == arbxx::Arf::Round::DOWN
+  ///     // -> true
+  ///
+  static Arf::Round round() noexcept;
+
+ private:
+  prec previous_precision;
+  Arf::Round previous_round;
+};
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,158 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// An [Arb]() whose limbs are shared between copies.
+
+#ifndef LIBARBXX_SHARED_ARB_HPP
+#define LIBARBXX_SHARED_ARB_HPP
+
+#include <iosfwd>
+#include <memory>
+#include <optional>
+
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// An [Arb]() with value semantics whose copies share the same storage until
+/// one of them is modified.
+///
+/// Copying an `Arb` copies all its limbs which is expensive at very high
+/// precision. Copying a `SharedArb` only increments a reference count:
+///
+///     #include <arbxx/shared_arb.hpp>
+///
+///     arbxx::SharedArb x{arbxx::Arb{mpq_class{1, 3}, 65536}};
+///     auto y = x;
+///     y.shared()
+///     // -> true
+///
+/// Modifications through [mutate]() only affect the element that is being
+/// modified; if the storage is shared, it is copied first:
+///
+///     y.mutate() = 1;
+///     std::cout << y;
+///     // -> 1.00000
+///
+///     x.shared()
+///     // -> false
+///
+/// Copies of the same `SharedArb` can be read concurrently from several
+/// threads, including while other threads create or destroy copies.
+class LIBARBXX_API SharedArb {
+ public:
+  /// Create an exact zero element.
+  ///
+  ///     arbxx::SharedArb x;
+  ///     std::cout << x;
+  ///     // -> 0
+  ///
+  SharedArb();
+
+  /// ==* `SharedArb(Arb)` *==
+  /// Create an element from `x`. If `x` is an rvalue, its limbs are moved
+  /// into the shared storage without copying them.
+  ///
+  ///     arbxx::Arb x{1};
+  ///     arbxx::SharedArb y{std::move(x)};
+  ///     std::cout << y;
+  ///     // -> 1.00000
+  ///
+  explicit SharedArb(const Arb& x);
+  explicit SharedArb(Arb&& x);
+
+  /// ==* Copy and Move *==
+  /// Copies share the storage of the original element.
+  ///
+  ///     arbxx::SharedArb x{arbxx::Arb{1}};
+  ///     arbxx::SharedArb y{x};
+  ///     &*x == &*y
+  ///     // -> true
+  ///
+  /// Note that there are no separate move operations; a move is a copy so
+  /// that moved-from elements remain valid.
+  SharedArb(const SharedArb&) noexcept = default;
+  SharedArb& operator=(const SharedArb&) noexcept = default;
+
+  ~SharedArb() noexcept = default;
+
+  /// ==* `operator*()`, `operator->()` *==
+  /// Return the underlying element for reading.
+  ///
+  ///     arbxx::SharedArb x{arbxx::Arb{1}};
+  ///     x->is_exact()
+  ///     // -> true
+  ///
+  const Arb& operator*() const noexcept { return *value; }
+  const Arb* operator->() const noexcept { return value.get(); }
+
+  /// Return the underlying element, see `operator*()`.
+  operator const Arb&() const noexcept { return *value; }
+
+  /// Return a reference to the underlying [arb_t]() for reading with the C
+  /// API of Arb.
+  const ::arb_t& arb_t() const noexcept { return value->arb_t(); }
+
+  /// Return a reference to the underlying element for modification. If the
+  /// storage is shared with other copies, it is copied first.
+  ///
+  ///     arbxx::SharedArb x{arbxx::Arb{1}};
+  ///     auto y = x;
+  ///     y.mutate() = 2;
+  ///     std::cout << x << ", " << y;
+  ///     // -> 1.00000, 2.00000
+  ///
+  /// The returned reference is invalidated when this element is copied from.
+  Arb& mutate();
+
+  /// Return whether the storage of this element is shared with other copies.
+  bool shared() const noexcept { return value.use_count() > 1; }
+
+  /// ==* Comparison Operators *==
+  /// Relations between elements, see the corresponding operators of [Arb]().
+  ///
+  ///     arbxx::SharedArb x{arbxx::Arb{1}}, y{arbxx::Arb{2}};
+  ///     *(x < y)
+  ///     // -> true
+  ///
+  friend std::optional<bool> operator==(const SharedArb& lhs, const SharedArb& rhs) { return *lhs == *rhs; }
+  friend std::optional<bool> operator!=(const SharedArb& lhs, const SharedArb& rhs) { return *lhs != *rhs; }
+  friend std::optional<bool> operator<(const SharedArb& lhs, const SharedArb& rhs) { return *lhs < *rhs; }
+  friend std::optional<bool> operator>(const SharedArb& lhs, const SharedArb& rhs) { return *lhs > *rhs; }
+  friend std::optional<bool> operator<=(const SharedArb& lhs, const SharedArb& rhs) { return *lhs <= *rhs; }
+  friend std::optional<bool> operator>=(const SharedArb& lhs, const SharedArb& rhs) { return *lhs >= *rhs; }
+
+  /// Return whether this element has the same midpoint and radius as
+  /// `rhs`, see [Arb::equal]().
+  bool equal(const SharedArb& rhs) const { return value == rhs.value || value->equal(*rhs.value); }
+
+  /// Write this element to the output stream.
+  LIBARBXX_API friend std::ostream& operator<<(std::ostream&, const SharedArb&);
+
+  /// Swap two elements without copying any limbs.
+  friend void swap(SharedArb& lhs, SharedArb& rhs) noexcept { lhs.value.swap(rhs.value); }
+
+ private:
+  // The shared storage; never null.
+  std::shared_ptr<Arb> value;
+};
+
+}  // namespace arbxx
+
+#endif
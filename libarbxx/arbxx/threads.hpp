@@ -0,0 +1,81 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// The number of threads that Arb may use for a single operation.
+
+#ifndef LIBARBXX_THREADS_HPP
+#define LIBARBXX_THREADS_HPP
+
+#include "local.hpp"
+
+namespace arbxx {
+
+/// Sets the number of threads that Arb may use in operations called from the
+/// current thread for the lifetime of this object, see
+/// [flint_reset_num_workers]().
+///
+/// Some operations, such as the multiplication of large [ArbMatrix]()
+/// elements, can distribute their work over several threads. By default,
+/// Arb does not use any additional threads.
+///
+///     #include <arbxx/threads.hpp>
+///
+///     arbxx::ThreadScope::threads()
+///     // -> 1
+///
+///     {
+///       arbxx::ThreadScope scope{4};
+///       arbxx::ThreadScope::threads()
+///       // -> 4
+///     }
+///
+///     arbxx::ThreadScope::threads()
+///     // -> 1
+///
+/// Like the [PrecisionScope](), the thread count is thread local and scopes
+/// can be nested. The threads themselves come from FLINT's global thread
+/// pool which is shared by all threads. When the first scope is created,
+/// that pool is created with one thread per core (unless FLINT created it
+/// already); scopes never resize it, so they can be used from several
+/// threads concurrently. Operations use fewer threads than allowed when
+/// the pool is exhausted by other threads.
+class LIBARBXX_API ThreadScope {
+ public:
+  /// Allow Arb to use up to `threads` threads (including the current
+  /// thread) until this object is destroyed.
+  explicit ThreadScope(int threads);
+
+  ThreadScope(const ThreadScope&) = delete;
+  ThreadScope& operator=(const ThreadScope&) = delete;
+
+  /// Restore the number of threads that was active when this scope was
+  /// created.
+  ~ThreadScope() noexcept;
+
+  /// Return the number of threads that Arb may use in the current thread,
+  /// see [flint_get_num_threads]().
+  static int threads() noexcept;
+
+ private:
+  int previous_threads;
+};
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,154 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Decimal representations of [Arb]() and [Arf]() elements written to
+/// caller provided buffers.
+
+#ifndef LIBARBXX_TO_CHARS_HPP
+#define LIBARBXX_TO_CHARS_HPP
+
+#include <arb.h>
+
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include "forward.hpp"
+
+namespace arbxx {
+
+/// The shape of a decimal representation produced by [to_chars]().
+struct DecimalFormat {
+  /// The number of significant digits of the midpoint.
+  int digits = 6;
+
+  /// The number of significant digits of the radius. If zero, the radius is
+  /// not written, only the rounded midpoint.
+  int radius_digits = 3;
+};
+
+/// Writes decimal representations of many elements reusing its internal
+/// buffers, so that no memory is allocated once these buffers have grown to
+/// the size needed.
+///
+/// A ball is written as `[m +/- r]` where `m` is its midpoint rounded to
+/// the configured number of digits and `r` is rounded up so that the ball
+/// `[m +/- r]` contains the original ball. Exact elements are written
+/// without a radius:
+///
+///     #include <arbxx/to_chars.hpp>
+///
+///     arbxx::DecimalFormatter formatter;
+///     formatter.format(arbxx::Arb{mpq_class{1, 3}, 64})
+///     // -> "[0.333333 +/- 3.34e-7]"
+///
+///     formatter.format(arbxx::Arb{1337})
+///     // -> "1337.00"
+///
+/// Note that while the representation is similar to the one produced by
+/// `operator<<`, it is not identical.
+class LIBARBXX_API DecimalFormatter {
+ public:
+  explicit DecimalFormatter(DecimalFormat format = {});
+
+  DecimalFormatter(const DecimalFormatter&) = delete;
+  DecimalFormatter& operator=(const DecimalFormatter&) = delete;
+
+  ~DecimalFormatter() noexcept;
+
+  /// ==* `to_chars()` *==
+  /// Write the decimal representation of `x` to the buffer `[first, last)`
+  /// without a trailing NUL character. Like `std::to_chars`, this returns a
+  /// pointer past the last character written or `std::errc::value_too_large`
+  /// if the buffer is too small.
+  ///
+  ///     char buffer[32];
+  ///     arbxx::DecimalFormatter formatter{{3, 2}};
+  ///     auto [end, ec] = formatter.to_chars(buffer, buffer + sizeof(buffer), arbxx::Arb{mpq_class{2, 3}, 64});
+  ///     std::string(buffer, end)
+  ///     // -> "[0.667 +/- 0.00034]"
+  ///
+  /// An [Arf]() is written as its value rounded to the configured number of
+  /// digits.
+  std::to_chars_result to_chars(char* first, char* last, const Arb& x);
+  std::to_chars_result to_chars(char* first, char* last, const Arf& x);
+
+  /// Return the decimal representation of `x`. The result is only valid
+  /// until this formatter is used again.
+  std::string_view format(const Arb& x);
+  std::string_view format(const Arf& x);
+
+  /// Append the decimal representations of the `length` elements starting
+  /// at `x` to `out`, each followed by `separator`.
+  ///
+  ///     std::vector<arbxx::Arb> x{arbxx::Arb{1}, arbxx::Arb{2}};
+  ///     std::string out;
+  ///     arbxx::DecimalFormatter{}.append(out, x.data(), x.size(), ',');
+  ///     out
+  ///     // -> "1.00000,2.00000,"
+  ///
+  void append(std::string& out, const Arb* x, ::arbxx::size length, char separator = '\n');
+
+ private:
+  // Append the representation of x to buffer; omit the radius if radius is
+  // false.
+  void write(arb_srcptr x, bool radius);
+
+  // Round the midpoint of x to digits significant decimal digits, i.e.,
+  // set integer such that integer·10^(e - digits + 1) approximates x and
+  // return e. Sets error to a bound for the distance of x to this
+  // approximation in units of 10^(e - digits + 1).
+  slong round(arb_srcptr x, int digits);
+
+  // Append a decimal upper bound with digits significant digits for
+  // r·10^unit.
+  void write_upper(const mag_t r, slong unit, int digits);
+
+  // Append integer·10^(e - digits + 1) where integer has exactly digits
+  // digits.
+  void write_decimal(slong e, int digits);
+
+  DecimalFormat options;
+
+  std::string buffer;
+  std::string scratch;
+
+  arb_t scaled;
+  arb_t power;
+  arf_t bound;
+  mag_t error;
+  fmpz_t integer;
+  fmpz_t lower;
+  fmpz_t upper;
+};
+
+/// Write the decimal representation of `x` to `[first, last)`, see
+/// [DecimalFormatter::to_chars]().
+///
+///     char buffer[32];
+///     auto [end, ec] = arbxx::to_chars(buffer, buffer + sizeof(buffer), arbxx::Arb{-2});
+///     std::string(buffer, end)
+///     // -> "-2.00000"
+///
+LIBARBXX_API std::to_chars_result to_chars(char* first, char* last, const Arb& x, DecimalFormat format = {});
+LIBARBXX_API std::to_chars_result to_chars(char* first, char* last, const Arf& x, DecimalFormat format = {});
+
+}  // namespace arbxx
+
+#endif
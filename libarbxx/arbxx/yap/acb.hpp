@@ -0,0 +1,351 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+/// Arithmetic on [Acb]() with expression templates powered by Boost.Yap.
+///
+/// This works exactly like the arithmetic on [Arb](), see yap/arb.hpp.
+/// Operators build an expression which is evaluated once a precision is
+/// supplied:
+///
+///     #include <arbxx/yap/acb.hpp>
+///
+///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{1}}, y{2};
+///     std::cout << (x * x + y)(64);
+///     // -> 2.00000 + 2.00000*I
+///
+/// Expressions may mix `Acb` with `Arb` elements and integers. Real
+/// operands are passed to [acb_add_arb](), [acb_mul_si]() and friends
+/// directly, i.e., they are never promoted to an `Acb`. Subexpressions of
+/// the shape `a ± b * c` are mapped to [acb_addmul]() and [acb_submul]().
+///
+/// Note that a compound expression of `Arb` elements, such as `x + y` for
+/// real `x` and `y`, is an Arb expression; it needs to be evaluated before it
+/// can be combined with an `Acb`.
+
+#ifndef LIBARBXX_YAP_ACB_HPP
+#define LIBARBXX_YAP_ACB_HPP
+
+#include <acb.h>
+#include <arb.h>
+#include <gmpxx.h>
+
+#include <boost/yap/yap.hpp>
+#include <type_traits>
+
+#include "../acb.hpp"
+#include "../precision.hpp"
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A lazy arithmetic expression built from `Acb` elements, `Arb` elements,
+/// and integers. Calling the expression with a precision evaluates it to an
+/// `Acb`.
+///
+///     arbxx::Acb x{arbxx::Arb{1}, arbxx::Arb{2}};
+///     auto expression = x / 2 - 1;
+///     std::cout << expression(64);
+///     // -> -0.500000 + 1.00000*I
+///
+/// Note that like all Yap expressions, this captures named operands by
+/// reference so the expression must not outlive the elements it was built
+/// from.
+template <boost::yap::expr_kind Kind, typename Tuple>
+struct AcbExpr {
+  static const boost::yap::expr_kind kind = Kind;
+
+  Tuple elements;
+
+  /// Evaluate this expression with working precision `precision`.
+  Acb operator()(prec precision) const;
+};
+
+namespace detail {
+
+// The operands that can appear as terminals in an AcbExpr.
+template <typename T>
+struct is_acb : std::is_same<T, Acb> {};
+
+template <typename T>
+struct is_acb_scalar : std::disjunction<is_arb<T>, is_arb_scalar<T>> {};
+
+template <typename T>
+struct is_acb_operand : std::disjunction<is_acb<T>, is_acb_scalar<T>> {};
+
+// Return the terminal value in the form expected by the Acb C API, i.e.,
+// acb_srcptr, arb_srcptr, slong, ulong, or fmpz.
+inline acb_srcptr acb_argument(const Acb& value) { return value.acb_t(); }
+
+template <typename T>
+decltype(auto) acb_argument(const T& value) { return argument(value); }
+
+template <typename Expr>
+decltype(auto) acb_leaf(const Expr& expr) { return acb_argument(boost::yap::value(unref(expr))); }
+
+inline void set(acb_ptr ret, acb_srcptr x) { acb_set(ret, x); }
+inline void set(acb_ptr ret, arb_srcptr x) { acb_set_arb(ret, x); }
+inline void set(acb_ptr ret, slong x) { acb_set_si(ret, x); }
+inline void set(acb_ptr ret, ulong x) { acb_set_ui(ret, x); }
+inline void set(acb_ptr ret, const ReadonlyFmpz& x) { acb_set_fmpz(ret, x.t); }
+
+// The Acb C functions that implement a binary operation, see Kernel.
+template <boost::yap::expr_kind>
+struct AcbKernel {
+  static constexpr bool supported = false;
+};
+
+template <>
+struct AcbKernel<boost::yap::expr_kind::plus> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = true;
+
+  static void apply(acb_ptr ret, acb_srcptr lhs, acb_srcptr rhs, prec prec) { acb_add(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, arb_srcptr rhs, prec prec) { acb_add_arb(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, slong rhs, prec prec) { acb_add_si(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, ulong rhs, prec prec) { acb_add_ui(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { acb_add_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void apply(acb_ptr ret, const S& lhs, acb_srcptr rhs, prec prec) { apply(ret, rhs, lhs, prec); }
+
+  static void fused(acb_ptr ret, acb_srcptr lhs, acb_srcptr rhs, prec prec) { acb_addmul(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, arb_srcptr rhs, prec prec) { acb_addmul_arb(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, slong rhs, prec prec) { acb_addmul_si(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, ulong rhs, prec prec) { acb_addmul_ui(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { acb_addmul_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void fused(acb_ptr ret, const S& lhs, acb_srcptr rhs, prec prec) { fused(ret, rhs, lhs, prec); }
+};
+
+template <>
+struct AcbKernel<boost::yap::expr_kind::minus> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = true;
+
+  static void apply(acb_ptr ret, acb_srcptr lhs, acb_srcptr rhs, prec prec) { acb_sub(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, arb_srcptr rhs, prec prec) { acb_sub_arb(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, slong rhs, prec prec) { acb_sub_si(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, ulong rhs, prec prec) { acb_sub_ui(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { acb_sub_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void apply(acb_ptr ret, const S& lhs, acb_srcptr rhs, prec prec) {
+    // Negation is exact, so lhs - rhs = -(rhs - lhs) loses nothing.
+    apply(ret, rhs, lhs, prec);
+    acb_neg(ret, ret);
+  }
+
+  static void fused(acb_ptr ret, acb_srcptr lhs, acb_srcptr rhs, prec prec) { acb_submul(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, arb_srcptr rhs, prec prec) { acb_submul_arb(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, slong rhs, prec prec) { acb_submul_si(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, ulong rhs, prec prec) { acb_submul_ui(ret, lhs, rhs, prec); }
+  static void fused(acb_ptr ret, acb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { acb_submul_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void fused(acb_ptr ret, const S& lhs, acb_srcptr rhs, prec prec) { fused(ret, rhs, lhs, prec); }
+};
+
+template <>
+struct AcbKernel<boost::yap::expr_kind::multiplies> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = false;
+
+  static void apply(acb_ptr ret, acb_srcptr lhs, acb_srcptr rhs, prec prec) { acb_mul(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, arb_srcptr rhs, prec prec) { acb_mul_arb(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, slong rhs, prec prec) { acb_mul_si(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, ulong rhs, prec prec) { acb_mul_ui(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { acb_mul_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void apply(acb_ptr ret, const S& lhs, acb_srcptr rhs, prec prec) { apply(ret, rhs, lhs, prec); }
+};
+
+template <>
+struct AcbKernel<boost::yap::expr_kind::divides> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = false;
+
+  static void apply(acb_ptr ret, acb_srcptr lhs, acb_srcptr rhs, prec prec) { acb_div(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, arb_srcptr rhs, prec prec) { acb_div_arb(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, slong rhs, prec prec) { acb_div_si(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, ulong rhs, prec prec) { acb_div_ui(ret, lhs, rhs, prec); }
+  static void apply(acb_ptr ret, acb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { acb_div_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void apply(acb_ptr ret, const S& lhs, acb_srcptr rhs, prec prec) {
+    // There are no kernels for a real numerator, so we promote it.
+    ::acb_t numerator;
+    acb_init(numerator);
+    set(numerator, lhs);
+    acb_div(ret, numerator, rhs, prec);
+    acb_clear(numerator);
+  }
+};
+
+// Evaluate expr into ret with working precision prec, see evaluate() for Arb.
+// Note that ret must not be referenced by any terminal of expr.
+template <typename Expr>
+void evaluate(Acb& ret, const Expr& expr, prec prec) {
+  using boost::yap::expr_kind;
+
+  constexpr expr_kind kind = std::decay_t<Expr>::kind;
+
+  if constexpr (kind == expr_kind::expr_ref) {
+    evaluate(ret, boost::yap::deref(expr), prec);
+  } else if constexpr (kind == expr_kind::terminal) {
+    set(ret.acb_t(), acb_leaf(expr));
+  } else if constexpr (kind == expr_kind::negate) {
+    const auto& operand = boost::yap::get(expr, boost::hana::llong_c<0>);
+    if constexpr (is_leaf<decltype(operand)>) {
+      set(ret.acb_t(), acb_leaf(operand));
+    } else {
+      evaluate(ret, operand, prec);
+    }
+    acb_neg(ret.acb_t(), ret.acb_t());
+  } else {
+    using Op = AcbKernel<kind>;
+    static_assert(Op::supported, "operator not supported in Acb expressions");
+
+    const auto& lhs = boost::yap::left(expr);
+    const auto& rhs = boost::yap::right(expr);
+
+    using L = decltype(lhs);
+    using R = decltype(rhs);
+
+    if constexpr (is_leaf<L> && is_leaf<R>) {
+      Op::apply(ret.acb_t(), acb_leaf(lhs), acb_leaf(rhs), prec);
+    } else if constexpr (Op::fusable && is_fusable_product<R>) {
+      // ret = lhs ± b * c
+      evaluate(ret, lhs, prec);
+      const auto& product = unref(rhs);
+      Op::fused(ret.acb_t(), acb_leaf(boost::yap::left(product)), acb_leaf(boost::yap::right(product)), prec);
+    } else if constexpr (Op::fusable && is_fusable_product<L>) {
+      // ret = b * c ± rhs
+      evaluate(ret, rhs, prec);
+      // Negation is exact, so b * c - rhs = -rhs + b * c loses nothing.
+      if constexpr (kind == expr_kind::minus) acb_neg(ret.acb_t(), ret.acb_t());
+      const auto& product = unref(lhs);
+      AcbKernel<expr_kind::plus>::fused(ret.acb_t(), acb_leaf(boost::yap::left(product)), acb_leaf(boost::yap::right(product)), prec);
+    } else if constexpr (is_leaf<R>) {
+      evaluate(ret, lhs, prec);
+      Op::apply(ret.acb_t(), ret.acb_t(), acb_leaf(rhs), prec);
+    } else if constexpr (is_leaf<L>) {
+      evaluate(ret, rhs, prec);
+      Op::apply(ret.acb_t(), acb_leaf(lhs), ret.acb_t(), prec);
+    } else {
+      // Both sides are compound expressions, so we cannot avoid a temporary.
+      evaluate(ret, lhs, prec);
+      Acb rhs_;
+      evaluate(rhs_, rhs, prec);
+      Op::apply(ret.acb_t(), ret.acb_t(), rhs_.acb_t(), prec);
+    }
+  }
+}
+
+// Compute lhs = lhs ∘ rhs for an expression rhs.
+template <boost::yap::expr_kind Kind, typename Expr>
+Acb& compound(Acb& lhs, const Expr& rhs, prec prec) {
+  using Op = AcbKernel<Kind>;
+  if constexpr (Op::fusable && is_fusable_product<const Expr&>) {
+    // Like Arb's, the fused kernels of Acb allow lhs to appear in the
+    // product.
+    const auto& product = unref(rhs);
+    Op::fused(lhs.acb_t(), acb_leaf(boost::yap::left(product)), acb_leaf(boost::yap::right(product)), prec);
+  } else {
+    // We cannot evaluate into lhs directly since rhs might reference it.
+    Acb rhs_;
+    evaluate(rhs_, rhs, prec);
+    Op::apply(lhs.acb_t(), lhs.acb_t(), rhs_.acb_t(), prec);
+  }
+  return lhs;
+}
+
+}  // namespace detail
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Acb AcbExpr<Kind, Tuple>::operator()(prec precision) const {
+  Acb ret;
+  detail::evaluate(ret, *this, precision);
+  if constexpr (detail::is_leaf<const AcbExpr&>)
+    acb_set_round(ret.acb_t(), ret.acb_t(), precision);
+  return ret;
+}
+
+/// Return this element rounded to `precision`, see [acb_set_round]().
+///
+///     arbxx::Acb x{mpq_class{1, 3}, 256};
+///     x(16).equal(arbxx::Acb{arbxx::Arb{mpq_class{1, 3}, 256}(16)})
+///     // -> true
+///
+template <typename... Args>
+decltype(auto) Acb::operator()(Args&&... args) const {
+  static_assert(sizeof...(Args) == 1, "an Acb can only be evaluated at a precision, i.e., x(64)");
+  Acb ret;
+  acb_set_round(ret.acb_t(), acb_t(), static_cast<prec>(args)...);
+  return ret;
+}
+
+/// ==* In-place Arithmetic with Expressions *==
+/// Replace `lhs` with the result of the operation, evaluating the right hand
+/// side with the working precision of the current thread, see
+/// [PrecisionScope]().
+///
+///     arbxx::Acb x{1}, y{arbxx::Arb{0}, arbxx::Arb{1}};
+///     arbxx::PrecisionScope scope{256};
+///     x += y * y;
+///     std::cout << x;
+///     // -> 0
+///
+template <boost::yap::expr_kind Kind, typename Tuple>
+Acb& operator+=(Acb& lhs, const AcbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::plus>(lhs, rhs, PrecisionScope::precision());
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Acb& operator-=(Acb& lhs, const AcbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::minus>(lhs, rhs, PrecisionScope::precision());
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Acb& operator*=(Acb& lhs, const AcbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::multiplies>(lhs, rhs, PrecisionScope::precision());
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Acb& operator/=(Acb& lhs, const AcbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::divides>(lhs, rhs, PrecisionScope::precision());
+}
+
+BOOST_YAP_USER_UNARY_OPERATOR(negate, AcbExpr, AcbExpr)
+
+BOOST_YAP_USER_BINARY_OPERATOR(plus, AcbExpr, AcbExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(minus, AcbExpr, AcbExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(multiplies, AcbExpr, AcbExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(divides, AcbExpr, AcbExpr)
+
+// Operators between an Acb and an Acb, Arb, or integer …
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(plus, AcbExpr, detail::is_acb, detail::is_acb_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(minus, AcbExpr, detail::is_acb, detail::is_acb_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(multiplies, AcbExpr, detail::is_acb, detail::is_acb_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(divides, AcbExpr, detail::is_acb, detail::is_acb_operand)
+
+// … and between an Arb or integer and an Acb.
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(plus, AcbExpr, detail::is_acb_scalar, detail::is_acb)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(minus, AcbExpr, detail::is_acb_scalar, detail::is_acb)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(multiplies, AcbExpr, detail::is_acb_scalar, detail::is_acb)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(divides, AcbExpr, detail::is_acb_scalar, detail::is_acb)
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,726 @@
+/* ********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2019-2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ * *******************************************************************/
+
+/// Arithmetic on [Arb]() with expression templates powered by Boost.Yap.
+///
+/// Operators on `Arb` do not compute anything directly; they build an
+/// expression which is evaluated once a precision is supplied:
+///
+///     #include <arbxx/yap/arb.hpp>
+///
+///     arbxx::Arb x{1}, y{2}, z{3};
+///     arbxx::Arb w = (x + y * z)(64);
+///     std::cout << w;
+///     // -> 7.00000
+///
+/// An expression is evaluated in a single pass into the resulting `Arb`.
+/// Subexpressions of the shape `a ± b * c` are mapped to the fused kernels
+/// [arb_addmul]() and [arb_submul](). Operations with an operand that is
+/// already available, i.e., an `Arb` or an integer, are performed in place
+/// in the result, so no temporary `Arb` is created unless both sides of an
+/// operator are themselves compound expressions such as in `(a + b) * (c +
+/// d)`.
+
+#ifndef LIBARBXX_YAP_ARB_HPP
+#define LIBARBXX_YAP_ARB_HPP
+
+#include <arb.h>
+#include <flint/fmpz.h>
+#include <gmpxx.h>
+
+#include <boost/yap/yap.hpp>
+#include <type_traits>
+#include <utility>
+
+#include "../arb.hpp"
+#include "../precision.hpp"
+
+namespace arbxx {
+
+/// A lazy arithmetic expression built from `Arb` elements and integers.
+/// Calling the expression with a precision evaluates it to an `Arb`.
+///
+///     arbxx::Arb x{1}, y{2};
+///     auto expression = x / y + 1;
+///     std::cout << expression(64);
+///     // -> 1.50000
+///
+/// Note that like all Yap expressions, this captures named operands by
+/// reference so the expression must not outlive the `Arb` elements it was
+/// built from.
+template <boost::yap::expr_kind Kind, typename Tuple>
+struct ArbExpr {
+  static const boost::yap::expr_kind kind = Kind;
+
+  Tuple elements;
+
+  /// Evaluate this expression with working precision `precision`.
+  Arb operator()(prec precision) const;
+};
+
+namespace detail {
+
+// The operands that can appear as terminals in an ArbExpr.
+template <typename T>
+struct is_arb : std::is_same<T, Arb> {};
+
+template <typename T>
+struct is_arb_scalar : std::bool_constant<(std::is_integral_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, mpz_class>> {};
+
+template <typename T>
+struct is_arb_operand : std::disjunction<is_arb<T>, is_arb_scalar<T>> {};
+
+template <typename T>
+struct is_arb_expr : std::false_type {};
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+struct is_arb_expr<ArbExpr<Kind, Tuple>> : std::true_type {};
+
+// The arguments accepted by the functions exp(), sin(), … on Arb.
+template <typename T>
+using enable_if_arb_argument = std::enable_if_t<is_arb<std::decay_t<T>>::value || is_arb_expr<std::decay_t<T>>::value, int>;
+
+// A read-only fmpz borrowing the limbs of an mpz_class, so that GMP integers
+// can be fed to Arb without copying them.
+struct LIBARBXX_LOCAL ReadonlyFmpz {
+  explicit ReadonlyFmpz(const mpz_class& value) { fmpz_init_set_readonly(t, value.get_mpz_t()); }
+  ReadonlyFmpz(const ReadonlyFmpz&) = delete;
+  ReadonlyFmpz& operator=(const ReadonlyFmpz&) = delete;
+  ~ReadonlyFmpz() { fmpz_clear_readonly(t); }
+
+  fmpz_t t;
+};
+
+// Return the terminal value in the form expected by the Arb C API, i.e.,
+// arb_srcptr, slong, ulong, or fmpz.
+inline arb_srcptr argument(const Arb& value) { return value.arb_t(); }
+
+inline ReadonlyFmpz argument(const mpz_class& value) { return ReadonlyFmpz(value); }
+
+template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+auto argument(T value) {
+  static_assert(sizeof(T) <= sizeof(slong), "integer type is too wide for Arb's C API; convert it to an mpz_class first");
+  if constexpr (std::is_signed_v<T>)
+    return static_cast<slong>(value);
+  else
+    return static_cast<ulong>(value);
+}
+
+// Strip (possibly nested) expr_ref wrappers off an expression.
+template <typename Expr>
+constexpr decltype(auto) unref(Expr&& expr) {
+  if constexpr (std::decay_t<Expr>::kind == boost::yap::expr_kind::expr_ref)
+    return unref(boost::yap::deref(static_cast<Expr&&>(expr)));
+  else
+    return static_cast<Expr&&>(expr);
+}
+
+template <typename Expr>
+using unref_t = std::decay_t<decltype(unref(std::declval<Expr>()))>;
+
+template <typename Expr>
+constexpr bool is_leaf = unref_t<Expr>::kind == boost::yap::expr_kind::terminal;
+
+template <typename Expr>
+using left_t = decltype(boost::yap::left(unref(std::declval<Expr>())));
+
+template <typename Expr>
+using right_t = decltype(boost::yap::right(unref(std::declval<Expr>())));
+
+// Whether an expression is a product of two terminals which can be passed to
+// arb_addmul() and friends.
+template <typename Expr, typename = void>
+constexpr bool is_fusable_product = false;
+
+template <typename Expr>
+constexpr bool is_fusable_product<Expr, std::enable_if_t<unref_t<Expr>::kind == boost::yap::expr_kind::multiplies>> = is_leaf<left_t<Expr>>&& is_leaf<right_t<Expr>>;
+
+template <typename Expr>
+decltype(auto) leaf(const Expr& expr) { return argument(boost::yap::value(unref(expr))); }
+
+// Whether an expression is a terminal holding an Arb.
+template <typename Expr, typename = void>
+constexpr bool is_arb_leaf = false;
+
+template <typename Expr>
+constexpr bool is_arb_leaf<Expr, std::enable_if_t<is_leaf<Expr>>> = is_arb<std::decay_t<decltype(boost::yap::value(unref(std::declval<Expr>())))>>::value;
+
+// The function tag of a call expression.
+template <typename Expr>
+using function_t = std::decay_t<decltype(boost::yap::value(unref(boost::yap::get(unref(std::declval<Expr>()), boost::hana::llong_c<0>))))>;
+
+// Whether an expression is a call of the function with tag Tag.
+template <typename Expr, typename Tag, typename = void>
+constexpr bool is_call = false;
+
+template <typename Expr, typename Tag>
+constexpr bool is_call<Expr, Tag, std::enable_if_t<unref_t<Expr>::kind == boost::yap::expr_kind::call>> = std::is_same_v<function_t<Expr>, Tag>;
+
+inline void set(arb_ptr ret, arb_srcptr x) { arb_set(ret, x); }
+inline void set(arb_ptr ret, slong x) { arb_set_si(ret, x); }
+inline void set(arb_ptr ret, ulong x) { arb_set_ui(ret, x); }
+inline void set(arb_ptr ret, const ReadonlyFmpz& x) { arb_set_fmpz(ret, x.t); }
+
+inline bool is_one(arb_srcptr x) { return arb_is_one(x); }
+inline bool is_one(slong x) { return x == 1; }
+inline bool is_one(ulong x) { return x == 1; }
+inline bool is_one(const ReadonlyFmpz& x) { return fmpz_is_one(x.t); }
+
+// The Arb C functions that implement a binary operation. Each provides
+// apply(ret, lhs, rhs, prec) to compute ret = lhs ∘ rhs and, where there is a
+// fused kernel, fused(ret, lhs, rhs, prec) to compute ret = ret ∘ (lhs * rhs).
+template <boost::yap::expr_kind>
+struct Kernel {
+  static constexpr bool supported = false;
+};
+
+template <>
+struct Kernel<boost::yap::expr_kind::plus> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = true;
+
+  static void apply(arb_ptr ret, arb_srcptr lhs, arb_srcptr rhs, prec prec) { arb_add(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, slong rhs, prec prec) { arb_add_si(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, ulong rhs, prec prec) { arb_add_ui(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { arb_add_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void apply(arb_ptr ret, const S& lhs, arb_srcptr rhs, prec prec) { apply(ret, rhs, lhs, prec); }
+
+  static void fused(arb_ptr ret, arb_srcptr lhs, arb_srcptr rhs, prec prec) { arb_addmul(ret, lhs, rhs, prec); }
+  static void fused(arb_ptr ret, arb_srcptr lhs, slong rhs, prec prec) { arb_addmul_si(ret, lhs, rhs, prec); }
+  static void fused(arb_ptr ret, arb_srcptr lhs, ulong rhs, prec prec) { arb_addmul_ui(ret, lhs, rhs, prec); }
+  static void fused(arb_ptr ret, arb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { arb_addmul_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void fused(arb_ptr ret, const S& lhs, arb_srcptr rhs, prec prec) { fused(ret, rhs, lhs, prec); }
+};
+
+template <>
+struct Kernel<boost::yap::expr_kind::minus> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = true;
+
+  static void apply(arb_ptr ret, arb_srcptr lhs, arb_srcptr rhs, prec prec) { arb_sub(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, slong rhs, prec prec) { arb_sub_si(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, ulong rhs, prec prec) { arb_sub_ui(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { arb_sub_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void apply(arb_ptr ret, const S& lhs, arb_srcptr rhs, prec prec) {
+    // Negation is exact, so lhs - rhs = -(rhs - lhs) loses nothing.
+    apply(ret, rhs, lhs, prec);
+    arb_neg(ret, ret);
+  }
+
+  static void fused(arb_ptr ret, arb_srcptr lhs, arb_srcptr rhs, prec prec) { arb_submul(ret, lhs, rhs, prec); }
+  static void fused(arb_ptr ret, arb_srcptr lhs, slong rhs, prec prec) { arb_submul_si(ret, lhs, rhs, prec); }
+  static void fused(arb_ptr ret, arb_srcptr lhs, ulong rhs, prec prec) { arb_submul_ui(ret, lhs, rhs, prec); }
+  static void fused(arb_ptr ret, arb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { arb_submul_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void fused(arb_ptr ret, const S& lhs, arb_srcptr rhs, prec prec) { fused(ret, rhs, lhs, prec); }
+};
+
+template <>
+struct Kernel<boost::yap::expr_kind::multiplies> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = false;
+
+  static void apply(arb_ptr ret, arb_srcptr lhs, arb_srcptr rhs, prec prec) { arb_mul(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, slong rhs, prec prec) { arb_mul_si(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, ulong rhs, prec prec) { arb_mul_ui(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { arb_mul_fmpz(ret, lhs, rhs.t, prec); }
+  template <typename S>
+  static void apply(arb_ptr ret, const S& lhs, arb_srcptr rhs, prec prec) { apply(ret, rhs, lhs, prec); }
+};
+
+template <>
+struct Kernel<boost::yap::expr_kind::divides> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = false;
+
+  static void apply(arb_ptr ret, arb_srcptr lhs, arb_srcptr rhs, prec prec) { arb_div(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, slong rhs, prec prec) { arb_div_si(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, ulong rhs, prec prec) { arb_div_ui(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, arb_srcptr lhs, const ReadonlyFmpz& rhs, prec prec) { arb_div_fmpz(ret, lhs, rhs.t, prec); }
+  static void apply(arb_ptr ret, ulong lhs, arb_srcptr rhs, prec prec) { arb_ui_div(ret, lhs, rhs, prec); }
+  static void apply(arb_ptr ret, slong lhs, arb_srcptr rhs, prec prec) {
+    arb_ui_div(ret, lhs < 0 ? -static_cast<ulong>(lhs) : static_cast<ulong>(lhs), rhs, prec);
+    if (lhs < 0) arb_neg(ret, ret);
+  }
+  static void apply(arb_ptr ret, const ReadonlyFmpz& lhs, arb_srcptr rhs, prec prec) {
+    ::arb_t numerator;
+    arb_init(numerator);
+    arb_set_fmpz(numerator, lhs.t);
+    arb_div(ret, numerator, rhs, prec);
+    arb_clear(numerator);
+  }
+};
+
+// The tags of the call expressions built by exp(), sin(), …. Each provides
+// apply(ret, x, prec) or apply(ret, x, y, prec) to compute ret = f(x) or
+// ret = f(x, y). (The tag of sqrt() is shared with Arf expressions.)
+struct ExpTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_exp(ret, x, prec); }
+};
+
+struct Expm1Tag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_expm1(ret, x, prec); }
+};
+
+struct LogTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_log(ret, x, prec); }
+};
+
+struct Log1pTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_log1p(ret, x, prec); }
+};
+
+struct SqrtTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_sqrt(ret, x, prec); }
+};
+
+struct SinTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_sin(ret, x, prec); }
+};
+
+struct CosTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_cos(ret, x, prec); }
+};
+
+struct TanTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_tan(ret, x, prec); }
+};
+
+struct AtanTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_atan(ret, x, prec); }
+};
+
+struct SinhTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_sinh(ret, x, prec); }
+};
+
+struct CoshTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_cosh(ret, x, prec); }
+};
+
+struct TanhTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_tanh(ret, x, prec); }
+};
+
+struct GammaTag {
+  static void apply(arb_ptr ret, arb_srcptr x, prec prec) { arb_gamma(ret, x, prec); }
+};
+
+struct Atan2Tag {
+  static void apply(arb_ptr ret, arb_srcptr y, arb_srcptr x, prec prec) { arb_atan2(ret, y, x, prec); }
+  template <typename S>
+  static void apply(arb_ptr ret, arb_srcptr y, const S& x, prec prec) {
+    ::arb_t x_;
+    arb_init(x_);
+    set(x_, x);
+    arb_atan2(ret, y, x_, prec);
+    arb_clear(x_);
+  }
+};
+
+struct PowTag {
+  static void apply(arb_ptr ret, arb_srcptr x, arb_srcptr y, prec prec) { arb_pow(ret, x, y, prec); }
+  static void apply(arb_ptr ret, arb_srcptr x, ulong y, prec prec) { arb_pow_ui(ret, x, y, prec); }
+  static void apply(arb_ptr ret, arb_srcptr x, const ReadonlyFmpz& y, prec prec) { arb_pow_fmpz(ret, x, y.t, prec); }
+  static void apply(arb_ptr ret, arb_srcptr x, slong y, prec prec) {
+    if (y >= 0) {
+      arb_pow_ui(ret, x, static_cast<ulong>(y), prec);
+    } else {
+      fmpz_t y_;
+      fmpz_init_set_si(y_, y);
+      arb_pow_fmpz(ret, x, y_, prec);
+      fmpz_clear(y_);
+    }
+  }
+};
+
+// Evaluate expr into ret with working precision prec.
+// Note that ret must not be referenced by any terminal of expr.
+template <typename Expr>
+void evaluate(Arb& ret, const Expr& expr, prec prec) {
+  using boost::yap::expr_kind;
+
+  constexpr expr_kind kind = std::decay_t<Expr>::kind;
+
+  if constexpr (kind == expr_kind::expr_ref) {
+    evaluate(ret, boost::yap::deref(expr), prec);
+  } else if constexpr (kind == expr_kind::terminal) {
+    set(ret.arb_t(), leaf(expr));
+  } else if constexpr (kind == expr_kind::negate) {
+    const auto& operand = boost::yap::get(expr, boost::hana::llong_c<0>);
+    if constexpr (is_leaf<decltype(operand)>) {
+      set(ret.arb_t(), leaf(operand));
+    } else {
+      evaluate(ret, operand, prec);
+    }
+    arb_neg(ret.arb_t(), ret.arb_t());
+  } else if constexpr (kind == expr_kind::call) {
+    using Function = function_t<const Expr&>;
+
+    if constexpr (decltype(boost::hana::size(expr.elements))::value == 2) {
+      const auto& x = boost::yap::get(expr, boost::hana::llong_c<1>);
+      if constexpr (is_arb_leaf<decltype(x)>) {
+        Function::apply(ret.arb_t(), leaf(x), prec);
+      } else {
+        evaluate(ret, x, prec);
+        Function::apply(ret.arb_t(), ret.arb_t(), prec);
+      }
+    } else {
+      const auto& x = boost::yap::get(expr, boost::hana::llong_c<1>);
+      const auto& y = boost::yap::get(expr, boost::hana::llong_c<2>);
+
+      using X = decltype(x);
+      using Y = decltype(y);
+
+      if constexpr (is_arb_leaf<X> && is_leaf<Y>) {
+        Function::apply(ret.arb_t(), leaf(x), leaf(y), prec);
+      } else if constexpr (is_arb_leaf<X>) {
+        evaluate(ret, y, prec);
+        Function::apply(ret.arb_t(), leaf(x), ret.arb_t(), prec);
+      } else if constexpr (is_leaf<Y>) {
+        evaluate(ret, x, prec);
+        Function::apply(ret.arb_t(), ret.arb_t(), leaf(y), prec);
+      } else {
+        evaluate(ret, x, prec);
+        Arb y_;
+        evaluate(y_, y, prec);
+        Function::apply(ret.arb_t(), ret.arb_t(), y_.arb_t(), prec);
+      }
+    }
+  } else {
+    using Op = Kernel<kind>;
+    static_assert(Op::supported, "operator not supported in Arb expressions");
+
+    const auto& lhs = boost::yap::left(expr);
+    const auto& rhs = boost::yap::right(expr);
+
+    using L = decltype(lhs);
+    using R = decltype(rhs);
+
+    if constexpr (is_leaf<L> && is_leaf<R>) {
+      Op::apply(ret.arb_t(), leaf(lhs), leaf(rhs), prec);
+    } else if constexpr (kind == expr_kind::minus && is_call<L, ExpTag> && is_leaf<R>) {
+      // exp(x) - 1 is computed with arb_expm1() which does not suffer from
+      // cancellation when x is close to zero.
+      const auto& x = boost::yap::get(unref(lhs), boost::hana::llong_c<1>);
+      if (is_one(leaf(rhs))) {
+        if constexpr (is_arb_leaf<decltype(x)>) {
+          arb_expm1(ret.arb_t(), leaf(x), prec);
+        } else {
+          evaluate(ret, x, prec);
+          arb_expm1(ret.arb_t(), ret.arb_t(), prec);
+        }
+      } else {
+        evaluate(ret, lhs, prec);
+        Op::apply(ret.arb_t(), ret.arb_t(), leaf(rhs), prec);
+      }
+    } else if constexpr (Op::fusable && is_fusable_product<R>) {
+      // ret = lhs ± b * c
+      evaluate(ret, lhs, prec);
+      const auto& product = unref(rhs);
+      Op::fused(ret.arb_t(), leaf(boost::yap::left(product)), leaf(boost::yap::right(product)), prec);
+    } else if constexpr (Op::fusable && is_fusable_product<L>) {
+      // ret = b * c ± rhs
+      evaluate(ret, rhs, prec);
+      // Negation is exact, so b * c - rhs = -rhs + b * c loses nothing.
+      if constexpr (kind == expr_kind::minus) arb_neg(ret.arb_t(), ret.arb_t());
+      const auto& product = unref(lhs);
+      Kernel<expr_kind::plus>::fused(ret.arb_t(), leaf(boost::yap::left(product)), leaf(boost::yap::right(product)), prec);
+    } else if constexpr (is_leaf<R>) {
+      evaluate(ret, lhs, prec);
+      Op::apply(ret.arb_t(), ret.arb_t(), leaf(rhs), prec);
+    } else if constexpr (is_leaf<L>) {
+      evaluate(ret, rhs, prec);
+      Op::apply(ret.arb_t(), leaf(lhs), ret.arb_t(), prec);
+    } else {
+      // Both sides are compound expressions, so we cannot avoid a temporary.
+      evaluate(ret, lhs, prec);
+      Arb rhs_;
+      evaluate(rhs_, rhs, prec);
+      Op::apply(ret.arb_t(), ret.arb_t(), rhs_.arb_t(), prec);
+    }
+  }
+}
+
+// Return a call expression of the function with tag Tag.
+template <typename Tag, typename... T>
+auto call(T&&... x) {
+  return boost::yap::make_expression<ArbExpr, boost::yap::expr_kind::call>(boost::yap::make_terminal<ArbExpr>(Tag{}), boost::yap::as_expr<ArbExpr>(std::forward<T>(x))...);
+}
+
+// Invoke f with an arb_srcptr holding x evaluated at precision prec.
+template <typename T, typename F>
+void with_arb(const T& x, prec prec, F&& f) {
+  if constexpr (is_arb<T>::value) {
+    f(x.arb_t());
+  } else {
+    const Arb x_ = x(prec);
+    f(x_.arb_t());
+  }
+}
+
+// Compute lhs = lhs ∘ rhs for an expression rhs.
+template <boost::yap::expr_kind Kind, typename Expr>
+Arb& compound(Arb& lhs, const Expr& rhs, prec prec) {
+  using Op = Kernel<Kind>;
+  if constexpr (Op::fusable && is_fusable_product<const Expr&>) {
+    // Arb's fused kernels allow lhs to appear in the product, so x += x * y
+    // can be computed without a temporary.
+    const auto& product = unref(rhs);
+    Op::fused(lhs.arb_t(), leaf(boost::yap::left(product)), leaf(boost::yap::right(product)), prec);
+  } else {
+    // We cannot evaluate into lhs directly since rhs might reference it.
+    Arb rhs_;
+    evaluate(rhs_, rhs, prec);
+    Op::apply(lhs.arb_t(), lhs.arb_t(), rhs_.arb_t(), prec);
+  }
+  return lhs;
+}
+
+}  // namespace detail
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arb ArbExpr<Kind, Tuple>::operator()(prec precision) const {
+  Arb ret;
+  detail::evaluate(ret, *this, precision);
+  if constexpr (detail::is_leaf<const ArbExpr&>)
+    arb_set_round(ret.arb_t(), ret.arb_t(), precision);
+  return ret;
+}
+
+/// Return this element rounded to `precision`, see [arb_set_round]().
+///
+///     arbxx::Arb x{mpq_class{1, 3}, 256};
+///     std::cout << x(16);
+///     // -> [0.33333 +/- 4.58e-6]
+///
+template <typename... Args>
+decltype(auto) Arb::operator()(Args&&... args) const {
+  static_assert(sizeof...(Args) == 1, "an Arb can only be evaluated at a precision, i.e., x(64)");
+  Arb ret;
+  arb_set_round(ret.arb_t(), arb_t(), static_cast<prec>(args)...);
+  return ret;
+}
+
+/// ==* Elementary and Special Functions *==
+/// Return `f(x)` as an expression, see [arb_exp](), [arb_expm1](),
+/// [arb_log](), [arb_log1p](), [arb_sqrt](), [arb_sin](), [arb_cos](),
+/// [arb_tan](), [arb_atan](), [arb_sinh](), [arb_cosh](), [arb_tanh](), and
+/// [arb_gamma]().
+/// Like all other expressions, these are evaluated once a precision is
+/// supplied and can be combined freely with arithmetic:
+///
+///     arbxx::Arb x{1};
+///     auto e = arbxx::exp(x)(64);
+///     *(e > 2) && *(e < 3)
+///     // -> true
+///
+///     auto y = (arbxx::sqrt(x + 1) * arbxx::sqrt(x + 1))(64);
+///     (y == 2).has_value()
+///     // -> false
+///
+///     *(y > 1)
+///     // -> true
+///
+/// The arguments of the functions are evaluated into the result directly, so
+/// no temporary `Arb` is created. An expression `exp(x) - 1` is evaluated
+/// with [arb_expm1]() which is accurate when `x` is close to zero:
+///
+///     arbxx::Arb tiny{mpq_class{1, 1000000}, 64};
+///     (arbxx::exp(tiny) - 1)(64).equal(arbxx::expm1(tiny)(64))
+///     // -> true
+///
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto exp(T&& x) {
+  return detail::call<detail::ExpTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto expm1(T&& x) {
+  return detail::call<detail::Expm1Tag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto log(T&& x) {
+  return detail::call<detail::LogTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto log1p(T&& x) {
+  return detail::call<detail::Log1pTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto sqrt(T&& x) {
+  return detail::call<detail::SqrtTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto sin(T&& x) {
+  return detail::call<detail::SinTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto cos(T&& x) {
+  return detail::call<detail::CosTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto tan(T&& x) {
+  return detail::call<detail::TanTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto atan(T&& x) {
+  return detail::call<detail::AtanTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto sinh(T&& x) {
+  return detail::call<detail::SinhTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto cosh(T&& x) {
+  return detail::call<detail::CoshTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto tanh(T&& x) {
+  return detail::call<detail::TanhTag>(std::forward<T>(x));
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+auto gamma(T&& x) {
+  return detail::call<detail::GammaTag>(std::forward<T>(x));
+}
+
+/// Return the angle of the point `(x, y)` as an expression, see
+/// [arb_atan2](). Note that, as in the C library, `y` comes first.
+///
+///     arbxx::Arb x{1}, y{1};
+///     auto angle = arbxx::atan2(y, x)(64);
+///     *(angle > mpq_class{3, 4}) && *(angle < 1)
+///     // -> true
+///
+template <typename Y, typename X, detail::enable_if_arb_argument<Y> = 0, typename = std::enable_if_t<detail::is_arb_operand<std::decay_t<X>>::value || detail::is_arb_expr<std::decay_t<X>>::value>>
+auto atan2(Y&& y, X&& x) {
+  return detail::call<detail::Atan2Tag>(std::forward<Y>(y), std::forward<X>(x));
+}
+
+/// Return `x^y` as an expression, see [arb_pow](). Integer exponents are
+/// mapped to [arb_pow_ui]() and [arb_pow_fmpz]() which give tighter
+/// enclosures.
+///
+///     arbxx::Arb x{2};
+///     std::cout << arbxx::pow(x, 10)(64);
+///     // -> 1024.00
+///
+///     arbxx::pow(x, -1)(64).equal(arbxx::Arb{mpq_class{1, 2}, 64})
+///     // -> true
+///
+template <typename T, typename S, detail::enable_if_arb_argument<T> = 0, typename = std::enable_if_t<detail::is_arb_operand<std::decay_t<S>>::value || detail::is_arb_expr<std::decay_t<S>>::value>>
+auto pow(T&& x, S&& y) {
+  return detail::call<detail::PowTag>(std::forward<T>(x), std::forward<S>(y));
+}
+
+/// ==* Fused Functions *==
+/// Return `(sin(x), cos(x))` and `(sinh(x), cosh(x))`, see [arb_sin_cos]()
+/// and [arb_sinh_cosh](). Computing both values at once costs about as much
+/// as computing one of them.
+/// If no precision is given, the working precision of the current thread is
+/// used, see [PrecisionScope]().
+///
+///     arbxx::Arb x{0};
+///     auto [s, c] = arbxx::sin_cos(x, 64);
+///     std::cout << s << ", " << c;
+///     // -> 0, 1.00000
+///
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+std::pair<Arb, Arb> sin_cos(const T& x, prec precision = PrecisionScope::precision()) {
+  std::pair<Arb, Arb> ret;
+  detail::with_arb(x, precision, [&](arb_srcptr x_) { arb_sin_cos(ret.first.arb_t(), ret.second.arb_t(), x_, precision); });
+  return ret;
+}
+
+template <typename T, detail::enable_if_arb_argument<T> = 0>
+std::pair<Arb, Arb> sinh_cosh(const T& x, prec precision = PrecisionScope::precision()) {
+  std::pair<Arb, Arb> ret;
+  detail::with_arb(x, precision, [&](arb_srcptr x_) { arb_sinh_cosh(ret.first.arb_t(), ret.second.arb_t(), x_, precision); });
+  return ret;
+}
+
+/// ==* In-place Arithmetic with Expressions *==
+/// Replace `lhs` with the result of the operation, evaluating the right hand
+/// side with the working precision of the current thread, see
+/// [PrecisionScope]().
+/// A right hand side that is a product of two terminals is mapped to
+/// [arb_addmul]() and [arb_submul]() so that no temporary is created.
+///
+///     arbxx::Arb x{1}, y{2}, z{3};
+///     arbxx::PrecisionScope scope{256};
+///     x += y * z;
+///     std::cout << x;
+///     // -> 7.00000
+///
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arb& operator+=(Arb& lhs, const ArbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::plus>(lhs, rhs, PrecisionScope::precision());
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arb& operator-=(Arb& lhs, const ArbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::minus>(lhs, rhs, PrecisionScope::precision());
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arb& operator*=(Arb& lhs, const ArbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::multiplies>(lhs, rhs, PrecisionScope::precision());
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arb& operator/=(Arb& lhs, const ArbExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::divides>(lhs, rhs, PrecisionScope::precision());
+}
+
+BOOST_YAP_USER_UNARY_OPERATOR(negate, ArbExpr, ArbExpr)
+
+BOOST_YAP_USER_BINARY_OPERATOR(plus, ArbExpr, ArbExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(minus, ArbExpr, ArbExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(multiplies, ArbExpr, ArbExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(divides, ArbExpr, ArbExpr)
+
+// Operators between an Arb and an Arb or integer …
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(plus, ArbExpr, detail::is_arb, detail::is_arb_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(minus, ArbExpr, detail::is_arb, detail::is_arb_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(multiplies, ArbExpr, detail::is_arb, detail::is_arb_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(divides, ArbExpr, detail::is_arb, detail::is_arb_operand)
+
+// … and between an integer and an Arb.
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(plus, ArbExpr, detail::is_arb_scalar, detail::is_arb)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(minus, ArbExpr, detail::is_arb_scalar, detail::is_arb)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(multiplies, ArbExpr, detail::is_arb_scalar, detail::is_arb)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(divides, ArbExpr, detail::is_arb_scalar, detail::is_arb)
+
+}  // namespace arbxx
+
+#endif
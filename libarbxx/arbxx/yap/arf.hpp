@@ -0,0 +1,548 @@
+/* ********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2019-2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ * *******************************************************************/
+
+/// Arithmetic on [Arf]() with expression templates powered by Boost.Yap.
+///
+/// Operators on `Arf` do not compute anything directly; they build an
+/// expression which is evaluated once a precision and a rounding mode are
+/// supplied:
+///
+///     #include <arbxx/yap/arf.hpp>
+///
+///     arbxx::Arf a{1}, b{2}, c{3};
+///     arbxx::Arf x = (a * b + c)(64, arbxx::Arf::Round::DOWN);
+///     std::cout << x;
+///     // -> 5
+///
+/// Every operation is rounded to `precision` bits in the direction of the
+/// rounding mode. Subexpressions of the shape `a * b ± c` are mapped to
+/// [arf_fma]() so they are rounded only once, and sums and differences of
+/// three or more terms such as `a + b - c` are mapped to [arf_sum]() which
+/// rounds the exact sum. No temporary `Arf` is created unless both sides of
+/// an operator are compound expressions such as in `(a + b) * (c + d)`.
+///
+/// Sums, differences, and products can also be computed exactly by passing
+/// `ARF_PREC_EXACT` as the precision:
+///
+///     std::cout << (a * b + c)(ARF_PREC_EXACT, arbxx::Arf::Round::NEAR);
+///     // -> 5
+
+#ifndef LIBARBXX_YAP_ARF_HPP
+#define LIBARBXX_YAP_ARF_HPP
+
+#include <arf.h>
+#include <flint/fmpz.h>
+#include <gmpxx.h>
+
+#include <boost/yap/yap.hpp>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../arf.hpp"
+#include "../precision.hpp"
+#include "arb.hpp"
+
+namespace arbxx {
+
+/// A lazy arithmetic expression built from `Arf` elements and integers.
+/// Calling the expression with a precision and a rounding mode evaluates it
+/// to an `Arf`.
+///
+///     arbxx::Arf x{1}, y{3};
+///     auto expression = x / y;
+///     std::cout << expression(2, arbxx::Arf::Round::DOWN);
+///     // -> 0.25=1p-2
+///
+///     std::cout << expression(2, arbxx::Arf::Round::UP);
+///     // -> 0.375=3p-3
+///
+/// Note that like all Yap expressions, this captures named operands by
+/// reference so the expression must not outlive the `Arf` elements it was
+/// built from.
+template <boost::yap::expr_kind Kind, typename Tuple>
+struct ArfExpr {
+  static const boost::yap::expr_kind kind = Kind;
+
+  Tuple elements;
+
+  /// Evaluate this expression with working precision `precision` rounding
+  /// every operation in the direction `round`.
+  Arf operator()(prec precision, Arf::Round round) const;
+};
+
+namespace detail {
+
+// The operands that can appear as terminals in an ArfExpr. The integer
+// operands are the same as for ArbExpr.
+template <typename T>
+struct is_arf : std::is_same<T, Arf> {};
+
+template <typename T>
+struct is_arf_operand : std::disjunction<is_arf<T>, is_arb_scalar<T>> {};
+
+template <typename T>
+struct is_arf_expr : std::false_type {};
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+struct is_arf_expr<ArfExpr<Kind, Tuple>> : std::true_type {};
+
+inline arf_srcptr argument(const Arf& value) { return value.arf_t(); }
+
+// Return the terminal value in the form expected by the Arf C API, i.e.,
+// arf_srcptr, slong, ulong, or fmpz.
+template <typename Expr>
+decltype(auto) arf_leaf(const Expr& expr) { return argument(boost::yap::value(unref(expr))); }
+
+// Return the rounding mode that rounds -x in the direction in which rnd
+// rounds x.
+constexpr arf_rnd_t opposite(arf_rnd_t rnd) {
+  if (rnd == ARF_RND_FLOOR) return ARF_RND_CEIL;
+  if (rnd == ARF_RND_CEIL) return ARF_RND_FLOOR;
+  return rnd;
+}
+
+// Division and square roots do not terminate in general, so they cannot be
+// evaluated exactly.
+inline void require_finite(prec prec, const char* operation) {
+  if (prec == ARF_PREC_EXACT)
+    throw std::invalid_argument(std::string(operation) + " cannot be computed with ARF_PREC_EXACT");
+}
+
+// Initialize t as a shallow (possibly negated) copy of a terminal so that it
+// can be passed to C functions which only accept arf_t operands. Such a copy
+// must not be cleared.
+inline void init_shallow(arf_ptr t, arf_srcptr x, bool negate) {
+  if (negate)
+    arf_init_neg_shallow(t, x);
+  else
+    *t = *x;
+}
+
+inline void init_shallow(arf_ptr t, slong x, bool negate) {
+  arf_init_set_si(t, x);
+  if (negate) arf_neg(t, t);
+}
+
+inline void init_shallow(arf_ptr t, ulong x, bool negate) {
+  arf_init_set_ui(t, x);
+  if (negate) arf_neg(t, t);
+}
+
+// A terminal as an arf_srcptr. Only big integers need to be copied; Arf
+// elements are used directly (or as a shallow copy if negated) and machine
+// integers are represented without allocating.
+struct LIBARBXX_LOCAL ShallowArf {
+  ShallowArf(arf_srcptr x, bool negate = false) : ptr(negate ? t : x) {
+    if (negate) init_shallow(t, x, true);
+  }
+
+  template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+  ShallowArf(T x, bool negate = false) : ptr(t) { init_shallow(t, x, negate); }
+
+  ShallowArf(const ReadonlyFmpz& x, bool negate = false) : ptr(t), owned(true) {
+    arf_init(t);
+    arf_set_fmpz(t, x.t);
+    if (negate) arf_neg(t, t);
+  }
+
+  ShallowArf(const ShallowArf&) = delete;
+  ShallowArf& operator=(const ShallowArf&) = delete;
+
+  ~ShallowArf() {
+    if (owned) arf_clear(t);
+  }
+
+  arf_srcptr get() const { return ptr; }
+
+  ::arf_t t;
+  arf_srcptr ptr;
+  bool owned = false;
+};
+
+inline void set(arf_ptr ret, arf_srcptr x, prec prec, arf_rnd_t rnd) { arf_set_round(ret, x, prec, rnd); }
+inline void set(arf_ptr ret, slong x, prec prec, arf_rnd_t rnd) { arf_set_round_si(ret, x, prec, rnd); }
+inline void set(arf_ptr ret, ulong x, prec prec, arf_rnd_t rnd) { arf_set_round_ui(ret, x, prec, rnd); }
+inline void set(arf_ptr ret, const ReadonlyFmpz& x, prec prec, arf_rnd_t rnd) { arf_set_round_fmpz(ret, x.t, prec, rnd); }
+
+inline void square_root(arf_ptr ret, arf_srcptr x, prec prec, arf_rnd_t rnd) { arf_sqrt(ret, x, prec, rnd); }
+inline void square_root(arf_ptr ret, ulong x, prec prec, arf_rnd_t rnd) { arf_sqrt_ui(ret, x, prec, rnd); }
+inline void square_root(arf_ptr ret, const ReadonlyFmpz& x, prec prec, arf_rnd_t rnd) { arf_sqrt_fmpz(ret, x.t, prec, rnd); }
+inline void square_root(arf_ptr ret, slong x, prec prec, arf_rnd_t rnd) {
+  if (x < 0)
+    arf_nan(ret);
+  else
+    arf_sqrt_ui(ret, static_cast<ulong>(x), prec, rnd);
+}
+
+// The Arf C functions that implement a binary operation. Each provides
+// apply(ret, lhs, rhs, prec, rnd) to compute ret = lhs ∘ rhs.
+template <boost::yap::expr_kind>
+struct ArfKernel {
+  static constexpr bool supported = false;
+};
+
+template <>
+struct ArfKernel<boost::yap::expr_kind::plus> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = true;
+
+  static void apply(arf_ptr ret, arf_srcptr lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { arf_add(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, slong rhs, prec prec, arf_rnd_t rnd) { arf_add_si(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, ulong rhs, prec prec, arf_rnd_t rnd) { arf_add_ui(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, const ReadonlyFmpz& rhs, prec prec, arf_rnd_t rnd) { arf_add_fmpz(ret, lhs, rhs.t, prec, rnd); }
+  template <typename S>
+  static void apply(arf_ptr ret, const S& lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { apply(ret, rhs, lhs, prec, rnd); }
+};
+
+template <>
+struct ArfKernel<boost::yap::expr_kind::minus> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = true;
+
+  static void apply(arf_ptr ret, arf_srcptr lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { arf_sub(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, slong rhs, prec prec, arf_rnd_t rnd) { arf_sub_si(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, ulong rhs, prec prec, arf_rnd_t rnd) { arf_sub_ui(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, const ReadonlyFmpz& rhs, prec prec, arf_rnd_t rnd) { arf_sub_fmpz(ret, lhs, rhs.t, prec, rnd); }
+  template <typename S>
+  static void apply(arf_ptr ret, const S& lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) {
+    // Unlike for Arb, we cannot compute -(rhs - lhs) here since the
+    // negation would flip the direction of rounding.
+    ShallowArf lhs_(lhs);
+    arf_sub(ret, lhs_.get(), rhs, prec, rnd);
+  }
+};
+
+template <>
+struct ArfKernel<boost::yap::expr_kind::multiplies> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = false;
+
+  static void apply(arf_ptr ret, arf_srcptr lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { arf_mul(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, slong rhs, prec prec, arf_rnd_t rnd) { arf_mul_si(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, ulong rhs, prec prec, arf_rnd_t rnd) { arf_mul_ui(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, const ReadonlyFmpz& rhs, prec prec, arf_rnd_t rnd) { arf_mul_fmpz(ret, lhs, rhs.t, prec, rnd); }
+  template <typename S>
+  static void apply(arf_ptr ret, const S& lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { apply(ret, rhs, lhs, prec, rnd); }
+};
+
+template <>
+struct ArfKernel<boost::yap::expr_kind::divides> {
+  static constexpr bool supported = true;
+  static constexpr bool fusable = false;
+
+  static void apply(arf_ptr ret, arf_srcptr lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { arf_div(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, slong rhs, prec prec, arf_rnd_t rnd) { arf_div_si(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, ulong rhs, prec prec, arf_rnd_t rnd) { arf_div_ui(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, arf_srcptr lhs, const ReadonlyFmpz& rhs, prec prec, arf_rnd_t rnd) { arf_div_fmpz(ret, lhs, rhs.t, prec, rnd); }
+  static void apply(arf_ptr ret, slong lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { arf_si_div(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, ulong lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) { arf_ui_div(ret, lhs, rhs, prec, rnd); }
+  static void apply(arf_ptr ret, const ReadonlyFmpz& lhs, arf_srcptr rhs, prec prec, arf_rnd_t rnd) {
+    ShallowArf lhs_(lhs);
+    arf_div(ret, lhs_.get(), rhs, prec, rnd);
+  }
+};
+
+// Return the number of terms if expr is a sum or difference of Arf elements
+// and machine integers, i.e., something that can be handed to arf_sum() as a
+// whole, and zero otherwise.
+template <typename Expr>
+constexpr slong summands() {
+  using boost::yap::expr_kind;
+
+  using E = unref_t<Expr>;
+
+  if constexpr (E::kind == expr_kind::terminal) {
+    return std::is_same_v<std::decay_t<decltype(arf_leaf(std::declval<const E&>()))>, ReadonlyFmpz> ? 0 : 1;
+  } else if constexpr (E::kind == expr_kind::negate) {
+    return summands<decltype(boost::yap::get(std::declval<const E&>(), boost::hana::llong_c<0>))>();
+  } else if constexpr (E::kind == expr_kind::plus || E::kind == expr_kind::minus) {
+    constexpr slong lhs = summands<left_t<Expr>>();
+    constexpr slong rhs = summands<right_t<Expr>>();
+    return lhs && rhs ? lhs + rhs : 0;
+  } else {
+    return 0;
+  }
+}
+
+// Write shallow copies of the terms of a sum as counted by summands() to
+// terms, advancing terms past the last term written.
+template <typename Expr>
+void collect(arf_ptr& terms, const Expr& expr, bool negate) {
+  using boost::yap::expr_kind;
+
+  const auto& e = unref(expr);
+  constexpr expr_kind kind = std::decay_t<decltype(e)>::kind;
+
+  if constexpr (kind == expr_kind::terminal) {
+    init_shallow(terms++, arf_leaf(e), negate);
+  } else if constexpr (kind == expr_kind::negate) {
+    collect(terms, boost::yap::get(e, boost::hana::llong_c<0>), !negate);
+  } else {
+    collect(terms, boost::yap::left(e), negate);
+    collect(terms, boost::yap::right(e), kind == expr_kind::minus ? !negate : negate);
+  }
+}
+
+// Compute ret = c ± a * b with a single rounding.
+// Note that ret must not be referenced by a or b.
+template <typename A, typename B>
+void fma(arf_ptr ret, const A& a, const B& b, arf_srcptr c, bool subtract, prec prec, arf_rnd_t rnd) {
+  ShallowArf a_(a, subtract);
+  ShallowArf b_(b);
+  arf_fma(ret, a_.get(), b_.get(), c, prec, rnd);
+}
+
+// Compute ret = ret ± a * b with a single rounding. Here, ret may be
+// referenced by a or b.
+template <typename A, typename B>
+void addmul(arf_ptr ret, const A& a, const B& b, bool subtract, prec prec, arf_rnd_t rnd) {
+  ShallowArf a_(a);
+  ShallowArf b_(b);
+  if (subtract)
+    arf_submul(ret, a_.get(), b_.get(), prec, rnd);
+  else
+    arf_addmul(ret, a_.get(), b_.get(), prec, rnd);
+}
+
+// Evaluate expr into ret with working precision prec rounding in the
+// direction of rnd.
+// Note that ret must not be referenced by any terminal of expr.
+template <typename Expr>
+void evaluate(Arf& ret, const Expr& expr, prec prec, arf_rnd_t rnd) {
+  using boost::yap::expr_kind;
+
+  constexpr expr_kind kind = std::decay_t<Expr>::kind;
+
+  if constexpr (kind == expr_kind::expr_ref) {
+    evaluate(ret, boost::yap::deref(expr), prec, rnd);
+  } else if constexpr (kind == expr_kind::terminal) {
+    set(ret.arf_t(), arf_leaf(expr), prec, rnd);
+  } else if constexpr (kind == expr_kind::negate) {
+    // Negation is exact, so -x rounded in one direction is the negative of x
+    // rounded in the other direction.
+    const auto& operand = boost::yap::get(expr, boost::hana::llong_c<0>);
+    if constexpr (is_leaf<decltype(operand)>) {
+      set(ret.arf_t(), arf_leaf(operand), prec, opposite(rnd));
+    } else {
+      evaluate(ret, operand, prec, opposite(rnd));
+    }
+    arf_neg(ret.arf_t(), ret.arf_t());
+  } else if constexpr (kind == expr_kind::call) {
+    static_assert(std::is_same_v<std::decay_t<decltype(boost::yap::value(unref(boost::yap::get(expr, boost::hana::llong_c<0>))))>, SqrtTag>, "function not supported in Arf expressions");
+
+    require_finite(prec, "sqrt");
+
+    const auto& operand = boost::yap::get(expr, boost::hana::llong_c<1>);
+    if constexpr (is_leaf<decltype(operand)>) {
+      square_root(ret.arf_t(), arf_leaf(operand), prec, rnd);
+    } else {
+      evaluate(ret, operand, prec, rnd);
+      arf_sqrt(ret.arf_t(), ret.arf_t(), prec, rnd);
+    }
+  } else {
+    using Op = ArfKernel<kind>;
+    static_assert(Op::supported, "operator not supported in Arf expressions");
+
+    if constexpr (kind == expr_kind::divides)
+      require_finite(prec, "division");
+
+    const auto& lhs = boost::yap::left(expr);
+    const auto& rhs = boost::yap::right(expr);
+
+    using L = decltype(lhs);
+    using R = decltype(rhs);
+
+    constexpr slong terms = summands<const Expr&>();
+
+    if constexpr (terms > 2) {
+      // ret = a ± b ± c ± …, rounded once.
+      arf_struct operands[terms];
+      arf_ptr end = operands;
+      collect(end, expr, false);
+      arf_sum(ret.arf_t(), operands, terms, prec, rnd);
+    } else if constexpr (is_leaf<L> && is_leaf<R>) {
+      Op::apply(ret.arf_t(), arf_leaf(lhs), arf_leaf(rhs), prec, rnd);
+    } else if constexpr (Op::fusable && is_fusable_product<L> && is_leaf<R>) {
+      // ret = a * b ± c
+      const auto& product = unref(lhs);
+      ShallowArf c(arf_leaf(rhs), kind == expr_kind::minus);
+      fma(ret.arf_t(), arf_leaf(boost::yap::left(product)), arf_leaf(boost::yap::right(product)), c.get(), false, prec, rnd);
+    } else if constexpr (Op::fusable && is_fusable_product<R> && is_leaf<L>) {
+      // ret = c ± a * b
+      const auto& product = unref(rhs);
+      ShallowArf c(arf_leaf(lhs));
+      fma(ret.arf_t(), arf_leaf(boost::yap::left(product)), arf_leaf(boost::yap::right(product)), c.get(), kind == expr_kind::minus, prec, rnd);
+    } else if constexpr (Op::fusable && is_fusable_product<R>) {
+      // ret = lhs ± a * b
+      evaluate(ret, lhs, prec, rnd);
+      const auto& product = unref(rhs);
+      addmul(ret.arf_t(), arf_leaf(boost::yap::left(product)), arf_leaf(boost::yap::right(product)), kind == expr_kind::minus, prec, rnd);
+    } else if constexpr (Op::fusable && is_fusable_product<L>) {
+      // ret = a * b ± rhs
+      if constexpr (kind == expr_kind::minus) {
+        // a * b - rhs = a * b + (-rhs) where -rhs is rounded like rhs.
+        evaluate(ret, rhs, prec, opposite(rnd));
+        arf_neg(ret.arf_t(), ret.arf_t());
+      } else {
+        evaluate(ret, rhs, prec, rnd);
+      }
+      const auto& product = unref(lhs);
+      addmul(ret.arf_t(), arf_leaf(boost::yap::left(product)), arf_leaf(boost::yap::right(product)), false, prec, rnd);
+    } else if constexpr (is_leaf<R>) {
+      evaluate(ret, lhs, prec, rnd);
+      Op::apply(ret.arf_t(), ret.arf_t(), arf_leaf(rhs), prec, rnd);
+    } else if constexpr (is_leaf<L>) {
+      evaluate(ret, rhs, prec, rnd);
+      Op::apply(ret.arf_t(), arf_leaf(lhs), ret.arf_t(), prec, rnd);
+    } else {
+      // Both sides are compound expressions, so we cannot avoid a temporary.
+      evaluate(ret, lhs, prec, rnd);
+      Arf rhs_;
+      evaluate(rhs_, rhs, prec, rnd);
+      Op::apply(ret.arf_t(), ret.arf_t(), rhs_.arf_t(), prec, rnd);
+    }
+  }
+}
+
+// Compute lhs = lhs ∘ rhs for an expression rhs.
+template <boost::yap::expr_kind Kind, typename Expr>
+Arf& compound(Arf& lhs, const Expr& rhs, prec prec, arf_rnd_t rnd) {
+  using Op = ArfKernel<Kind>;
+
+  if constexpr (Kind == boost::yap::expr_kind::divides)
+    require_finite(prec, "division");
+
+  if constexpr (Op::fusable && is_fusable_product<const Expr&>) {
+    // Arf's fused kernels allow lhs to appear in the product, so x += x * y
+    // can be computed without a temporary.
+    const auto& product = unref(rhs);
+    addmul(lhs.arf_t(), arf_leaf(boost::yap::left(product)), arf_leaf(boost::yap::right(product)), Kind == boost::yap::expr_kind::minus, prec, rnd);
+  } else {
+    // We cannot evaluate into lhs directly since rhs might reference it.
+    Arf rhs_;
+    evaluate(rhs_, rhs, prec, rnd);
+    Op::apply(lhs.arf_t(), lhs.arf_t(), rhs_.arf_t(), prec, rnd);
+  }
+  return lhs;
+}
+
+}  // namespace detail
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arf ArfExpr<Kind, Tuple>::operator()(prec precision, Arf::Round round) const {
+  Arf ret;
+  detail::evaluate(ret, *this, precision, static_cast<arf_rnd_t>(round));
+  return ret;
+}
+
+/// Return this element rounded to `precision` bits in the direction of
+/// `round`, see [arf_set_round]().
+///
+///     arbxx::Arf x{mpz_class{7}};
+///     std::cout << x(2, arbxx::Arf::Round::DOWN);
+///     // -> 6
+///
+template <typename... Args>
+decltype(auto) Arf::operator()(Args&&... args) const {
+  static_assert(sizeof...(Args) == 2, "an Arf can only be evaluated at a precision with a rounding mode, i.e., x(64, Arf::Round::NEAR)");
+  return boost::yap::make_terminal<ArfExpr>(*this)(std::forward<Args>(args)...);
+}
+
+/// Return the square root of `x` as an expression, see [arf_sqrt]().
+///
+///     arbxx::Arf x{2};
+///     std::cout << arbxx::sqrt(x)(4, arbxx::Arf::Round::DOWN);
+///     // -> 1.375=11p-3
+///
+template <typename T, typename = std::enable_if_t<detail::is_arf<std::decay_t<T>>::value || detail::is_arf_expr<std::decay_t<T>>::value>>
+auto sqrt(T&& x) {
+  return boost::yap::make_expression<ArfExpr, boost::yap::expr_kind::call>(boost::yap::make_terminal<ArfExpr>(detail::SqrtTag{}), boost::yap::as_expr<ArfExpr>(std::forward<T>(x)));
+}
+
+/// Return `a * b + c` as an expression, see [arf_fma](). If all operands are
+/// terminals, the result is rounded only once.
+///
+///     arbxx::Arf a{3}, b{5}, c{1};
+///     std::cout << arbxx::fma(a, b, c)(2, arbxx::Arf::Round::DOWN);
+///     // -> 16
+///
+template <typename A, typename B, typename C, typename = std::enable_if_t<std::disjunction_v<detail::is_arf<std::decay_t<A>>, detail::is_arf<std::decay_t<B>>, detail::is_arf<std::decay_t<C>>, detail::is_arf_expr<std::decay_t<A>>, detail::is_arf_expr<std::decay_t<B>>, detail::is_arf_expr<std::decay_t<C>>>>>
+auto fma(A&& a, B&& b, C&& c) {
+  using boost::yap::as_expr;
+  using boost::yap::make_expression;
+  return make_expression<ArfExpr, boost::yap::expr_kind::plus>(
+      make_expression<ArfExpr, boost::yap::expr_kind::multiplies>(as_expr<ArfExpr>(std::forward<A>(a)), as_expr<ArfExpr>(std::forward<B>(b))),
+      as_expr<ArfExpr>(std::forward<C>(c)));
+}
+
+/// ==* In-place Arithmetic with Expressions *==
+/// Replace `lhs` with the result of the operation, evaluating the right hand
+/// side with the working precision and rounding mode of the current thread,
+/// see [PrecisionScope]().
+/// A right hand side that is a product of two terminals is mapped to
+/// [arf_addmul]() and [arf_submul]() so that no temporary is created.
+///
+///     arbxx::Arf x{1}, y{2}, z{3};
+///     arbxx::PrecisionScope scope{256};
+///     x += y * z;
+///     std::cout << x;
+///     // -> 7
+///
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arf& operator+=(Arf& lhs, const ArfExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::plus>(lhs, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arf& operator-=(Arf& lhs, const ArfExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::minus>(lhs, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arf& operator*=(Arf& lhs, const ArfExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::multiplies>(lhs, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+}
+
+template <boost::yap::expr_kind Kind, typename Tuple>
+Arf& operator/=(Arf& lhs, const ArfExpr<Kind, Tuple>& rhs) {
+  return detail::compound<boost::yap::expr_kind::divides>(lhs, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+}
+
+BOOST_YAP_USER_UNARY_OPERATOR(negate, ArfExpr, ArfExpr)
+
+BOOST_YAP_USER_BINARY_OPERATOR(plus, ArfExpr, ArfExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(minus, ArfExpr, ArfExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(multiplies, ArfExpr, ArfExpr)
+BOOST_YAP_USER_BINARY_OPERATOR(divides, ArfExpr, ArfExpr)
+
+// Operators between an Arf and an Arf or integer …
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(plus, ArfExpr, detail::is_arf, detail::is_arf_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(minus, ArfExpr, detail::is_arf, detail::is_arf_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(multiplies, ArfExpr, detail::is_arf, detail::is_arf_operand)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(divides, ArfExpr, detail::is_arf, detail::is_arf_operand)
+
+// … and between an integer and an Arf.
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(plus, ArfExpr, detail::is_arb_scalar, detail::is_arf)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(minus, ArfExpr, detail::is_arb_scalar, detail::is_arf)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(multiplies, ArfExpr, detail::is_arb_scalar, detail::is_arf)
+BOOST_YAP_USER_UDT_UDT_BINARY_OPERATOR(divides, ArfExpr, detail::is_arb_scalar, detail::is_arf)
+
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,141 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "../arbxx/acb.hpp"
+#include "../arbxx/precision.hpp"
+#include "../arbxx/yap/acb.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+struct AcbBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State&) override { tester.reset(); }
+
+  Arb real(benchmark::State& state) { return tester.random(state.range(0), state.range(1)); }
+
+  Acb random(benchmark::State& state) { return Acb(real(state), real(state)); }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({53, 10});
+    b->Args({65536, 1024});
+  }
+
+  ArbTester tester;
+};
+
+// For comparison, the hand-rolled approach of keeping the real and imaginary
+// part as separate Arb elements and copying them into an acb_t.
+BENCHMARK_DEFINE_F(AcbBenchmark, Parts_C)
+(benchmark::State& state) {
+  Arb re = real(state), im = real(state);
+
+  for (auto _ : state) {
+    acb_t z;
+    acb_init(z);
+    acb_set_arb_arb(z, re.arb_t(), im.arb_t());
+    arb_set(re.arb_t(), acb_realref(z));
+    arb_set(im.arb_t(), acb_imagref(z));
+    acb_clear(z);
+  }
+}
+BENCHMARK_REGISTER_F(AcbBenchmark, Parts_C)->Apply(AcbBenchmark::BenchmarkedSizes);
+
+// The parts of an Acb are accessed without copying them.
+BENCHMARK_DEFINE_F(AcbBenchmark, Parts)
+(benchmark::State& state) {
+  Acb z = random(state);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(&z.real());
+    benchmark::DoNotOptimize(&z.imag());
+  }
+}
+BENCHMARK_REGISTER_F(AcbBenchmark, Parts)->Apply(AcbBenchmark::BenchmarkedSizes);
+
+// For comparison, multiplication by a real number that is first promoted to
+// an acb_t.
+BENCHMARK_DEFINE_F(AcbBenchmark, MultiplyReal_C)
+(benchmark::State& state) {
+  Acb x = random(state), y = random(state);
+  Arb r = real(state);
+
+  for (auto _ : state) {
+    Acb r_(r);
+    acb_mul(x.acb_t(), y.acb_t(), r_.acb_t(), 64);
+  }
+}
+BENCHMARK_REGISTER_F(AcbBenchmark, MultiplyReal_C)->Apply(AcbBenchmark::BenchmarkedSizes);
+
+// Expressions pass the real number to acb_mul_arb directly.
+BENCHMARK_DEFINE_F(AcbBenchmark, MultiplyReal)
+(benchmark::State& state) {
+  Acb x = random(state), y = random(state);
+  Arb r = real(state);
+
+  for (auto _ : state) {
+    x = (y * r)(64);
+  }
+}
+BENCHMARK_REGISTER_F(AcbBenchmark, MultiplyReal)->Apply(AcbBenchmark::BenchmarkedSizes);
+
+// For comparison, arithmetic with the C API
+BENCHMARK_DEFINE_F(AcbBenchmark, Arithmetic_C)
+(benchmark::State& state) {
+  Acb x = random(state), y = random(state), z = random(state);
+
+  for (auto _ : state) {
+    x = y;
+    acb_add(x.acb_t(), x.acb_t(), x.acb_t(), 64);
+    acb_addmul(x.acb_t(), y.acb_t(), z.acb_t(), 64);
+  }
+}
+BENCHMARK_REGISTER_F(AcbBenchmark, Arithmetic_C)->Apply(AcbBenchmark::BenchmarkedSizes);
+
+// The same with expression templates which map to acb_add and acb_addmul.
+BENCHMARK_DEFINE_F(AcbBenchmark, Arithmetic)
+(benchmark::State& state) {
+  Acb x = random(state), y = random(state), z = random(state);
+
+  for (auto _ : state) {
+    x = y;
+    x = (x + x + y * z)(64);
+  }
+}
+BENCHMARK_REGISTER_F(AcbBenchmark, Arithmetic)->Apply(AcbBenchmark::BenchmarkedSizes);
+
+// The same with in-place operators which do not create any temporaries.
+BENCHMARK_DEFINE_F(AcbBenchmark, Arithmetic_inplace)
+(benchmark::State& state) {
+  Acb x = random(state), y = random(state), z = random(state);
+
+  PrecisionScope scope(64);
+
+  for (auto _ : state) {
+    x = y;
+    x += x;
+    x += y * z;
+  }
+}
+BENCHMARK_REGISTER_F(AcbBenchmark, Arithmetic_inplace)->Apply(AcbBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
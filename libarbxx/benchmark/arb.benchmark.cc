@@ -20,7 +20,14 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cmath>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
 #include "../arbxx/arb.hpp"
+#include "../arbxx/precision.hpp"
+#include "../arbxx/yap/arb.hpp"
 #include "../test/arb.hpp"
 
 namespace arbxx::test {
@@ -163,4 +170,304 @@ BENCHMARK_DEFINE_F(ArbBenchmark, Arithmetic_C_optimized)
 }
 BENCHMARK_REGISTER_F(ArbBenchmark, Arithmetic_C_optimized)->Apply(ArbBenchmark::BenchmarkedSizes);
 
+// The same with expression templates, which should be as fast as the
+// optimized version above since x + x + y * z maps to arb_add and arb_addmul.
+BENCHMARK_DEFINE_F(ArbBenchmark, Arithmetic)
+(benchmark::State& state) {
+  Arb x = random(state), y = random(state), z = random(state);
+
+  for (auto _ : state) {
+    x = y;
+    x = (x + x + y * z)(64);
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Arithmetic)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+// The same with in-place operators which do not create any temporaries.
+BENCHMARK_DEFINE_F(ArbBenchmark, Arithmetic_inplace)
+(benchmark::State& state) {
+  Arb x = random(state), y = random(state), z = random(state);
+
+  PrecisionScope scope(64);
+
+  for (auto _ : state) {
+    x = y;
+    x += x;
+    x += y * z;
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Arithmetic_inplace)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+// Return an integer close to the midpoint of x if there is one that fits
+// into a long so that comparisons with it are not decided by the exponents
+// alone.
+long near(const Arb& x) {
+  const double midpoint = static_cast<double>(x);
+  return std::abs(midpoint) < 1e15 ? static_cast<long>(midpoint) : 0;
+}
+
+BENCHMARK_DEFINE_F(ArbBenchmark, Compare_long)
+(benchmark::State& state) {
+  Arb x = random(state);
+  const long y = near(x);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x < y);
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Compare_long)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBenchmark, Compare_mpz)
+(benchmark::State& state) {
+  Arb x = random(state);
+  const mpz_class y = near(x);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x < y);
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Compare_mpz)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+// Comparison with an integer that does not fit into two limbs.
+BENCHMARK_DEFINE_F(ArbBenchmark, Compare_mpz_large)
+(benchmark::State& state) {
+  Arb x = random(state);
+  const mpz_class y = (mpz_class(1) << 256) + 1;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x < y);
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Compare_mpz_large)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBenchmark, Compare_mpq)
+(benchmark::State& state) {
+  Arb x = random(state);
+  const mpq_class y(3 * near(x) + 1, 3);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(x < y);
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Compare_mpq)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+// For comparison, the same with the C API and an exact ball.
+BENCHMARK_DEFINE_F(ArbBenchmark, Compare_C)
+(benchmark::State& state) {
+  Arb x = random(state);
+  Arb y(near(x));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(arb_lt(x.arb_t(), y.arb_t()));
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Compare_C)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+// Constants are served from a cache; compare with Arb's own cache behind
+// arb_const_pi() which is per thread.
+BENCHMARK_DEFINE_F(ArbBenchmark, Pi)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb pi = Arb::pi(state.range(0));
+    benchmark::DoNotOptimize(pi);
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Pi)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBenchmark, Pi_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb pi;
+    arb_const_pi(pi.arb_t(), state.range(0));
+    benchmark::DoNotOptimize(pi);
+  }
+}
+BENCHMARK_REGISTER_F(ArbBenchmark, Pi_C)->Apply(ArbBenchmark::BenchmarkedSizes);
+
+// Elementary functions through expressions compared to the corresponding
+// calls into the C API.
+struct FunctionBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    x = Arb(mpq_class(1, 3), state.range(0));
+    y = Arb(mpq_class(2, 3), state.range(0));
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({64});
+    b->Args({256});
+    b->Args({4096});
+  }
+
+  Arb x, y;
+};
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, Exp)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z = exp(x)(state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, Exp)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, Exp_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z;
+    arb_exp(z.arb_t(), x.arb_t(), state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, Exp_C)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, ExpOfSum)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z = exp(x + y)(state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, ExpOfSum)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, ExpOfSum_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z;
+    arb_add(z.arb_t(), x.arb_t(), y.arb_t(), state.range(0));
+    arb_exp(z.arb_t(), z.arb_t(), state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, ExpOfSum_C)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, ExpMinusOne)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z = (exp(x) - 1)(state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, ExpMinusOne)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, ExpMinusOne_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z;
+    arb_expm1(z.arb_t(), x.arb_t(), state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, ExpMinusOne_C)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, Atan2)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z = atan2(y, x)(state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, Atan2)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, Atan2_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb z;
+    arb_atan2(z.arb_t(), y.arb_t(), x.arb_t(), state.range(0));
+    benchmark::DoNotOptimize(z);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, Atan2_C)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+// Computing the sine and the cosine separately costs about twice as much as
+// the fused sin_cos().
+BENCHMARK_DEFINE_F(FunctionBenchmark, SinAndCos)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb s = sin(x)(state.range(0));
+    Arb c = cos(x)(state.range(0));
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(c);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, SinAndCos)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, SinCos)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    auto sc = sin_cos(x, state.range(0));
+    benchmark::DoNotOptimize(sc);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, SinCos)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(FunctionBenchmark, SinCos_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb s, c;
+    arb_sin_cos(s.arb_t(), c.arb_t(), x.arb_t(), state.range(0));
+    benchmark::DoNotOptimize(s);
+    benchmark::DoNotOptimize(c);
+  }
+}
+BENCHMARK_REGISTER_F(FunctionBenchmark, SinCos_C)->Apply(FunctionBenchmark::BenchmarkedSizes);
+
+// Hashing of elements that all agree in their first 53 bits, i.e., that would
+// collide if only a double approximation was hashed.
+struct HashBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    arfs.clear();
+    arbs.clear();
+    for (int i = 0; i < state.range(0); i++) {
+      arfs.push_back(Arf((mpz_class(1) << 200) + i, -200));
+      arbs.push_back(Arb(std::pair{arfs.back(), arfs.back()}));
+    }
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1024);
+    b->Arg(65536);
+  }
+
+  std::vector<Arf> arfs;
+  std::vector<Arb> arbs;
+};
+
+BENCHMARK_DEFINE_F(HashBenchmark, Hash_Arf)
+(benchmark::State& state) {
+  const std::hash<Arf> hash;
+  for (auto _ : state) {
+    for (const auto& x : arfs)
+      benchmark::DoNotOptimize(hash(x));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(HashBenchmark, Hash_Arf)->Apply(HashBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(HashBenchmark, Hash_Arb)
+(benchmark::State& state) {
+  const std::hash<Arb> hash;
+  for (auto _ : state) {
+    for (const auto& x : arbs)
+      benchmark::DoNotOptimize(hash(x));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(HashBenchmark, Hash_Arb)->Apply(HashBenchmark::BenchmarkedSizes);
+
+// Inserting into a hash set degrades to quadratic runtime if the hash
+// collides for all the elements.
+BENCHMARK_DEFINE_F(HashBenchmark, UnorderedSet_Arf)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    std::unordered_set<Arf> set(arfs.begin(), arfs.end());
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(HashBenchmark, UnorderedSet_Arf)->Apply(HashBenchmark::BenchmarkedSizes);
+
 }  // namespace arbxx::test
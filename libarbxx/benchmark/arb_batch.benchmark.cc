@@ -0,0 +1,123 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../arbxx/arb_batch.hpp"
+#include "../arbxx/arb_vector.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Compares the vectorized kernels of ArbBatch with the corresponding calls
+// into Arb at 53 bits of precision. The argument is the number of elements.
+struct ArbBatchBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+
+    std::vector<Arb> x, y;
+    for (size i = 0; i < state.range(0); i++) {
+      x.push_back(tester.random(53));
+      y.push_back(tester.random(53));
+    }
+
+    vx = ArbVector{x};
+    vy = ArbVector{y};
+    bx = ArbBatch{x};
+    by = ArbBatch{y};
+
+    state.SetLabel(ArbBatch::kernels());
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1024);
+    b->Arg(65536);
+  }
+
+  ArbTester tester;
+
+  ArbVector vx, vy;
+  ArbBatch bx, by;
+};
+
+BENCHMARK_DEFINE_F(ArbBatchBenchmark, Add_ArbVector)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    vx.add(vy, 53);
+    benchmark::DoNotOptimize(vx.arb_ptr());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArbBatchBenchmark, Add_ArbVector)->Apply(ArbBatchBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBatchBenchmark, Add_ArbBatch)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    bx.add(by);
+    benchmark::DoNotOptimize(bx.midpoints());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArbBatchBenchmark, Add_ArbBatch)->Apply(ArbBatchBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBatchBenchmark, Mul_ArbVector)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    vx.mul(vy, 53);
+    benchmark::DoNotOptimize(vx.arb_ptr());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArbBatchBenchmark, Mul_ArbVector)->Apply(ArbBatchBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBatchBenchmark, Mul_ArbBatch)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    bx.mul(by);
+    benchmark::DoNotOptimize(bx.midpoints());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArbBatchBenchmark, Mul_ArbBatch)->Apply(ArbBatchBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBatchBenchmark, Compare_Arb)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    size less = 0;
+    for (size i = 0; i < vx.size(); i++)
+      less += arb_lt(vx[i].arb_t(), vy[i].arb_t());
+    benchmark::DoNotOptimize(less);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArbBatchBenchmark, Compare_Arb)->Apply(ArbBatchBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbBatchBenchmark, Compare_ArbBatch)
+(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(bx.lt(by));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ArbBatchBenchmark, Compare_ArbBatch)->Apply(ArbBatchBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
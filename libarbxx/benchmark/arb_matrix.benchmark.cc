@@ -0,0 +1,100 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <flint/flintxx/frandxx.h>
+
+#include "../arbxx/arb_matrix.hpp"
+#include "../arbxx/threads.hpp"
+
+namespace arbxx::test {
+
+// The arguments are the dimension of the square matrices, their precision,
+// and the number of threads.
+struct ArbMatrixBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    flint::frandxx rand;
+    A = ArbMatrix::randtest(rand, state.range(0), state.range(0), state.range(1), 10);
+    B = ArbMatrix::randtest(rand, state.range(0), state.range(0), state.range(1), 10);
+    for (size i = 0; i < state.range(0); i++)
+      arb_add_si(A(i, i).arb_t(), A(i, i).arb_t(), 4 * state.range(0), state.range(1));
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    for (int threads : {1, 4})
+      for (int prec : {128, 1024})
+        b->Args({128, prec, threads});
+  }
+
+  ArbMatrix A, B;
+};
+
+BENCHMARK_DEFINE_F(ArbMatrixBenchmark, Mul_classical)
+(benchmark::State& state) {
+  ThreadScope threads(state.range(2));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.mul(B, state.range(1), ArbMatrix::Algorithm::CLASSICAL));
+  }
+}
+BENCHMARK_REGISTER_F(ArbMatrixBenchmark, Mul_classical)->Apply(ArbMatrixBenchmark::BenchmarkedSizes)->UseRealTime();
+
+BENCHMARK_DEFINE_F(ArbMatrixBenchmark, Mul_threaded)
+(benchmark::State& state) {
+  ThreadScope threads(state.range(2));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.mul(B, state.range(1), ArbMatrix::Algorithm::THREADED));
+  }
+}
+BENCHMARK_REGISTER_F(ArbMatrixBenchmark, Mul_threaded)->Apply(ArbMatrixBenchmark::BenchmarkedSizes)->UseRealTime();
+
+BENCHMARK_DEFINE_F(ArbMatrixBenchmark, Mul_block)
+(benchmark::State& state) {
+  ThreadScope threads(state.range(2));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.mul(B, state.range(1), ArbMatrix::Algorithm::BLOCK));
+  }
+}
+BENCHMARK_REGISTER_F(ArbMatrixBenchmark, Mul_block)->Apply(ArbMatrixBenchmark::BenchmarkedSizes)->UseRealTime();
+
+BENCHMARK_DEFINE_F(ArbMatrixBenchmark, Solve)
+(benchmark::State& state) {
+  ThreadScope threads(state.range(2));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.solve(B, state.range(1)));
+  }
+}
+BENCHMARK_REGISTER_F(ArbMatrixBenchmark, Solve)->Apply(ArbMatrixBenchmark::BenchmarkedSizes)->UseRealTime();
+
+BENCHMARK_DEFINE_F(ArbMatrixBenchmark, Det)
+(benchmark::State& state) {
+  ThreadScope threads(state.range(2));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(A.det(state.range(1)));
+  }
+}
+BENCHMARK_REGISTER_F(ArbMatrixBenchmark, Det)->Apply(ArbMatrixBenchmark::BenchmarkedSizes)->UseRealTime();
+
+}  // namespace arbxx::test
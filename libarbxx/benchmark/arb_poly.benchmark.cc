@@ -0,0 +1,94 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <flint/flintxx/frandxx.h>
+
+#include <vector>
+
+#include "../arbxx/arb_poly.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// The arguments are the length of the polynomial and the number of points
+// at which it is evaluated. All computations happen at 128 bits.
+struct ArbPolyBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    flint::frandxx rand;
+    f = ArbPoly::randtest(rand, state.range(0), 128, 4);
+
+    tester.reset();
+    x.clear();
+    for (int i = 0; i < state.range(1); i++)
+      x.push_back(tester.random(128, 2));
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    for (int length : {8, 64, 512, 4096})
+      for (int points : {16, 256, 4096})
+        b->Args({length, points});
+  }
+
+  ArbTester tester;
+  ArbPoly f;
+  std::vector<Arb> x;
+};
+
+// One call to arb_poly_evaluate() for each point.
+BENCHMARK_DEFINE_F(ArbPolyBenchmark, Evaluate)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    for (const auto& xi : x)
+      benchmark::DoNotOptimize(f.evaluate(xi, 128));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_REGISTER_F(ArbPolyBenchmark, Evaluate)->Apply(ArbPolyBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbPolyBenchmark, EvaluateHorner)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f.evaluate(x, 128, ArbPoly::Algorithm::HORNER));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_REGISTER_F(ArbPolyBenchmark, EvaluateHorner)->Apply(ArbPolyBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbPolyBenchmark, EvaluateFast)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f.evaluate(x, 128, ArbPoly::Algorithm::FAST));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_REGISTER_F(ArbPolyBenchmark, EvaluateFast)->Apply(ArbPolyBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbPolyBenchmark, EvaluateAutomatic)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f.evaluate(x, 128));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_REGISTER_F(ArbPolyBenchmark, EvaluateAutomatic)->Apply(ArbPolyBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
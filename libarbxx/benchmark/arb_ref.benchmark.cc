@@ -0,0 +1,70 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "../arbxx/arb_ref.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Compares reading borrowed elements through a view with copying them into
+// an Arb first.
+struct ArbRefBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+    x = _arb_vec_init(1);
+    arb_set(x, tester.random(state.range(0), state.range(1)).arb_t());
+  }
+
+  void TearDown(const benchmark::State& state) override { TearDown(const_cast<benchmark::State&>(state)); }
+
+  void TearDown(benchmark::State&) override { _arb_vec_clear(x, 1); }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({53, 10});
+    b->Args({65536, 1024});
+  }
+
+  ArbTester tester;
+  arb_ptr x;
+};
+
+BENCHMARK_DEFINE_F(ArbRefBenchmark, CompareCopy)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb y;
+    arb_set(y.arb_t(), x);
+    benchmark::DoNotOptimize(y < 0);
+  }
+}
+BENCHMARK_REGISTER_F(ArbRefBenchmark, CompareCopy)->Apply(ArbRefBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbRefBenchmark, CompareRef)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    ArbCRef y{x};
+    benchmark::DoNotOptimize(y < 0);
+  }
+}
+BENCHMARK_REGISTER_F(ArbRefBenchmark, CompareRef)->Apply(ArbRefBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
@@ -0,0 +1,160 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../arbxx/arb_vector.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Compares ArbVector with a std::vector<Arb>. The arguments are the length of
+// the vectors and the precision of the random entries.
+struct ArbVectorBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+
+    x.clear();
+    y.clear();
+    for (size i = 0; i < state.range(0); i++) {
+      x.push_back(tester.random(state.range(1)));
+      y.push_back(tester.random(state.range(1)));
+    }
+
+    X = ArbVector(x);
+    Y = ArbVector(y);
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({16, 64});
+    b->Args({1024, 64});
+    b->Args({1024, 1024});
+  }
+
+  ArbTester tester;
+
+  std::vector<Arb> x, y;
+  ArbVector X, Y;
+};
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, Create_std)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<Arb> v(state.range(0));
+    benchmark::DoNotOptimize(v.data());
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, Create_std)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, Create)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    ArbVector v(state.range(0));
+    benchmark::DoNotOptimize(v.arb_ptr());
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, Create)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, Add_std)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); i++)
+      arb_add(x[i].arb_t(), x[i].arb_t(), y[i].arb_t(), 64);
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, Add_std)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, Add)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    X.add(Y, 64);
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, Add)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, ScalarMul_std)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    for (auto& v : x)
+      arb_mul(v.arb_t(), v.arb_t(), y[0].arb_t(), 64);
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, ScalarMul_std)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, ScalarMul)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    X.scalar_mul(Y[0], 64);
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, ScalarMul)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, Dot_std)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb dot;
+    for (size_t i = 0; i < x.size(); i++)
+      arb_addmul(dot.arb_t(), x[i].arb_t(), y[i].arb_t(), 64);
+    benchmark::DoNotOptimize(dot);
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, Dot_std)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, Dot)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(X.dot(Y, 64));
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, Dot)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, Sum)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(X.sum(64));
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, Sum)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, ToDouble_std)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<double> d;
+    d.reserve(x.size());
+    for (const auto& v : x)
+      d.push_back(static_cast<double>(v));
+    benchmark::DoNotOptimize(d.data());
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, ToDouble_std)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbVectorBenchmark, ToDouble)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    auto d = static_cast<std::vector<double>>(X);
+    benchmark::DoNotOptimize(d.data());
+  }
+}
+BENCHMARK_REGISTER_F(ArbVectorBenchmark, ToDouble)->Apply(ArbVectorBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
@@ -0,0 +1,155 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../arbxx/arbp.hpp"
+#include "../arbxx/yap/arb.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Compares arithmetic on ArbP<64> and ArbP<128> with arithmetic on Arb with
+// the same working precision. The arguments are the number of elements in
+// each loop and the precision.
+struct ArbPBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+
+    x.clear();
+    y.clear();
+    for (size i = 0; i < state.range(0); i++) {
+      x.push_back(tester.random(state.range(1)));
+      y.push_back(tester.random(state.range(1)));
+    }
+  }
+
+  template <typename T>
+  static std::vector<T> convert(const std::vector<Arb>& values) {
+    std::vector<T> ret;
+    for (const auto& value : values)
+      ret.emplace_back(value);
+    return ret;
+  }
+
+  static void BenchmarkedSizes64(benchmark::internal::Benchmark* b) { b->Args({1024, 64}); }
+
+  static void BenchmarkedSizes128(benchmark::internal::Benchmark* b) { b->Args({1024, 128}); }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    BenchmarkedSizes64(b);
+    BenchmarkedSizes128(b);
+  }
+
+  ArbTester tester;
+
+  std::vector<Arb> x, y;
+};
+
+template <typename T>
+void add(benchmark::State& state, const std::vector<T>& x, const std::vector<T>& y) {
+  for (auto _ : state) {
+    T sum;
+    for (size_t i = 0; i < x.size(); i++) {
+      sum += x[i];
+      sum += y[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+template <typename T>
+void mul(benchmark::State& state, const std::vector<T>& x, const std::vector<T>& y) {
+  std::vector<T> z(x.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); i++)
+      z[i] = x[i] * y[i];
+    benchmark::DoNotOptimize(z.data());
+  }
+}
+
+template <typename T>
+void compare(benchmark::State& state, const std::vector<T>& x, const std::vector<T>& y) {
+  for (auto _ : state) {
+    size_t less = 0;
+    for (size_t i = 0; i < x.size(); i++)
+      less += (x[i] < y[i]).value_or(false);
+    benchmark::DoNotOptimize(less);
+  }
+}
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Add_Arb)
+(benchmark::State& state) {
+  const prec prec = state.range(1);
+  for (auto _ : state) {
+    Arb sum;
+    for (size_t i = 0; i < x.size(); i++) {
+      arb_add(sum.arb_t(), sum.arb_t(), x[i].arb_t(), prec);
+      arb_add(sum.arb_t(), sum.arb_t(), y[i].arb_t(), prec);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+BENCHMARK_REGISTER_F(ArbPBenchmark, Add_Arb)->Apply(ArbPBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Add_ArbP64)
+(benchmark::State& state) { add(state, convert<ArbP<64>>(x), convert<ArbP<64>>(y)); }
+BENCHMARK_REGISTER_F(ArbPBenchmark, Add_ArbP64)->Apply(ArbPBenchmark::BenchmarkedSizes64);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Add_ArbP128)
+(benchmark::State& state) { add(state, convert<ArbP<128>>(x), convert<ArbP<128>>(y)); }
+BENCHMARK_REGISTER_F(ArbPBenchmark, Add_ArbP128)->Apply(ArbPBenchmark::BenchmarkedSizes128);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Mul_Arb)
+(benchmark::State& state) {
+  const prec prec = state.range(1);
+  std::vector<Arb> z(x.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); i++)
+      z[i] = (x[i] * y[i])(prec);
+    benchmark::DoNotOptimize(z.data());
+  }
+}
+BENCHMARK_REGISTER_F(ArbPBenchmark, Mul_Arb)->Apply(ArbPBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Mul_ArbP64)
+(benchmark::State& state) { mul(state, convert<ArbP<64>>(x), convert<ArbP<64>>(y)); }
+BENCHMARK_REGISTER_F(ArbPBenchmark, Mul_ArbP64)->Apply(ArbPBenchmark::BenchmarkedSizes64);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Mul_ArbP128)
+(benchmark::State& state) { mul(state, convert<ArbP<128>>(x), convert<ArbP<128>>(y)); }
+BENCHMARK_REGISTER_F(ArbPBenchmark, Mul_ArbP128)->Apply(ArbPBenchmark::BenchmarkedSizes128);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Compare_Arb)
+(benchmark::State& state) { compare(state, x, y); }
+BENCHMARK_REGISTER_F(ArbPBenchmark, Compare_Arb)->Apply(ArbPBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Compare_ArbP64)
+(benchmark::State& state) { compare(state, convert<ArbP<64>>(x), convert<ArbP<64>>(y)); }
+BENCHMARK_REGISTER_F(ArbPBenchmark, Compare_ArbP64)->Apply(ArbPBenchmark::BenchmarkedSizes64);
+
+BENCHMARK_DEFINE_F(ArbPBenchmark, Compare_ArbP128)
+(benchmark::State& state) { compare(state, convert<ArbP<128>>(x), convert<ArbP<128>>(y)); }
+BENCHMARK_REGISTER_F(ArbPBenchmark, Compare_ArbP128)->Apply(ArbPBenchmark::BenchmarkedSizes128);
+
+}  // namespace arbxx::test
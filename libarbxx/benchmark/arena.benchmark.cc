@@ -0,0 +1,107 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <flint/flint.h>
+
+#include "../arbxx/arena.hpp"
+#include "../arbxx/precision.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Evaluates an expression that creates temporaries with and without an
+// arena. The argument is the precision.
+struct ArenaBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+    x = tester.random(state.range(0));
+    y = tester.random(state.range(0));
+  }
+
+  // Compute (x*y + x) / y with a temporary for each intermediate result.
+  Arb temporaries(prec prec) const {
+    Arb xy;
+    arb_mul(xy.arb_t(), x.arb_t(), y.arb_t(), prec);
+    Arb sum;
+    arb_add(sum.arb_t(), xy.arb_t(), x.arb_t(), prec);
+    Arb ret;
+    arb_div(ret.arb_t(), sum.arb_t(), y.arb_t(), prec);
+    return ret;
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(256);
+    b->Arg(4096);
+    b->Arg(65536);
+  }
+
+  ArbTester tester;
+  Arb x, y;
+};
+
+BENCHMARK_DEFINE_F(ArenaBenchmark, Temporaries)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(temporaries(state.range(0)));
+  }
+}
+BENCHMARK_REGISTER_F(ArenaBenchmark, Temporaries)->Apply(ArenaBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArenaBenchmark, Temporaries_arena)
+(benchmark::State& state) {
+  Arena arena;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(temporaries(state.range(0)));
+  }
+}
+BENCHMARK_REGISTER_F(ArenaBenchmark, Temporaries_arena)->Apply(ArenaBenchmark::BenchmarkedSizes);
+
+// The same computation in an arena that only lives for a single iteration.
+BENCHMARK_DEFINE_F(ArenaBenchmark, Temporaries_arena_scoped)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arena arena;
+    benchmark::DoNotOptimize(temporaries(state.range(0)));
+  }
+}
+BENCHMARK_REGISTER_F(ArenaBenchmark, Temporaries_arena_scoped)->Apply(ArenaBenchmark::BenchmarkedSizes);
+
+// Allocate and free memory outside of an arena in several threads while
+// another arena's chunk is alive so that every free has to consult the
+// registry of all chunks.
+static void ArenaBenchmark_Foreign_free(benchmark::State& state) {
+  // An element that outlives its arena and keeps a chunk registered.
+  static const Arb survivor = []() {
+    Arena arena;
+    return Arb(mpq_class(1, 3), 4096);
+  }();
+  benchmark::DoNotOptimize(survivor);
+
+  for (auto _ : state) {
+    void* ptr = flint_malloc(64);
+    benchmark::DoNotOptimize(ptr);
+    flint_free(ptr);
+  }
+}
+BENCHMARK(ArenaBenchmark_Foreign_free)->ThreadRange(1, 8);
+
+}  // namespace arbxx::test
@@ -0,0 +1,117 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "../arbxx/arf.hpp"
+#include "../arbxx/yap/arf.hpp"
+#include "../test/arf.hpp"
+
+namespace arbxx::test {
+
+// Compares Arf expressions with the corresponding calls into Arb's C API. The
+// arguments are the precision of the random operands and the working
+// precision.
+struct ArfBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+
+    a = tester.random(state.range(0));
+    b = tester.random(state.range(0));
+    c = tester.random(state.range(0));
+    d = tester.random(state.range(0));
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({53, 53});
+    b->Args({256, 64});
+    b->Args({4096, 4096});
+  }
+
+  ArfTester tester;
+
+  Arf a, b, c, d;
+};
+
+BENCHMARK_DEFINE_F(ArfBenchmark, Fma_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arf x;
+    arf_fma(x.arf_t(), a.arf_t(), b.arf_t(), c.arf_t(), state.range(1), ARF_RND_DOWN);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK_REGISTER_F(ArfBenchmark, Fma_C)->Apply(ArfBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArfBenchmark, Fma)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arf x = (a * b + c)(state.range(1), Arf::Round::DOWN);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK_REGISTER_F(ArfBenchmark, Fma)->Apply(ArfBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArfBenchmark, Sum_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arf x;
+    arf_struct terms[4];
+    terms[0] = *a.arf_t();
+    terms[1] = *b.arf_t();
+    arf_init_neg_shallow(&terms[2], c.arf_t());
+    terms[3] = *d.arf_t();
+    arf_sum(x.arf_t(), terms, 4, state.range(1), ARF_RND_DOWN);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK_REGISTER_F(ArfBenchmark, Sum_C)->Apply(ArfBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArfBenchmark, Sum)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arf x = (a + b - c + d)(state.range(1), Arf::Round::DOWN);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK_REGISTER_F(ArfBenchmark, Sum)->Apply(ArfBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArfBenchmark, Nested_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arf x;
+    arf_div(x.arf_t(), a.arf_t(), b.arf_t(), state.range(1), ARF_RND_DOWN);
+    arf_addmul(x.arf_t(), c.arf_t(), d.arf_t(), state.range(1), ARF_RND_DOWN);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK_REGISTER_F(ArfBenchmark, Nested_C)->Apply(ArfBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ArfBenchmark, Nested)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arf x = (a / b + c * d)(state.range(1), Arf::Round::DOWN);
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK_REGISTER_F(ArfBenchmark, Nested)->Apply(ArfBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
@@ -0,0 +1,104 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/json.hpp>
+#include <cereal/types/vector.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../arbxx/cereal.hpp"
+
+namespace arbxx::test {
+
+// Saves and loads 256 elements of the precision given as the argument. The
+// throughput is reported in bytes of the archive per second.
+struct CerealBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    values.clear();
+    for (int i = 0; i < 256; i++)
+      values.push_back(Arb(mpq_class(1, 3 + 2 * i), state.range(0)));
+  }
+
+  template <typename OutputArchive>
+  std::string save() const {
+    std::stringstream s;
+    {
+      OutputArchive archive(s);
+      archive(values);
+    }
+    return s.str();
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(64);
+    b->Arg(65536);
+  }
+
+  std::vector<Arb> values;
+};
+
+BENCHMARK_DEFINE_F(CerealBenchmark, Save_binary)
+(benchmark::State& state) {
+  size_t bytes = 0;
+  for (auto _ : state)
+    bytes += save<cereal::BinaryOutputArchive>().size();
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK_REGISTER_F(CerealBenchmark, Save_binary)->Apply(CerealBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(CerealBenchmark, Load_binary)
+(benchmark::State& state) {
+  const std::string serialized = save<cereal::BinaryOutputArchive>();
+  for (auto _ : state) {
+    std::stringstream s(serialized);
+    cereal::BinaryInputArchive archive(s);
+    archive(values);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(serialized.size()));
+}
+BENCHMARK_REGISTER_F(CerealBenchmark, Load_binary)->Apply(CerealBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(CerealBenchmark, Save_json)
+(benchmark::State& state) {
+  size_t bytes = 0;
+  for (auto _ : state)
+    bytes += save<cereal::JSONOutputArchive>().size();
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK_REGISTER_F(CerealBenchmark, Save_json)->Apply(CerealBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(CerealBenchmark, Load_json)
+(benchmark::State& state) {
+  const std::string serialized = save<cereal::JSONOutputArchive>();
+  for (auto _ : state) {
+    std::stringstream s(serialized);
+    cereal::JSONInputArchive archive(s);
+    archive(values);
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(serialized.size()));
+}
+BENCHMARK_REGISTER_F(CerealBenchmark, Load_json)->Apply(CerealBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
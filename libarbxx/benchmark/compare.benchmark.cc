@@ -0,0 +1,102 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../arbxx/compare.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Compares comparing many elements at once with calling operator< for each
+// pair. The arguments are the number of elements and their precision.
+struct CompareBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+
+    x.clear();
+    y.clear();
+    for (size i = 0; i < state.range(0); i++) {
+      x.push_back(tester.random(state.range(1)));
+      y.push_back(tester.random(state.range(1)));
+    }
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({1024, 53});
+    b->Args({65536, 53});
+    b->Args({1024, 1024});
+  }
+
+  ArbTester tester;
+
+  std::vector<Arb> x, y;
+};
+
+BENCHMARK_DEFINE_F(CompareBenchmark, Compare_Arb)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    size less = 0, undecided = 0;
+    for (size_t i = 0; i < x.size(); i++) {
+      const auto lt = x[i] < y[i];
+      if (!lt)
+        undecided++;
+      else
+        less += *lt;
+    }
+    benchmark::DoNotOptimize(less);
+    benchmark::DoNotOptimize(undecided);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(CompareBenchmark, Compare_Arb)->Apply(CompareBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(CompareBenchmark, Compare_Batched)
+(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(compare(x, y));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(CompareBenchmark, Compare_Batched)->Apply(CompareBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(CompareBenchmark, Compare_long)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    size less = 0;
+    for (size_t i = 0; i < x.size(); i++)
+      less += (x[i] < 1L).value_or(false);
+    benchmark::DoNotOptimize(less);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(CompareBenchmark, Compare_long)->Apply(CompareBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(CompareBenchmark, Compare_long_Batched)
+(benchmark::State& state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(compare(x, 1L));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(CompareBenchmark, Compare_long_Batched)->Apply(CompareBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
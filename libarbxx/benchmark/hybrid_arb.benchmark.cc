@@ -0,0 +1,113 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../arbxx/hybrid_arb.hpp"
+#include "../arbxx/yap/arb.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Compares arithmetic on HybridArb with arithmetic on Arb at the precision
+// of a double. The argument is the number of elements in each loop.
+struct HybridArbBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+
+    x.clear();
+    y.clear();
+    hx.clear();
+    hy.clear();
+    for (size i = 0; i < state.range(0); i++) {
+      x.push_back(tester.random(53));
+      y.push_back(tester.random(53));
+      hx.emplace_back(x.back());
+      hy.emplace_back(y.back());
+    }
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1024);
+    b->Arg(65536);
+  }
+
+  ArbTester tester;
+
+  std::vector<Arb> x, y;
+  std::vector<HybridArb> hx, hy;
+};
+
+BENCHMARK_DEFINE_F(HybridArbBenchmark, Add_Arb)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb sum;
+    for (size_t i = 0; i < x.size(); i++) {
+      arb_add(sum.arb_t(), sum.arb_t(), x[i].arb_t(), 53);
+      arb_add(sum.arb_t(), sum.arb_t(), y[i].arb_t(), 53);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(HybridArbBenchmark, Add_Arb)->Apply(HybridArbBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(HybridArbBenchmark, Add_HybridArb)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    HybridArb sum;
+    for (size_t i = 0; i < hx.size(); i++) {
+      sum += hx[i];
+      sum += hy[i];
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(HybridArbBenchmark, Add_HybridArb)->Apply(HybridArbBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(HybridArbBenchmark, Mul_Arb)
+(benchmark::State& state) {
+  std::vector<Arb> z(x.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < x.size(); i++)
+      arb_mul(z[i].arb_t(), x[i].arb_t(), y[i].arb_t(), 53);
+    benchmark::DoNotOptimize(z.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(HybridArbBenchmark, Mul_Arb)->Apply(HybridArbBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(HybridArbBenchmark, Mul_HybridArb)
+(benchmark::State& state) {
+  std::vector<HybridArb> z(hx.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < hx.size(); i++)
+      z[i] = hx[i] * hy[i];
+    benchmark::DoNotOptimize(z.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(HybridArbBenchmark, Mul_HybridArb)->Apply(HybridArbBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
@@ -0,0 +1,111 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "../arbxx/interval_index.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Ordering and searching many random balls. The argument is the number of
+// balls.
+struct IntervalIndexBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+    x.clear();
+    for (int i = 0; i < state.range(0); i++)
+      x.push_back(tester.random(64));
+    y = tester.random(64);
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Arg(1 << 10);
+    b->Arg(1 << 16);
+  }
+
+  ArbTester tester;
+  std::vector<Arb> x;
+  Arb y;
+};
+
+// Sort by midpoint which is what callers had to do without interval_sort().
+BENCHMARK_DEFINE_F(IntervalIndexBenchmark, SortMidpoint)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto z = x;
+    state.ResumeTiming();
+    std::sort(z.begin(), z.end(), [](const Arb& lhs, const Arb& rhs) { return arf_cmp(arb_midref(lhs.arb_t()), arb_midref(rhs.arb_t())) < 0; });
+    benchmark::DoNotOptimize(z.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(IntervalIndexBenchmark, SortMidpoint)->Apply(IntervalIndexBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(IntervalIndexBenchmark, SortAndCluster)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto z = x;
+    state.ResumeTiming();
+    interval_sort(z);
+    benchmark::DoNotOptimize(interval_clusters(z));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(IntervalIndexBenchmark, SortAndCluster)->Apply(IntervalIndexBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(IntervalIndexBenchmark, Build)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IntervalIndex{x});
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(IntervalIndexBenchmark, Build)->Apply(IntervalIndexBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(IntervalIndexBenchmark, Overlapping)
+(benchmark::State& state) {
+  const IntervalIndex index{x};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.overlapping(y));
+  }
+}
+BENCHMARK_REGISTER_F(IntervalIndexBenchmark, Overlapping)->Apply(IntervalIndexBenchmark::BenchmarkedSizes);
+
+// A linear scan with arb_overlaps() for comparison.
+BENCHMARK_DEFINE_F(IntervalIndexBenchmark, Overlapping_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<::arbxx::size> found;
+    for (size_t i = 0; i < x.size(); i++)
+      if (arb_overlaps(x[i].arb_t(), y.arb_t()))
+        found.push_back(static_cast<::arbxx::size>(i));
+    benchmark::DoNotOptimize(found.data());
+  }
+}
+BENCHMARK_REGISTER_F(IntervalIndexBenchmark, Overlapping_C)->Apply(IntervalIndexBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
@@ -0,0 +1,99 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/vector.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../arbxx/cereal.hpp"
+#include "../arbxx/mapped_arb_array.hpp"
+
+namespace arbxx::test {
+
+// Compares reopening an array of Arb elements from a mapped file with
+// loading it from a binary cereal archive. The arguments are the number of
+// elements and their precision.
+struct MappedArbArrayBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    std::vector<Arb> values;
+    for (int i = 0; i < state.range(0); i++)
+      values.push_back(Arb(mpq_class(1, 3 + 2 * i), state.range(1)));
+
+    MappedArbArray::write(mapped, values);
+
+    std::ofstream out(archive, std::ios::binary);
+    cereal::BinaryOutputArchive serializer(out);
+    serializer(values);
+  }
+
+  void TearDown(const benchmark::State&) override {
+    std::filesystem::remove(mapped);
+    std::filesystem::remove(archive);
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({65536, 64});
+    b->Args({1024, 65536});
+  }
+
+  const std::filesystem::path mapped = std::filesystem::temp_directory_path() / ("arbxx-benchmark-" + std::to_string(::getpid()) + ".arbs");
+  const std::filesystem::path archive = std::filesystem::temp_directory_path() / ("arbxx-benchmark-" + std::to_string(::getpid()) + ".cereal");
+};
+
+BENCHMARK_DEFINE_F(MappedArbArrayBenchmark, Open_cereal)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<Arb> values;
+    std::ifstream in(archive, std::ios::binary);
+    cereal::BinaryInputArchive deserializer(in);
+    deserializer(values);
+    benchmark::DoNotOptimize(values.data());
+  }
+}
+BENCHMARK_REGISTER_F(MappedArbArrayBenchmark, Open_cereal)->Apply(MappedArbArrayBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(MappedArbArrayBenchmark, Open)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    MappedArbArray array(mapped);
+    benchmark::DoNotOptimize(&array[0]);
+  }
+}
+BENCHMARK_REGISTER_F(MappedArbArrayBenchmark, Open)->Apply(MappedArbArrayBenchmark::BenchmarkedSizes);
+
+// Open the mapped file and access every element once.
+BENCHMARK_DEFINE_F(MappedArbArrayBenchmark, OpenAndRead)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    MappedArbArray array(mapped);
+    for (size i = 0; i < array.size(); i++)
+      benchmark::DoNotOptimize(arb_is_exact(array[i].arb_t()));
+  }
+}
+BENCHMARK_REGISTER_F(MappedArbArrayBenchmark, OpenAndRead)->Apply(MappedArbArrayBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
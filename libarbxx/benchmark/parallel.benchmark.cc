@@ -0,0 +1,91 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "../arbxx/parallel.hpp"
+#include "../arbxx/threads.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Strong scaling of the parallel reductions, i.e., a fixed amount of work is
+// distributed over an increasing number of threads.
+struct ParallelBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+    x.clear();
+    y.clear();
+    for (int i = 0; i < state.range(1); i++) {
+      x.push_back(tester.random(state.range(0)));
+      y.push_back(tester.random(state.range(0)));
+    }
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= cores; threads *= 2)
+      for (const int precision : {64, 1024})
+        b->Args({precision, 1 << 20, threads});
+    b->UseRealTime();
+  }
+
+  ArbTester tester;
+  std::vector<Arb> x, y;
+};
+
+BENCHMARK_DEFINE_F(ParallelBenchmark, Sum)
+(benchmark::State& state) {
+  ThreadScope scope{static_cast<int>(state.range(2))};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parallel::sum(x, state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_REGISTER_F(ParallelBenchmark, Sum)->Apply(ParallelBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ParallelBenchmark, Dot)
+(benchmark::State& state) {
+  ThreadScope scope{static_cast<int>(state.range(2))};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(parallel::dot(x, y, state.range(0)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_REGISTER_F(ParallelBenchmark, Dot)->Apply(ParallelBenchmark::BenchmarkedSizes);
+
+// The serial dot product in a single call to Arb for comparison.
+BENCHMARK_DEFINE_F(ParallelBenchmark, Dot_C)
+(benchmark::State& state) {
+  for (auto _ : state) {
+    Arb dot;
+    arb_dot(dot.arb_t(), nullptr, 0, x[0].arb_t(), 1, y[0].arb_t(), 1, state.range(1), state.range(0));
+    benchmark::DoNotOptimize(dot);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+BENCHMARK_REGISTER_F(ParallelBenchmark, Dot_C)->Args({64, 1 << 20, 1})->Args({1024, 1 << 20, 1})->UseRealTime();
+
+}  // namespace arbxx::test
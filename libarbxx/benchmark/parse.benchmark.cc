@@ -0,0 +1,94 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "../arbxx/parse.hpp"
+#include "../arbxx/threads.hpp"
+#include "../arbxx/to_chars.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Loading a newline separated list of decimal numbers. The arguments are the
+// number of lines, the number of digits on each line, and the number of
+// threads.
+struct ParseBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+    std::vector<Arb> x;
+    for (int i = 0; i < state.range(0); i++)
+      x.push_back(tester.random(64));
+
+    buffer.clear();
+    DecimalFormatter{{static_cast<int>(state.range(1)), 0}}.append(buffer, x.data(), x.size());
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (const int digits : {16, 64})
+      for (int threads = 1; threads <= cores; threads *= 2)
+        b->Args({1 << 18, digits, threads});
+    b->UseRealTime();
+  }
+
+  ArbTester tester;
+  std::string buffer;
+};
+
+// Split the buffer into lines and construct each element from a string.
+BENCHMARK_DEFINE_F(ParseBenchmark, Construct)
+(benchmark::State& state) {
+  std::vector<Arb> x;
+  for (auto _ : state) {
+    x.clear();
+    std::string_view rest = buffer;
+    while (!rest.empty()) {
+      const auto line = rest.find('\n');
+      x.emplace_back(std::string(rest.substr(0, line)), 256);
+      rest.remove_prefix(line + 1);
+    }
+    benchmark::DoNotOptimize(x.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK_REGISTER_F(ParseBenchmark, Construct)->Args({1 << 18, 16, 1})->Args({1 << 18, 64, 1})->UseRealTime();
+
+BENCHMARK_DEFINE_F(ParseBenchmark, Ingest)
+(benchmark::State& state) {
+  ThreadScope scope{static_cast<int>(state.range(2))};
+  std::vector<Arb> x;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ingest(x, buffer, 256));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK_REGISTER_F(ParseBenchmark, Ingest)->Apply(ParseBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
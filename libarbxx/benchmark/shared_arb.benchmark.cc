@@ -0,0 +1,76 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "../arbxx/shared_arb.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Compares copies of SharedArb with the CreateCopy and Assign benchmarks of
+// Arb in arb.benchmark.cc.
+struct SharedArbBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State&) override { tester.reset(); }
+
+  SharedArb random(benchmark::State& state) { return SharedArb{tester.random(state.range(0), state.range(1))}; }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({53, 10});
+    b->Args({65536, 1024});
+  }
+
+  ArbTester tester;
+};
+
+BENCHMARK_DEFINE_F(SharedArbBenchmark, CreateCopy)
+(benchmark::State& state) {
+  const SharedArb x = random(state);
+  for (auto _ : state) {
+    SharedArb y(x);
+    benchmark::DoNotOptimize(y);
+  }
+}
+BENCHMARK_REGISTER_F(SharedArbBenchmark, CreateCopy)->Apply(SharedArbBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(SharedArbBenchmark, Assign)
+(benchmark::State& state) {
+  SharedArb x = random(state), y = random(state);
+  for (auto _ : state) {
+    x = y;
+    benchmark::DoNotOptimize(x);
+  }
+}
+BENCHMARK_REGISTER_F(SharedArbBenchmark, Assign)->Apply(SharedArbBenchmark::BenchmarkedSizes);
+
+// A copy followed by a mutation pays for the deferred copy of the limbs.
+BENCHMARK_DEFINE_F(SharedArbBenchmark, CopyMutate)
+(benchmark::State& state) {
+  const SharedArb x = random(state);
+  for (auto _ : state) {
+    SharedArb y(x);
+    arb_neg(y.mutate().arb_t(), y.arb_t());
+    benchmark::DoNotOptimize(y);
+  }
+}
+BENCHMARK_REGISTER_F(SharedArbBenchmark, CopyMutate)->Apply(SharedArbBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
@@ -0,0 +1,89 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../arbxx/to_chars.hpp"
+#include "../test/arb.hpp"
+
+namespace arbxx::test {
+
+// Throughput of exporting many elements as decimal strings. The arguments
+// are the number of elements and their precision.
+struct ToCharsBenchmark : public benchmark::Fixture {
+  void SetUp(const benchmark::State& state) override { SetUp(const_cast<benchmark::State&>(state)); }
+
+  void SetUp(benchmark::State& state) override {
+    tester.reset();
+    x.clear();
+    for (int i = 0; i < state.range(0); i++)
+      x.push_back(tester.random(state.range(1)));
+  }
+
+  static void BenchmarkedSizes(benchmark::internal::Benchmark* b) {
+    b->Args({1024, 64});
+    b->Args({1024, 1024});
+  }
+
+  ArbTester tester;
+  std::vector<Arb> x;
+};
+
+BENCHMARK_DEFINE_F(ToCharsBenchmark, Stream)
+(benchmark::State& state) {
+  std::ostringstream out;
+  for (auto _ : state) {
+    out.str("");
+    for (const auto& xi : x)
+      out << xi << '\n';
+    benchmark::DoNotOptimize(out.tellp());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ToCharsBenchmark, Stream)->Apply(ToCharsBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ToCharsBenchmark, ToChars)
+(benchmark::State& state) {
+  char buffer[256];
+  for (auto _ : state) {
+    for (const auto& xi : x)
+      benchmark::DoNotOptimize(to_chars(buffer, buffer + sizeof(buffer), xi));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ToCharsBenchmark, ToChars)->Apply(ToCharsBenchmark::BenchmarkedSizes);
+
+BENCHMARK_DEFINE_F(ToCharsBenchmark, Append)
+(benchmark::State& state) {
+  DecimalFormatter formatter;
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    formatter.append(out, x.data(), state.range(0));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_REGISTER_F(ToCharsBenchmark, Append)->Apply(ToCharsBenchmark::BenchmarkedSizes);
+
+}  // namespace arbxx::test
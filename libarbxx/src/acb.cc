@@ -0,0 +1,583 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/acb.hpp"
+
+#include <acb.h>
+#include <arb.h>
+#include <flint/fmpq.h>
+#include <flint/fmpz.h>
+
+#include <optional>
+#include <ostream>
+#include <type_traits>
+
+#include "../arbxx/arb.hpp"
+#include "../arbxx/precision.hpp"
+#include "external/gmpxxll/gmpxxll/mpz_class.hpp"
+#include "util/hash.ipp"
+#include "util/integer.ipp"
+
+namespace arbxx {
+
+// The zero-copy real() and imag() rely on this; acb_struct is two arb_struct.
+static_assert(sizeof(Acb) == 2 * sizeof(arb_struct), "Acb must have the same layout as acb_struct");
+static_assert(std::is_standard_layout_v<Acb>, "Acb must have the same layout as acb_struct");
+
+Acb::Acb() noexcept { acb_init(acb_t()); }
+
+Acb::Acb(short x) : Acb(static_cast<long>(x)) {}
+
+Acb::Acb(unsigned short x) : Acb(static_cast<unsigned long>(x)) {}
+
+Acb::Acb(int x) : Acb(static_cast<long>(x)) {}
+
+Acb::Acb(unsigned int x) : Acb(static_cast<unsigned long>(x)) {}
+
+Acb::Acb(long x) : Acb() {
+  *this = x;
+}
+
+Acb::Acb(unsigned long x) : Acb() {
+  *this = x;
+}
+
+Acb::Acb(long long x) : Acb() {
+  *this = x;
+}
+
+Acb::Acb(unsigned long long x) : Acb() {
+  *this = x;
+}
+
+Acb::Acb(const Acb& acb) noexcept : Acb() { acb_set(acb_t(), acb.acb_t()); }
+
+Acb::Acb(Acb&& acb) noexcept {
+  *t = *acb.t;
+  acb_init(acb.t);
+}
+
+Acb::Acb(const Arb& real) : Acb() {
+  acb_set_arb(acb_t(), real.arb_t());
+}
+
+Acb::Acb(const Arb& real, const Arb& imag) : Acb() {
+  acb_set_arb_arb(acb_t(), real.arb_t(), imag.arb_t());
+}
+
+Acb::Acb(const Arf& real) : Acb() {
+  arb_set_arf(acb_realref(acb_t()), real.arf_t());
+}
+
+Acb::Acb(const Arf& real, const Arf& imag) : Acb() {
+  arb_set_arf(acb_realref(acb_t()), real.arf_t());
+  arb_set_arf(acb_imagref(acb_t()), imag.arf_t());
+}
+
+Acb::Acb(const mpq_class& rat) : Acb(rat, ARB_PRECISION_FAST) {}
+
+Acb::Acb(const mpq_class& rat, const prec precision) : Acb() {
+  fmpq_t x;
+  fmpq_init_set_readonly(x, rat.get_mpq_t());
+  acb_set_fmpq(acb_t(), x, precision);
+  fmpq_clear_readonly(x);
+}
+
+Acb::Acb(const mpz_class& value) : Acb() {
+  *this = value;
+}
+
+Acb::Acb(const std::string& real, const std::string& imag, const prec precision) : Acb() {
+  arb_set_str(acb_realref(acb_t()), real.c_str(), precision);
+  arb_set_str(acb_imagref(acb_t()), imag.c_str(), precision);
+}
+
+Acb::~Acb() noexcept { acb_clear(acb_t()); }
+
+Acb Acb::randtest(flint::frandxx& state, prec precision, prec magbits) {
+  Acb ret;
+  acb_randtest(ret.acb_t(), state._data(), precision, magbits);
+  return ret;
+}
+
+Acb Acb::randtest_exact(flint::frandxx& state, prec precision, prec magbits) {
+  // There is no acb_randtest_exact() so we create both parts separately.
+  Acb ret;
+  arb_randtest_exact(acb_realref(ret.acb_t()), state._data(), precision, magbits);
+  arb_randtest_exact(acb_imagref(ret.acb_t()), state._data(), precision, magbits);
+  return ret;
+}
+
+Acb Acb::zero() {
+  return Acb();
+}
+
+Acb Acb::one() {
+  return Acb(1);
+}
+
+Acb Acb::i() {
+  Acb ret;
+  acb_onei(ret.acb_t());
+  return ret;
+}
+
+Acb Acb::indeterminate() {
+  Acb ret;
+  acb_indeterminate(ret.acb_t());
+  return ret;
+}
+
+acb_t& Acb::acb_t() { return t; }
+
+const acb_t& Acb::acb_t() const { return t; }
+
+Arb& Acb::real() noexcept { return reinterpret_cast<Arb&>(*acb_realref(t)); }
+
+const Arb& Acb::real() const noexcept { return reinterpret_cast<const Arb&>(*acb_realref(t)); }
+
+Arb& Acb::imag() noexcept { return reinterpret_cast<Arb&>(*acb_imagref(t)); }
+
+const Arb& Acb::imag() const noexcept { return reinterpret_cast<const Arb&>(*acb_imagref(t)); }
+
+bool Acb::is_exact() const { return acb_is_exact(acb_t()); }
+
+bool Acb::is_finite() const { return acb_is_finite(acb_t()); }
+
+bool Acb::is_real() const { return acb_is_real(acb_t()); }
+
+bool Acb::equal(const Acb& rhs) const { return acb_equal(acb_t(), rhs.acb_t()); }
+
+Acb Acb::operator-() const {
+  Acb ret;
+  acb_neg(ret.acb_t(), acb_t());
+  return ret;
+}
+
+std::optional<bool> operator==(const Acb& lhs, const Acb& rhs) {
+  if (acb_eq(lhs.acb_t(), rhs.acb_t())) {
+    return true;
+  } else if (acb_ne(lhs.acb_t(), rhs.acb_t())) {
+    return false;
+  } else {
+    return std::nullopt;
+  }
+}
+
+std::optional<bool> operator!=(const Acb& lhs, const Acb& rhs) {
+  auto eq = operator==(lhs, rhs);
+  if (eq) {
+    return !*eq;
+  } else {
+    return std::nullopt;
+  }
+}
+
+namespace {
+
+// A complex ball equals a real value if its real part equals the value and
+// its imaginary part is zero. We compare the parts with the relations of Arb
+// so that comparisons with integers and rationals remain exact.
+template <typename T>
+std::optional<bool> eq(const Acb& lhs, const T& rhs) {
+  const auto real = lhs.real() == rhs;
+  if (real.has_value() && !*real)
+    return false;
+
+  const auto imag = lhs.imag() == 0;
+  if (imag.has_value() && !*imag)
+    return false;
+
+  if (real.has_value() && imag.has_value())
+    return true;
+
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<bool> ne(const Acb& lhs, const T& rhs) {
+  auto eq_ = eq(lhs, rhs);
+  if (eq_) {
+    return !*eq_;
+  } else {
+    return std::nullopt;
+  }
+}
+
+}  // namespace
+
+std::optional<bool> operator==(const Acb& lhs, const Arb& rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, const Arb& rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(const Arb& lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(const Arb& lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, short rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, short rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(short lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(short lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, unsigned short rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, unsigned short rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(unsigned short lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned short lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, int rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, int rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(int lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(int lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, unsigned int rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, unsigned int rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(unsigned int lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned int lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(long lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(long lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, unsigned long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, unsigned long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(unsigned long lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned long lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, long long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, long long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(long long lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(long long lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, unsigned long long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, unsigned long long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(unsigned long long lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned long long lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, const mpz_class& rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, const mpz_class& rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(const mpz_class& lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(const mpz_class& lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+std::optional<bool> operator==(const Acb& lhs, const mpq_class& rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Acb& lhs, const mpq_class& rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator==(const mpq_class& lhs, const Acb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(const mpq_class& lhs, const Acb& rhs) { return ne(rhs, lhs); }
+
+Acb& Acb::operator=(const Acb& rhs) noexcept {
+  acb_set(acb_t(), rhs.acb_t());
+  return *this;
+}
+
+Acb& Acb::operator=(Acb&& rhs) noexcept {
+  swap(*this, rhs);
+  return *this;
+}
+
+Acb& Acb::operator=(const Arb& rhs) {
+  acb_set_arb(acb_t(), rhs.arb_t());
+  return *this;
+}
+
+Acb& Acb::operator=(short rhs) {
+  return *this = static_cast<long>(rhs);
+}
+
+Acb& Acb::operator=(unsigned short rhs) {
+  return *this = static_cast<unsigned long>(rhs);
+}
+
+Acb& Acb::operator=(int rhs) {
+  return *this = static_cast<long>(rhs);
+}
+
+Acb& Acb::operator=(unsigned int rhs) {
+  return *this = static_cast<unsigned long>(rhs);
+}
+
+Acb& Acb::operator=(long rhs) {
+  acb_set_si(acb_t(), rhs);
+  return *this;
+}
+
+Acb& Acb::operator=(unsigned long rhs) {
+  acb_set_ui(acb_t(), rhs);
+  return *this;
+}
+
+Acb& Acb::operator=(long long rhs) {
+  return *this = to_supported_integer(rhs);
+}
+
+Acb& Acb::operator=(unsigned long long rhs) {
+  return *this = to_supported_integer(rhs);
+}
+
+Acb& Acb::operator=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  acb_set_fmpz(acb_t(), z);
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Acb& Acb::operator+=(const Acb& rhs) {
+  acb_add(acb_t(), acb_t(), rhs.acb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator+=(const Arb& rhs) {
+  acb_add_arb(acb_t(), acb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator+=(short rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Acb& Acb::operator+=(unsigned short rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Acb& Acb::operator+=(int rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Acb& Acb::operator+=(unsigned int rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Acb& Acb::operator+=(long rhs) {
+  acb_add_si(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator+=(unsigned long rhs) {
+  acb_add_ui(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator+=(long long rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Acb& Acb::operator+=(unsigned long long rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Acb& Acb::operator+=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  acb_add_fmpz(acb_t(), acb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Acb& Acb::operator-=(const Acb& rhs) {
+  acb_sub(acb_t(), acb_t(), rhs.acb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator-=(const Arb& rhs) {
+  acb_sub_arb(acb_t(), acb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator-=(short rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator-=(unsigned short rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator-=(int rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator-=(unsigned int rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator-=(long rhs) {
+  acb_sub_si(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator-=(unsigned long rhs) {
+  acb_sub_ui(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator-=(long long rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator-=(unsigned long long rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator-=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  acb_sub_fmpz(acb_t(), acb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Acb& Acb::operator*=(const Acb& rhs) {
+  acb_mul(acb_t(), acb_t(), rhs.acb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator*=(const Arb& rhs) {
+  acb_mul_arb(acb_t(), acb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator*=(short rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator*=(unsigned short rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator*=(int rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator*=(unsigned int rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator*=(long rhs) {
+  acb_mul_si(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator*=(unsigned long rhs) {
+  acb_mul_ui(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator*=(long long rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator*=(unsigned long long rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator*=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  acb_mul_fmpz(acb_t(), acb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Acb& Acb::operator/=(const Acb& rhs) {
+  acb_div(acb_t(), acb_t(), rhs.acb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator/=(const Arb& rhs) {
+  acb_div_arb(acb_t(), acb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator/=(short rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator/=(unsigned short rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator/=(int rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator/=(unsigned int rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator/=(long rhs) {
+  acb_div_si(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator/=(unsigned long rhs) {
+  acb_div_ui(acb_t(), acb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Acb& Acb::operator/=(long long rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator/=(unsigned long long rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Acb& Acb::operator/=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  acb_div_fmpz(acb_t(), acb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Acb::operator std::complex<double>() const {
+  return {static_cast<double>(real()), static_cast<double>(imag())};
+}
+
+void swap(Acb& a, Acb& b) {
+  acb_swap(a.acb_t(), b.acb_t());
+}
+
+std::ostream& operator<<(std::ostream& os, const Acb& self) {
+  // We follow acb_printn() but print the parts like an Arb so that
+  // os.precision() is respected.
+  if (arb_is_zero(acb_imagref(self.acb_t())))
+    return os << self.real();
+
+  if (arb_is_zero(acb_realref(self.acb_t())))
+    return os << self.imag() << "*I";
+
+  os << self.real();
+  if (arf_sgn(arb_midref(acb_imagref(self.acb_t()))) < 0)
+    os << " - " << -self.imag();
+  else
+    os << " + " << self.imag();
+  return os << "*I";
+}
+
+}  // namespace arbxx
+
+namespace std {
+
+size_t hash<arbxx::Acb>::operator()(const arbxx::Acb& self) const {
+  size_t seed = 0;
+  arbxx::hash_combine(seed, arb_midref(acb_realref(self.acb_t())));
+  arbxx::hash_combine(seed, arb_radref(acb_realref(self.acb_t())));
+  arbxx::hash_combine(seed, arb_midref(acb_imagref(self.acb_t())));
+  arbxx::hash_combine(seed, arb_radref(acb_imagref(self.acb_t())));
+  return seed;
+}
+
+}  // namespace std
@@ -21,15 +21,22 @@
 #include "../arbxx/arb.hpp"
 
 #include <arb.h>
+#include <flint/fmpq.h>
 #include <flint/fmpz.h>
 
 #include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <boost/numeric/conversion/cast.hpp>
+#include <optional>
 #include <ostream>
+#include <type_traits>
+#include <utility>
 
 #include "../arbxx/arf.hpp"
+#include "../arbxx/precision.hpp"
 #include "external/gmpxxll/gmpxxll/mpz_class.hpp"
+#include "util/constant.ipp"
+#include "util/hash.ipp"
 #include "util/integer.ipp"
 
 namespace arbxx {
@@ -151,6 +158,38 @@ Arb Arb::unit_interval() {
   return ret;
 }
 
+Arb Arb::pi(prec prec) {
+  static ConstantCache cache(arb_const_pi);
+
+  Arb ret;
+  cache.get(ret.arb_t(), prec);
+  return ret;
+}
+
+Arb Arb::log2(prec prec) {
+  static ConstantCache cache(arb_const_log2);
+
+  Arb ret;
+  cache.get(ret.arb_t(), prec);
+  return ret;
+}
+
+Arb Arb::e(prec prec) {
+  static ConstantCache cache(arb_const_e);
+
+  Arb ret;
+  cache.get(ret.arb_t(), prec);
+  return ret;
+}
+
+Arb Arb::euler(prec prec) {
+  static ConstantCache cache(arb_const_euler);
+
+  Arb ret;
+  cache.get(ret.arb_t(), prec);
+  return ret;
+}
+
 arb_t& Arb::arb_t() { return t; }
 
 const arb_t& Arb::arb_t() const { return t; }
@@ -224,135 +263,359 @@ std::optional<bool> operator!=(const Arb& lhs, const Arb& rhs) {
 
 bool Arb::equal(const Arb& rhs) const { return arb_equal(arb_t(), rhs.arb_t()); }
 
-std::optional<bool> operator==(const Arb& lhs, short rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, short rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, short rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, short rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, short rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, short rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(short lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(short lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(short lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(short lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(short lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(short lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, unsigned short rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, unsigned short rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, unsigned short rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, unsigned short rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, unsigned short rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, unsigned short rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(unsigned short lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(unsigned short lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(unsigned short lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(unsigned short lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(unsigned short lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(unsigned short lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, int rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, int rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, int rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, int rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, int rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, int rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(int lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(int lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(int lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(int lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(int lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(int lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, unsigned int rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, unsigned int rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, unsigned int rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, unsigned int rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, unsigned int rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, unsigned int rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(unsigned int lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(unsigned int lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(unsigned int lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(unsigned int lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(unsigned int lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(unsigned int lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, long rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, long rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, long rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, long rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, long rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, long rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(long lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(long lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(long lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(long lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(long lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(long lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, unsigned long rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, unsigned long rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, unsigned long rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, unsigned long rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, unsigned long rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, unsigned long rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(unsigned long lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(unsigned long lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(unsigned long lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(unsigned long lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(unsigned long lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(unsigned long lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, long long rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, long long rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, long long rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, long long rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, long long rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, long long rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(long long lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(long long lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(long long lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(long long lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(long long lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(long long lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, unsigned long long rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, unsigned long long rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, unsigned long long rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, unsigned long long rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, unsigned long long rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, unsigned long long rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(unsigned long long lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(unsigned long long lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(unsigned long long lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(unsigned long long lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(unsigned long long lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(unsigned long long lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, const mpz_class& rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, const mpz_class& rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, const mpz_class& rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, const mpz_class& rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, const mpz_class& rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, const mpz_class& rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(const mpz_class& lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(const mpz_class& lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(const mpz_class& lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(const mpz_class& lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(const mpz_class& lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(const mpz_class& lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
-
-std::optional<bool> operator==(const Arb& lhs, const mpq_class& rhs) { return lhs == Arb(rhs); }
-std::optional<bool> operator!=(const Arb& lhs, const mpq_class& rhs) { return lhs != Arb(rhs); }
-std::optional<bool> operator<(const Arb& lhs, const mpq_class& rhs) { return lhs < Arb(rhs); }
-std::optional<bool> operator>(const Arb& lhs, const mpq_class& rhs) { return lhs > Arb(rhs); }
-std::optional<bool> operator<=(const Arb& lhs, const mpq_class& rhs) { return lhs <= Arb(rhs); }
-std::optional<bool> operator>=(const Arb& lhs, const mpq_class& rhs) { return lhs >= Arb(rhs); }
-std::optional<bool> operator==(const mpq_class& lhs, const Arb& rhs) { return Arb(lhs) == rhs; }
-std::optional<bool> operator!=(const mpq_class& lhs, const Arb& rhs) { return Arb(lhs) != rhs; }
-std::optional<bool> operator<(const mpq_class& lhs, const Arb& rhs) { return Arb(lhs) < rhs; }
-std::optional<bool> operator>(const mpq_class& lhs, const Arb& rhs) { return Arb(lhs) > rhs; }
-std::optional<bool> operator<=(const mpq_class& lhs, const Arb& rhs) { return Arb(lhs) <= rhs; }
-std::optional<bool> operator>=(const mpq_class& lhs, const Arb& rhs) { return Arb(lhs) >= rhs; }
+namespace {
+
+// We compare Arb elements to integers and rationals without creating a
+// temporary Arb from the other operand which would allocate for large
+// integers and would need to round rationals. Instead, we determine how the
+// lower and the upper bound of the ball relate to the other operand. These
+// bounds are first computed with two limbs of precision so they fit into an
+// arf_t without allocating. Only when such a rounded bound is too close to
+// the other operand to decide, we compute the bound exactly.
+constexpr prec BOUND_PRECISION = 2 * FLINT_BITS;
+
+// Return the sign of lhs - rhs.
+int cmp(const arf_t lhs, slong rhs) { return arf_cmp_si(lhs, rhs); }
+
+int cmp(const arf_t lhs, ulong rhs) { return arf_cmp_ui(lhs, rhs); }
+
+int cmp(const arf_t lhs, const fmpz_t rhs) {
+  if (!COEFF_IS_MPZ(*rhs))
+    return arf_cmp_si(lhs, *rhs);
+
+  arf_t lower, upper;
+  arf_init(lower);
+  arf_init(upper);
+
+  int ret;
+  if (!arf_set_round_fmpz(lower, rhs, BOUND_PRECISION, ARF_RND_FLOOR)) {
+    ret = arf_cmp(lhs, lower);
+  } else if (arf_cmp(lhs, lower) <= 0) {
+    ret = -1;
+  } else {
+    arf_set_round_fmpz(upper, rhs, BOUND_PRECISION, ARF_RND_CEIL);
+    if (arf_cmp(lhs, upper) >= 0) {
+      ret = 1;
+    } else {
+      // This is only possible if lhs has more than BOUND_PRECISION bits.
+      arf_t exact;
+      arf_init(exact);
+      arf_set_fmpz(exact, rhs);
+      ret = arf_cmp(lhs, exact);
+      arf_clear(exact);
+    }
+  }
+
+  arf_clear(lower);
+  arf_clear(upper);
+  return ret;
+}
+
+int cmp(const arf_t lhs, const fmpq_t rhs) {
+  if (fmpz_is_one(fmpq_denref(rhs)))
+    return cmp(lhs, fmpq_numref(rhs));
+
+  arf_t lower, upper;
+  arf_init(lower);
+  arf_init(upper);
+
+  int ret;
+  if (!arf_fmpz_div_fmpz(lower, fmpq_numref(rhs), fmpq_denref(rhs), BOUND_PRECISION, ARF_RND_FLOOR)) {
+    ret = arf_cmp(lhs, lower);
+  } else if (arf_cmp(lhs, lower) <= 0) {
+    ret = -1;
+  } else {
+    arf_fmpz_div_fmpz(upper, fmpq_numref(rhs), fmpq_denref(rhs), BOUND_PRECISION, ARF_RND_CEIL);
+    if (arf_cmp(lhs, upper) >= 0) {
+      ret = 1;
+    } else {
+      // This is only possible if lhs has more than BOUND_PRECISION bits.
+      // Since the denominator is positive, the sign of lhs - p/q is the sign
+      // of q·lhs - p.
+      arf_t scaled;
+      arf_init(scaled);
+      arf_mul_fmpz(scaled, lhs, fmpq_denref(rhs), ARF_PREC_EXACT, ARF_RND_DOWN);
+      ret = cmp(scaled, fmpq_numref(rhs));
+      arf_clear(scaled);
+    }
+  }
+
+  arf_clear(lower);
+  arf_clear(upper);
+  return ret;
+}
+
+// Return the sign of (m ± r) - rhs where m is the midpoint and r the radius
+// of lhs, or nothing if that bound is not a number.
+template <typename T>
+std::optional<int> cmp_bound(const arb_t lhs, bool upper, const T& rhs) {
+  arf_t radius;
+  if (upper)
+    arf_init_set_mag_shallow(radius, arb_radref(lhs));
+  else
+    arf_init_neg_mag_shallow(radius, arb_radref(lhs));
+
+  arf_t bound;
+  arf_init(bound);
+
+  std::optional<int> ret;
+  if (!arf_add(bound, arb_midref(lhs), radius, BOUND_PRECISION, ARF_RND_FLOOR)) {
+    if (!arf_is_nan(bound))
+      ret = cmp(bound, rhs);
+  } else if (cmp(bound, rhs) >= 0) {
+    // The exact bound is strictly bigger than its rounding down.
+    ret = 1;
+  } else {
+    arf_add(bound, arb_midref(lhs), radius, BOUND_PRECISION, ARF_RND_CEIL);
+    if (cmp(bound, rhs) <= 0) {
+      // The exact bound is strictly smaller than its rounding up.
+      ret = -1;
+    } else {
+      arf_add(bound, arb_midref(lhs), radius, ARF_PREC_EXACT, ARF_RND_DOWN);
+      ret = cmp(bound, rhs);
+    }
+  }
+
+  arf_clear(bound);
+  return ret;
+}
+
+// Return the signs of the lower bound minus rhs and of the upper bound minus
+// rhs, or nothing if lhs is not a number.
+template <typename T>
+std::optional<std::pair<int, int>> cmp_bounds(const arb_t lhs, const T& rhs) {
+  if (arf_is_nan(arb_midref(lhs)))
+    return std::nullopt;
+
+  if (mag_is_zero(arb_radref(lhs))) {
+    const int c = cmp(arb_midref(lhs), rhs);
+    return std::pair{c, c};
+  }
+
+  const auto lower = cmp_bound(lhs, false, rhs);
+  if (!lower)
+    return std::nullopt;
+
+  const auto upper = cmp_bound(lhs, true, rhs);
+  if (!upper)
+    return std::nullopt;
+
+  return std::pair{*lower, *upper};
+}
+
+template <typename T>
+std::optional<std::pair<int, int>> cmp_bounds(const Arb& lhs, const T& rhs) {
+  if constexpr (std::is_same_v<T, mpz_class>) {
+    fmpz_t z;
+    fmpz_init_set_readonly(z, rhs.get_mpz_t());
+    const auto ret = cmp_bounds(lhs.arb_t(), z);
+    fmpz_clear_readonly(z);
+    return ret;
+  } else if constexpr (std::is_same_v<T, mpq_class>) {
+    fmpq_t q;
+    fmpq_init_set_readonly(q, rhs.get_mpq_t());
+    const auto ret = cmp_bounds(lhs.arb_t(), q);
+    fmpq_clear_readonly(q);
+    return ret;
+  } else {
+    const auto value = to_supported_integer(rhs);
+    if constexpr (std::is_same_v<std::decay_t<decltype(value)>, gmpxxll::mpz_class>)
+      return cmp_bounds(lhs, static_cast<const mpz_class&>(value));
+    else
+      return cmp_bounds(lhs.arb_t(), value);
+  }
+}
+
+// The semantic of these relations is the one described in arb.hpp, i.e.,
+// they agree with arb_lt() and friends when the result is true.
+template <typename T>
+std::optional<bool> lt(const Arb& lhs, const T& rhs) {
+  const auto bounds = cmp_bounds(lhs, rhs);
+  if (bounds) {
+    if (bounds->second < 0) return true;
+    if (bounds->first >= 0) return false;
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<bool> le(const Arb& lhs, const T& rhs) {
+  const auto bounds = cmp_bounds(lhs, rhs);
+  if (bounds) {
+    if (bounds->second <= 0) return true;
+    if (bounds->first > 0) return false;
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<bool> gt(const Arb& lhs, const T& rhs) {
+  const auto bounds = cmp_bounds(lhs, rhs);
+  if (bounds) {
+    if (bounds->first > 0) return true;
+    if (bounds->second <= 0) return false;
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<bool> ge(const Arb& lhs, const T& rhs) {
+  const auto bounds = cmp_bounds(lhs, rhs);
+  if (bounds) {
+    if (bounds->first >= 0) return true;
+    if (bounds->second < 0) return false;
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<bool> eq(const Arb& lhs, const T& rhs) {
+  const auto bounds = cmp_bounds(lhs, rhs);
+  if (bounds) {
+    if (bounds->first == 0 && bounds->second == 0) return true;
+    if (bounds->first > 0 || bounds->second < 0) return false;
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+std::optional<bool> ne(const Arb& lhs, const T& rhs) {
+  const auto equal = eq(lhs, rhs);
+  if (equal) return !*equal;
+  return std::nullopt;
+}
+
+}  // namespace
+
+std::optional<bool> operator==(const Arb& lhs, short rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, short rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, short rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, short rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, short rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, short rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(short lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(short lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(short lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(short lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(short lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(short lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, unsigned short rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, unsigned short rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, unsigned short rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, unsigned short rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, unsigned short rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, unsigned short rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(unsigned short lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned short lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(unsigned short lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(unsigned short lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(unsigned short lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(unsigned short lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, int rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, int rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, int rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, int rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, int rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, int rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(int lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(int lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(int lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(int lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(int lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(int lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, unsigned int rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, unsigned int rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, unsigned int rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, unsigned int rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, unsigned int rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, unsigned int rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(unsigned int lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned int lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(unsigned int lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(unsigned int lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(unsigned int lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(unsigned int lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, long rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, long rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, long rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, long rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(long lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(long lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(long lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(long lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(long lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(long lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, unsigned long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, unsigned long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, unsigned long rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, unsigned long rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, unsigned long rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, unsigned long rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(unsigned long lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned long lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(unsigned long lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(unsigned long lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(unsigned long lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(unsigned long lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, long long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, long long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, long long rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, long long rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, long long rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, long long rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(long long lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(long long lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(long long lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(long long lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(long long lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(long long lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, unsigned long long rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, unsigned long long rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, unsigned long long rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, unsigned long long rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, unsigned long long rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, unsigned long long rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(unsigned long long lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(unsigned long long lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(unsigned long long lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(unsigned long long lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(unsigned long long lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(unsigned long long lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, const mpz_class& rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, const mpz_class& rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, const mpz_class& rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, const mpz_class& rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, const mpz_class& rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, const mpz_class& rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(const mpz_class& lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(const mpz_class& lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(const mpz_class& lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(const mpz_class& lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(const mpz_class& lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(const mpz_class& lhs, const Arb& rhs) { return le(rhs, lhs); }
+
+std::optional<bool> operator==(const Arb& lhs, const mpq_class& rhs) { return eq(lhs, rhs); }
+std::optional<bool> operator!=(const Arb& lhs, const mpq_class& rhs) { return ne(lhs, rhs); }
+std::optional<bool> operator<(const Arb& lhs, const mpq_class& rhs) { return lt(lhs, rhs); }
+std::optional<bool> operator>(const Arb& lhs, const mpq_class& rhs) { return gt(lhs, rhs); }
+std::optional<bool> operator<=(const Arb& lhs, const mpq_class& rhs) { return le(lhs, rhs); }
+std::optional<bool> operator>=(const Arb& lhs, const mpq_class& rhs) { return ge(lhs, rhs); }
+std::optional<bool> operator==(const mpq_class& lhs, const Arb& rhs) { return eq(rhs, lhs); }
+std::optional<bool> operator!=(const mpq_class& lhs, const Arb& rhs) { return ne(rhs, lhs); }
+std::optional<bool> operator<(const mpq_class& lhs, const Arb& rhs) { return gt(rhs, lhs); }
+std::optional<bool> operator>(const mpq_class& lhs, const Arb& rhs) { return lt(rhs, lhs); }
+std::optional<bool> operator<=(const mpq_class& lhs, const Arb& rhs) { return ge(rhs, lhs); }
+std::optional<bool> operator>=(const mpq_class& lhs, const Arb& rhs) { return le(rhs, lhs); }
 
 Arb& Arb::operator=(const Arb& rhs) noexcept {
   arb_set(arb_t(), rhs.arb_t());
@@ -406,6 +669,194 @@ Arb& Arb::operator=(const mpz_class& rhs) {
   return *this;
 }
 
+Arb& Arb::operator+=(const Arb& rhs) {
+  arb_add(arb_t(), arb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator+=(short rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arb& Arb::operator+=(unsigned short rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arb& Arb::operator+=(int rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arb& Arb::operator+=(unsigned int rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arb& Arb::operator+=(long rhs) {
+  arb_add_si(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator+=(unsigned long rhs) {
+  arb_add_ui(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator+=(long long rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arb& Arb::operator+=(unsigned long long rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arb& Arb::operator+=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arb_add_fmpz(arb_t(), arb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Arb& Arb::operator-=(const Arb& rhs) {
+  arb_sub(arb_t(), arb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator-=(short rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator-=(unsigned short rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator-=(int rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator-=(unsigned int rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator-=(long rhs) {
+  arb_sub_si(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator-=(unsigned long rhs) {
+  arb_sub_ui(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator-=(long long rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator-=(unsigned long long rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator-=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arb_sub_fmpz(arb_t(), arb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Arb& Arb::operator*=(const Arb& rhs) {
+  arb_mul(arb_t(), arb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator*=(short rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator*=(unsigned short rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator*=(int rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator*=(unsigned int rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator*=(long rhs) {
+  arb_mul_si(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator*=(unsigned long rhs) {
+  arb_mul_ui(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator*=(long long rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator*=(unsigned long long rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator*=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arb_mul_fmpz(arb_t(), arb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Arb& Arb::operator/=(const Arb& rhs) {
+  arb_div(arb_t(), arb_t(), rhs.arb_t(), PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator/=(short rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator/=(unsigned short rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator/=(int rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator/=(unsigned int rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator/=(long rhs) {
+  arb_div_si(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator/=(unsigned long rhs) {
+  arb_div_ui(arb_t(), arb_t(), rhs, PrecisionScope::precision());
+  return *this;
+}
+
+Arb& Arb::operator/=(long long rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator/=(unsigned long long rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arb& Arb::operator/=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arb_div_fmpz(arb_t(), arb_t(), z, PrecisionScope::precision());
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
 Arb::operator std::pair<Arf, Arf>() const {
   std::pair<Arf, Arf> ret;
   arb_get_interval_arf(ret.first.arf_t(), ret.second.arf_t(), arb_t(), arb_rel_accuracy_bits(arb_t()));
@@ -438,3 +889,14 @@ std::ostream& operator<<(std::ostream& os, const Arb& self) {
 }
 
 }  // namespace arbxx
+
+namespace std {
+
+size_t hash<arbxx::Arb>::operator()(const arbxx::Arb& self) const {
+  size_t seed = 0;
+  arbxx::hash_combine(seed, arb_midref(self.arb_t()));
+  arbxx::hash_combine(seed, arb_radref(self.arb_t()));
+  return seed;
+}
+
+}  // namespace std
@@ -0,0 +1,518 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/arb_batch.hpp"
+
+#include <arb.h>
+#include <arf.h>
+#include <mag.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#include "../arbxx/arb_vector.hpp"
+#include "util/assert.ipp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBARBXX_ARB_BATCH_X86 1
+#include <immintrin.h>
+#else
+#define LIBARBXX_ARB_BATCH_X86 0
+#endif
+
+// The kernels below compute with doubles in the default rounding mode, i.e.,
+// rounding to nearest. Every midpoint is the double closest to the exact
+// result of the operation on the midpoints. Every radius is computed
+// from the radii and the rounding error of the midpoint (which is exact
+// thanks to TwoSum and fma respectively) with at most three further
+// roundings. The radius is then widened by adding ETA and multiplying by
+// WIDEN. This accounts for five roundings to nearest, each of relative error
+// at most 2^-53, plus the absolute errors of products that underflow, even
+// if subnormals are flushed to zero.
+//
+// When a midpoint overflows or a radius is not a number, the result is
+// replaced by [0 +/- inf].
+
+namespace arbxx {
+
+namespace {
+
+constexpr double ETA = 0x1p-1020;
+constexpr double WIDEN = 1 + 0x1p-50;
+constexpr double ULP = 0x1p-52;
+constexpr double MIN = std::numeric_limits<double>::min();
+constexpr double MAX = std::numeric_limits<double>::max();
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+// Products of at least this magnitude are normal numbers whose rounding
+// error can be computed exactly with an fma.
+constexpr double TINY = 0x1p-969;
+
+// Signature of the kernels that replace (mid, rad) with the elementwise
+// result of an operation with (rhs_mid, rhs_rad).
+using Arithmetic = void (*)(double* mid, double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length);
+
+// Signature of the kernels that write 1 (true), 0 (false), or -1 (undecided)
+// for each pair of elements to ret.
+using Relation = void (*)(signed char* ret, const double* mid, const double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length);
+
+struct Kernels {
+  const char* name;
+  Arithmetic add;
+  Arithmetic mul;
+  Relation lt;
+};
+
+namespace scalar {
+
+void normalize(double& mid, double& rad) noexcept {
+  if (!(std::abs(mid) <= MAX) || std::isnan(rad)) {
+    mid = 0;
+    rad = INF;
+  }
+}
+
+double widen(double rad) noexcept { return (rad + ETA) * WIDEN; }
+
+void add(double& a, double& ra, double b, double rb) noexcept {
+  const double m = a + b;
+  const double v = m - a;
+  const double e = (a - (m - v)) + (b - v);
+  const double r = (ra + rb) + std::abs(e);
+
+  a = m;
+  ra = r == 0 ? 0 : widen(r);
+  normalize(a, ra);
+}
+
+void mul(double& a, double& ra, double b, double rb) noexcept {
+  const double m = a * b;
+  const double e = std::fma(a, b, -m);
+  const double r = (std::abs(a) * rb + ra * std::abs(b)) + (ra * rb + std::abs(e));
+  const bool exact = ra == 0 && rb == 0 && e == 0 && (std::abs(m) >= TINY || a == 0 || b == 0);
+
+  a = m;
+  ra = exact ? 0 : widen(r);
+  normalize(a, ra);
+}
+
+signed char lt(double a, double ra, double b, double rb) noexcept {
+  if (ra == 0 && rb == 0)
+    return a < b;
+
+  // An upper bound for ra + rb.
+  const double s = ra + rb;
+  const double upper = s + (s * ULP + MIN);
+
+  // Lower and upper bounds for a - b are d -/+ error.
+  const double d = a - b;
+  const double error = std::abs(d) * ULP + MIN;
+
+  if (!(upper <= MAX))
+    return -1;
+  if (d + error < -upper)
+    return 1;
+  if (d - error >= upper)
+    return 0;
+  return -1;
+}
+
+void add(double* mid, double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  for (::arbxx::size i = 0; i < length; i++)
+    add(mid[i], rad[i], rhs_mid[i], rhs_rad[i]);
+}
+
+void mul(double* mid, double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  for (::arbxx::size i = 0; i < length; i++)
+    mul(mid[i], rad[i], rhs_mid[i], rhs_rad[i]);
+}
+
+void lt(signed char* ret, const double* mid, const double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  for (::arbxx::size i = 0; i < length; i++)
+    ret[i] = lt(mid[i], rad[i], rhs_mid[i], rhs_rad[i]);
+}
+
+}  // namespace scalar
+
+#if LIBARBXX_ARB_BATCH_X86
+
+namespace avx2 {
+
+#define LIBARBXX_TARGET __attribute__((target("avx2,fma")))
+
+LIBARBXX_TARGET __m256d abs(__m256d x) noexcept { return _mm256_andnot_pd(_mm256_set1_pd(-0.), x); }
+
+LIBARBXX_TARGET __m256d widen(__m256d rad) noexcept {
+  return _mm256_mul_pd(_mm256_add_pd(rad, _mm256_set1_pd(ETA)), _mm256_set1_pd(WIDEN));
+}
+
+LIBARBXX_TARGET void store(double* mid, double* rad, __m256d m, __m256d r) noexcept {
+  const __m256d overflow = _mm256_cmp_pd(abs(m), _mm256_set1_pd(MAX), _CMP_NLE_UQ);
+  const __m256d nan = _mm256_cmp_pd(r, r, _CMP_UNORD_Q);
+  const __m256d invalid = _mm256_or_pd(overflow, nan);
+  _mm256_storeu_pd(mid, _mm256_andnot_pd(invalid, m));
+  _mm256_storeu_pd(rad, _mm256_blendv_pd(r, _mm256_set1_pd(INF), invalid));
+}
+
+LIBARBXX_TARGET void add(double* mid, double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  ::arbxx::size i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m256d a = _mm256_loadu_pd(mid + i);
+    const __m256d ra = _mm256_loadu_pd(rad + i);
+    const __m256d b = _mm256_loadu_pd(rhs_mid + i);
+    const __m256d rb = _mm256_loadu_pd(rhs_rad + i);
+
+    const __m256d m = _mm256_add_pd(a, b);
+    const __m256d v = _mm256_sub_pd(m, a);
+    const __m256d e = _mm256_add_pd(_mm256_sub_pd(a, _mm256_sub_pd(m, v)), _mm256_sub_pd(b, v));
+    const __m256d r = _mm256_add_pd(_mm256_add_pd(ra, rb), abs(e));
+
+    const __m256d exact = _mm256_cmp_pd(r, _mm256_setzero_pd(), _CMP_EQ_OQ);
+    store(mid + i, rad + i, m, _mm256_andnot_pd(exact, widen(r)));
+  }
+  scalar::add(mid + i, rad + i, rhs_mid + i, rhs_rad + i, length - i);
+}
+
+LIBARBXX_TARGET void mul(double* mid, double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  const __m256d zero = _mm256_setzero_pd();
+
+  ::arbxx::size i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m256d a = _mm256_loadu_pd(mid + i);
+    const __m256d ra = _mm256_loadu_pd(rad + i);
+    const __m256d b = _mm256_loadu_pd(rhs_mid + i);
+    const __m256d rb = _mm256_loadu_pd(rhs_rad + i);
+
+    const __m256d m = _mm256_mul_pd(a, b);
+    const __m256d e = _mm256_fmsub_pd(a, b, m);
+    const __m256d r = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(abs(a), rb), _mm256_mul_pd(ra, abs(b))), _mm256_add_pd(_mm256_mul_pd(ra, rb), abs(e)));
+
+    const __m256d radii = _mm256_and_pd(_mm256_cmp_pd(ra, zero, _CMP_EQ_OQ), _mm256_cmp_pd(rb, zero, _CMP_EQ_OQ));
+    const __m256d normal = _mm256_or_pd(_mm256_cmp_pd(abs(m), _mm256_set1_pd(TINY), _CMP_GE_OQ), _mm256_or_pd(_mm256_cmp_pd(a, zero, _CMP_EQ_OQ), _mm256_cmp_pd(b, zero, _CMP_EQ_OQ)));
+    const __m256d exact = _mm256_and_pd(_mm256_and_pd(radii, _mm256_cmp_pd(e, zero, _CMP_EQ_OQ)), normal);
+    store(mid + i, rad + i, m, _mm256_andnot_pd(exact, widen(r)));
+  }
+  scalar::mul(mid + i, rad + i, rhs_mid + i, rhs_rad + i, length - i);
+}
+
+LIBARBXX_TARGET void lt(signed char* ret, const double* mid, const double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d ulp = _mm256_set1_pd(ULP);
+  const __m256d min = _mm256_set1_pd(MIN);
+
+  ::arbxx::size i = 0;
+  for (; i + 4 <= length; i += 4) {
+    const __m256d a = _mm256_loadu_pd(mid + i);
+    const __m256d ra = _mm256_loadu_pd(rad + i);
+    const __m256d b = _mm256_loadu_pd(rhs_mid + i);
+    const __m256d rb = _mm256_loadu_pd(rhs_rad + i);
+
+    const __m256d s = _mm256_add_pd(ra, rb);
+    const __m256d upper = _mm256_add_pd(s, _mm256_add_pd(_mm256_mul_pd(s, ulp), min));
+    const __m256d d = _mm256_sub_pd(a, b);
+    const __m256d error = _mm256_add_pd(_mm256_mul_pd(abs(d), ulp), min);
+
+    const __m256d finite = _mm256_cmp_pd(upper, _mm256_set1_pd(MAX), _CMP_LE_OQ);
+    const __m256d exact = _mm256_cmp_pd(s, zero, _CMP_EQ_OQ);
+
+    const __m256d less = _mm256_blendv_pd(_mm256_and_pd(finite, _mm256_cmp_pd(_mm256_add_pd(d, error), _mm256_sub_pd(zero, upper), _CMP_LT_OQ)), _mm256_cmp_pd(a, b, _CMP_LT_OQ), exact);
+    const __m256d greater = _mm256_blendv_pd(_mm256_and_pd(finite, _mm256_cmp_pd(_mm256_sub_pd(d, error), upper, _CMP_GE_OQ)), _mm256_cmp_pd(a, b, _CMP_GE_OQ), exact);
+
+    const int lt = _mm256_movemask_pd(less);
+    const int ge = _mm256_movemask_pd(greater);
+    for (int j = 0; j < 4; j++)
+      ret[i + j] = (lt >> j) & 1 ? 1 : (ge >> j) & 1 ? 0 : -1;
+  }
+  scalar::lt(ret + i, mid + i, rad + i, rhs_mid + i, rhs_rad + i, length - i);
+}
+
+#undef LIBARBXX_TARGET
+
+}  // namespace avx2
+
+namespace avx512 {
+
+#define LIBARBXX_TARGET __attribute__((target("avx512f")))
+
+LIBARBXX_TARGET __m512d widen(__m512d rad) noexcept {
+  return _mm512_mul_pd(_mm512_add_pd(rad, _mm512_set1_pd(ETA)), _mm512_set1_pd(WIDEN));
+}
+
+LIBARBXX_TARGET void store(double* mid, double* rad, __m512d m, __m512d r) noexcept {
+  const __mmask8 overflow = _mm512_cmp_pd_mask(_mm512_abs_pd(m), _mm512_set1_pd(MAX), _CMP_NLE_UQ);
+  const __mmask8 nan = _mm512_cmp_pd_mask(r, r, _CMP_UNORD_Q);
+  const __mmask8 invalid = overflow | nan;
+  _mm512_storeu_pd(mid, _mm512_mask_blend_pd(invalid, m, _mm512_setzero_pd()));
+  _mm512_storeu_pd(rad, _mm512_mask_blend_pd(invalid, r, _mm512_set1_pd(INF)));
+}
+
+LIBARBXX_TARGET void add(double* mid, double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  ::arbxx::size i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m512d a = _mm512_loadu_pd(mid + i);
+    const __m512d ra = _mm512_loadu_pd(rad + i);
+    const __m512d b = _mm512_loadu_pd(rhs_mid + i);
+    const __m512d rb = _mm512_loadu_pd(rhs_rad + i);
+
+    const __m512d m = _mm512_add_pd(a, b);
+    const __m512d v = _mm512_sub_pd(m, a);
+    const __m512d e = _mm512_add_pd(_mm512_sub_pd(a, _mm512_sub_pd(m, v)), _mm512_sub_pd(b, v));
+    const __m512d r = _mm512_add_pd(_mm512_add_pd(ra, rb), _mm512_abs_pd(e));
+
+    const __mmask8 exact = _mm512_cmp_pd_mask(r, _mm512_setzero_pd(), _CMP_EQ_OQ);
+    store(mid + i, rad + i, m, _mm512_mask_blend_pd(exact, widen(r), _mm512_setzero_pd()));
+  }
+  scalar::add(mid + i, rad + i, rhs_mid + i, rhs_rad + i, length - i);
+}
+
+LIBARBXX_TARGET void mul(double* mid, double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  const __m512d zero = _mm512_setzero_pd();
+
+  ::arbxx::size i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m512d a = _mm512_loadu_pd(mid + i);
+    const __m512d ra = _mm512_loadu_pd(rad + i);
+    const __m512d b = _mm512_loadu_pd(rhs_mid + i);
+    const __m512d rb = _mm512_loadu_pd(rhs_rad + i);
+
+    const __m512d m = _mm512_mul_pd(a, b);
+    const __m512d e = _mm512_fmsub_pd(a, b, m);
+    const __m512d r = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(_mm512_abs_pd(a), rb), _mm512_mul_pd(ra, _mm512_abs_pd(b))), _mm512_add_pd(_mm512_mul_pd(ra, rb), _mm512_abs_pd(e)));
+
+    const __mmask8 radii = _mm512_cmp_pd_mask(ra, zero, _CMP_EQ_OQ) & _mm512_cmp_pd_mask(rb, zero, _CMP_EQ_OQ);
+    const __mmask8 normal = _mm512_cmp_pd_mask(_mm512_abs_pd(m), _mm512_set1_pd(TINY), _CMP_GE_OQ) | _mm512_cmp_pd_mask(a, zero, _CMP_EQ_OQ) | _mm512_cmp_pd_mask(b, zero, _CMP_EQ_OQ);
+    const __mmask8 exact = radii & _mm512_cmp_pd_mask(e, zero, _CMP_EQ_OQ) & normal;
+    store(mid + i, rad + i, m, _mm512_mask_blend_pd(exact, widen(r), zero));
+  }
+  scalar::mul(mid + i, rad + i, rhs_mid + i, rhs_rad + i, length - i);
+}
+
+LIBARBXX_TARGET void lt(signed char* ret, const double* mid, const double* rad, const double* rhs_mid, const double* rhs_rad, ::arbxx::size length) {
+  const __m512d zero = _mm512_setzero_pd();
+  const __m512d ulp = _mm512_set1_pd(ULP);
+  const __m512d min = _mm512_set1_pd(MIN);
+
+  ::arbxx::size i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m512d a = _mm512_loadu_pd(mid + i);
+    const __m512d ra = _mm512_loadu_pd(rad + i);
+    const __m512d b = _mm512_loadu_pd(rhs_mid + i);
+    const __m512d rb = _mm512_loadu_pd(rhs_rad + i);
+
+    const __m512d s = _mm512_add_pd(ra, rb);
+    const __m512d upper = _mm512_add_pd(s, _mm512_add_pd(_mm512_mul_pd(s, ulp), min));
+    const __m512d d = _mm512_sub_pd(a, b);
+    const __m512d error = _mm512_add_pd(_mm512_mul_pd(_mm512_abs_pd(d), ulp), min);
+
+    const __mmask8 finite = _mm512_cmp_pd_mask(upper, _mm512_set1_pd(MAX), _CMP_LE_OQ);
+    const __mmask8 exact = _mm512_cmp_pd_mask(s, zero, _CMP_EQ_OQ);
+
+    const __mmask8 less = (exact & _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ)) | (~exact & finite & _mm512_cmp_pd_mask(_mm512_add_pd(d, error), _mm512_sub_pd(zero, upper), _CMP_LT_OQ));
+    const __mmask8 greater = (exact & _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ)) | (~exact & finite & _mm512_cmp_pd_mask(_mm512_sub_pd(d, error), upper, _CMP_GE_OQ));
+
+    for (int j = 0; j < 8; j++)
+      ret[i + j] = (less >> j) & 1 ? 1 : (greater >> j) & 1 ? 0 : -1;
+  }
+  scalar::lt(ret + i, mid + i, rad + i, rhs_mid + i, rhs_rad + i, length - i);
+}
+
+#undef LIBARBXX_TARGET
+
+}  // namespace avx512
+
+#endif
+
+// Return the kernels that the CPU supports, the fastest first.
+const std::vector<Kernels>& supported() {
+  static const std::vector<Kernels> kernels = []() {
+    std::vector<Kernels> ret;
+#if LIBARBXX_ARB_BATCH_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      ret.push_back({"avx512", avx512::add, avx512::mul, avx512::lt});
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      ret.push_back({"avx2", avx2::add, avx2::mul, avx2::lt});
+#endif
+    ret.push_back({"scalar", scalar::add, scalar::mul, scalar::lt});
+    return ret;
+  }();
+  return kernels;
+}
+
+// Return the kernels called `name` or nullptr if the CPU does not support
+// them.
+const Kernels* supported(const char* name) {
+  for (const Kernels& kernels : supported())
+    if (std::strcmp(kernels.name, name) == 0)
+      return &kernels;
+  return nullptr;
+}
+
+// The kernels that are used by all batches.
+std::atomic<const Kernels*> selected{nullptr};
+
+// Return the kernels requested through the LIBARBXX_ARB_BATCH_KERNELS
+// environment variable, or the fastest kernels that the CPU supports.
+const Kernels& dispatch() {
+  const Kernels* kernels = selected.load(std::memory_order_acquire);
+  if (kernels == nullptr) {
+    const char* name = std::getenv("LIBARBXX_ARB_BATCH_KERNELS");
+    const Kernels* requested = name == nullptr ? nullptr : supported(name);
+    const Kernels* initial = requested == nullptr ? &supported().front() : requested;
+    if (selected.compare_exchange_strong(kernels, initial, std::memory_order_acq_rel))
+      kernels = initial;
+  }
+  return *kernels;
+}
+
+// Set (mid, rad) to a ball of doubles enclosing x.
+void set(double& mid, double& rad, const Arb& x) {
+  if (!arb_is_finite(x.arb_t())) {
+    mid = 0;
+    rad = INF;
+    return;
+  }
+
+  mid = arf_get_d(arb_midref(x.arb_t()), ARF_RND_NEAR);
+  rad = mag_get_d(arb_radref(x.arb_t()));
+
+  if (!(std::abs(mid) <= MAX)) {
+    mid = 0;
+    rad = INF;
+    return;
+  }
+
+  arf_t error;
+  arf_init(error);
+  arf_set_d(error, mid);
+  arf_sub(error, arb_midref(x.arb_t()), error, ARF_PREC_EXACT, ARF_RND_DOWN);
+  if (!arf_is_zero(error))
+    rad = scalar::widen(rad + std::abs(arf_get_d(error, ARF_RND_UP)));
+  arf_clear(error);
+
+  scalar::normalize(mid, rad);
+}
+
+}  // namespace
+
+ArbBatch::ArbBatch() noexcept {}
+
+ArbBatch::ArbBatch(::arbxx::size length) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length of batch must not be negative");
+  mid.resize(length);
+  rad.resize(length);
+}
+
+ArbBatch::ArbBatch(const std::vector<Arb>& values) : ArbBatch(static_cast<::arbxx::size>(values.size())) {
+  for (::arbxx::size i = 0; i < size(); i++)
+    set(mid[i], rad[i], values[i]);
+}
+
+ArbBatch::ArbBatch(const ArbVector& values) : ArbBatch(values.size()) {
+  for (::arbxx::size i = 0; i < size(); i++)
+    set(mid[i], rad[i], values[i]);
+}
+
+::arbxx::size ArbBatch::size() const noexcept { return static_cast<::arbxx::size>(mid.size()); }
+
+bool ArbBatch::empty() const noexcept { return mid.empty(); }
+
+Arb ArbBatch::operator[](::arbxx::size i) const {
+  Arb ret;
+  arf_set_d(arb_midref(ret.arb_t()), mid[i]);
+  if (std::isinf(rad[i]))
+    mag_inf(arb_radref(ret.arb_t()));
+  else
+    mag_set_d(arb_radref(ret.arb_t()), rad[i]);
+  return ret;
+}
+
+const double* ArbBatch::midpoints() const noexcept { return mid.data(); }
+
+const double* ArbBatch::radii() const noexcept { return rad.data(); }
+
+ArbBatch& ArbBatch::add(const ArbBatch& rhs) {
+  LIBARBXX_CHECK_ARGUMENT(size() == rhs.size(), "batches must have the same length");
+  dispatch().add(mid.data(), rad.data(), rhs.mid.data(), rhs.rad.data(), size());
+  return *this;
+}
+
+ArbBatch& ArbBatch::mul(const ArbBatch& rhs) {
+  LIBARBXX_CHECK_ARGUMENT(size() == rhs.size(), "batches must have the same length");
+  dispatch().mul(mid.data(), rad.data(), rhs.mid.data(), rhs.rad.data(), size());
+  return *this;
+}
+
+std::vector<std::optional<bool>> ArbBatch::lt(const ArbBatch& rhs) const {
+  LIBARBXX_CHECK_ARGUMENT(size() == rhs.size(), "batches must have the same length");
+
+  std::vector<signed char> decided(mid.size());
+  dispatch().lt(decided.data(), mid.data(), rad.data(), rhs.mid.data(), rhs.rad.data(), size());
+
+  std::vector<std::optional<bool>> ret(mid.size());
+  for (size_t i = 0; i < decided.size(); i++)
+    if (decided[i] != -1)
+      ret[i] = decided[i] == 1;
+  return ret;
+}
+
+ArbBatch::operator std::vector<Arb>() const {
+  std::vector<Arb> ret;
+  ret.reserve(mid.size());
+  for (::arbxx::size i = 0; i < size(); i++)
+    ret.push_back((*this)[i]);
+  return ret;
+}
+
+const char* ArbBatch::kernels() noexcept { return dispatch().name; }
+
+namespace detail {
+
+bool use_arb_batch_kernels(const char* name) {
+  const Kernels* kernels = supported(name);
+  if (kernels == nullptr)
+    return false;
+  selected.store(kernels, std::memory_order_release);
+  return true;
+}
+
+}  // namespace detail
+
+void swap(ArbBatch& lhs, ArbBatch& rhs) noexcept {
+  using std::swap;
+  swap(lhs.mid, rhs.mid);
+  swap(lhs.rad, rhs.rad);
+}
+
+std::ostream& operator<<(std::ostream& os, const ArbBatch& self) {
+  os << "[";
+  for (::arbxx::size i = 0; i < self.size(); i++) {
+    if (i)
+      os << ", ";
+    os << self[i];
+  }
+  return os << "]";
+}
+
+}  // namespace arbxx
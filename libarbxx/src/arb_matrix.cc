@@ -0,0 +1,170 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/arb_matrix.hpp"
+
+#include <arb_mat.h>
+
+#include <ostream>
+#include <stdexcept>
+
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+ArbMatrix::ArbMatrix() noexcept { arb_mat_init(t, 0, 0); }
+
+ArbMatrix::ArbMatrix(::arbxx::size rows, ::arbxx::size cols) {
+  LIBARBXX_CHECK_ARGUMENT(rows >= 0 && cols >= 0, "dimensions of a matrix must not be negative");
+  arb_mat_init(t, rows, cols);
+}
+
+ArbMatrix::ArbMatrix(const ArbMatrix& A) : ArbMatrix(A.nrows(), A.ncols()) {
+  arb_mat_set(t, A.t);
+}
+
+ArbMatrix::ArbMatrix(ArbMatrix&& A) noexcept {
+  *t = *A.t;
+  arb_mat_init(A.t, 0, 0);
+}
+
+ArbMatrix::~ArbMatrix() noexcept { arb_mat_clear(t); }
+
+ArbMatrix& ArbMatrix::operator=(const ArbMatrix& A) {
+  if (this == &A)
+    return *this;
+
+  if (nrows() == A.nrows() && ncols() == A.ncols()) {
+    arb_mat_set(t, A.t);
+    return *this;
+  }
+
+  return *this = ArbMatrix(A);
+}
+
+ArbMatrix& ArbMatrix::operator=(ArbMatrix&& A) noexcept {
+  swap(*this, A);
+  return *this;
+}
+
+ArbMatrix ArbMatrix::one(::arbxx::size n) {
+  ArbMatrix ret(n, n);
+  arb_mat_one(ret.t);
+  return ret;
+}
+
+ArbMatrix ArbMatrix::randtest(flint::frandxx& state, ::arbxx::size rows, ::arbxx::size cols, prec precision, prec magbits) {
+  ArbMatrix ret(rows, cols);
+  arb_mat_randtest(ret.t, state._data(), precision, magbits);
+  return ret;
+}
+
+::arbxx::size ArbMatrix::nrows() const noexcept { return arb_mat_nrows(t); }
+
+::arbxx::size ArbMatrix::ncols() const noexcept { return arb_mat_ncols(t); }
+
+// The entries of an arb_mat_t are arb_struct which have the same layout as
+// an Arb, see the static_assert in arb_vector.cc.
+Arb& ArbMatrix::operator()(::arbxx::size i, ::arbxx::size j) noexcept { return *reinterpret_cast<Arb*>(arb_mat_entry(t, i, j)); }
+
+const Arb& ArbMatrix::operator()(::arbxx::size i, ::arbxx::size j) const noexcept { return *reinterpret_cast<const Arb*>(arb_mat_entry(t, i, j)); }
+
+ArbMatrix ArbMatrix::mul(const ArbMatrix& rhs, prec precision, Algorithm algorithm) const {
+  LIBARBXX_CHECK_ARGUMENT(ncols() == rhs.nrows(), "dimensions of matrices are not compatible");
+
+  ArbMatrix ret(nrows(), rhs.ncols());
+
+  switch (algorithm) {
+    case Algorithm::AUTOMATIC:
+      arb_mat_mul(ret.t, t, rhs.t, precision);
+      break;
+    case Algorithm::CLASSICAL:
+      arb_mat_mul_classical(ret.t, t, rhs.t, precision);
+      break;
+    case Algorithm::THREADED:
+      arb_mat_mul_threaded(ret.t, t, rhs.t, precision);
+      break;
+    case Algorithm::BLOCK:
+      arb_mat_mul_block(ret.t, t, rhs.t, precision);
+      break;
+    default:
+      LIBARBXX_UNREACHABLE("unknown algorithm for matrix multiplication");
+  }
+
+  return ret;
+}
+
+std::optional<ArbMatrix> ArbMatrix::solve(const ArbMatrix& rhs, prec precision) const {
+  LIBARBXX_CHECK_ARGUMENT(nrows() == ncols(), "matrix must be square");
+  LIBARBXX_CHECK_ARGUMENT(nrows() == rhs.nrows(), "dimensions of matrices are not compatible");
+
+  ArbMatrix ret(rhs.nrows(), rhs.ncols());
+  if (!arb_mat_solve(ret.t, t, rhs.t, precision))
+    return std::nullopt;
+  return ret;
+}
+
+std::optional<ArbMatrix> ArbMatrix::inv(prec precision) const {
+  LIBARBXX_CHECK_ARGUMENT(nrows() == ncols(), "matrix must be square");
+
+  ArbMatrix ret(nrows(), ncols());
+  if (!arb_mat_inv(ret.t, t, precision))
+    return std::nullopt;
+  return ret;
+}
+
+Arb ArbMatrix::det(prec precision) const {
+  LIBARBXX_CHECK_ARGUMENT(nrows() == ncols(), "matrix must be square");
+
+  Arb ret;
+  arb_mat_det(ret.arb_t(), t, precision);
+  return ret;
+}
+
+bool ArbMatrix::equal(const ArbMatrix& rhs) const {
+  if (nrows() != rhs.nrows() || ncols() != rhs.ncols())
+    return false;
+  return arb_mat_equal(t, rhs.t);
+}
+
+arb_mat_t& ArbMatrix::arb_mat_t() noexcept { return t; }
+
+const arb_mat_t& ArbMatrix::arb_mat_t() const noexcept { return t; }
+
+void swap(ArbMatrix& A, ArbMatrix& B) noexcept {
+  arb_mat_swap(A.t, B.t);
+}
+
+std::ostream& operator<<(std::ostream& os, const ArbMatrix& self) {
+  os << "[";
+  for (::arbxx::size i = 0; i < self.nrows(); i++) {
+    if (i)
+      os << ", ";
+    os << "[";
+    for (::arbxx::size j = 0; j < self.ncols(); j++) {
+      if (j)
+        os << ", ";
+      os << self(i, j);
+    }
+    os << "]";
+  }
+  return os << "]";
+}
+
+}  // namespace arbxx
@@ -0,0 +1,209 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/arb_poly.hpp"
+
+#include <arb_poly.h>
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+
+#include "util/assert.ipp"
+#include "util/thread_pool.ipp"
+
+namespace arbxx {
+
+namespace {
+
+// The number of points that Horner's method evaluates together, i.e., for
+// each block of points, every coefficient is only read once.
+constexpr ::arbxx::size HORNER_BLOCK = 32;
+
+// The degree and the number of points from which on AUTOMATIC uses fast
+// multipoint evaluation. Below this, the subproduct tree is not worth
+// building.
+constexpr ::arbxx::size FAST_THRESHOLD = 256;
+
+// Evaluate the polynomial of length coefficients f at the points x and
+// write the values to y with Horner's method.
+void horner(arb_ptr y, arb_srcptr f, ::arbxx::size length, arb_srcptr x, ::arbxx::size points, prec precision) {
+  if (length == 0) {
+    for (::arbxx::size j = 0; j < points; j++)
+      arb_zero(y + j);
+    return;
+  }
+
+  for (::arbxx::size j = 0; j < points; j++)
+    arb_set_round(y + j, f + length - 1, precision);
+
+  for (::arbxx::size i = length - 2; i >= 0; i--) {
+    for (::arbxx::size j = 0; j < points; j++) {
+      arb_mul(y + j, y + j, x + j, precision);
+      arb_add(y + j, y + j, f + i, precision);
+    }
+  }
+}
+
+}  // namespace
+
+ArbPoly::ArbPoly() noexcept { arb_poly_init(t); }
+
+ArbPoly::ArbPoly(const std::vector<Arb>& coefficients) : ArbPoly() {
+  const auto length = static_cast<::arbxx::size>(coefficients.size());
+  arb_poly_fit_length(t, length);
+  for (::arbxx::size i = 0; i < length; i++)
+    arb_set(t->coeffs + i, coefficients[i].arb_t());
+  _arb_poly_set_length(t, length);
+  _arb_poly_normalise(t);
+}
+
+ArbPoly::ArbPoly(const ArbPoly& f) : ArbPoly() { arb_poly_set(t, f.t); }
+
+ArbPoly::ArbPoly(ArbPoly&& f) noexcept {
+  *t = *f.t;
+  arb_poly_init(f.t);
+}
+
+ArbPoly::~ArbPoly() noexcept { arb_poly_clear(t); }
+
+ArbPoly& ArbPoly::operator=(const ArbPoly& f) {
+  if (this != &f)
+    arb_poly_set(t, f.t);
+  return *this;
+}
+
+ArbPoly& ArbPoly::operator=(ArbPoly&& f) noexcept {
+  swap(*this, f);
+  return *this;
+}
+
+ArbPoly ArbPoly::randtest(flint::frandxx& state, ::arbxx::size length, prec precision, prec magbits) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length of a polynomial must not be negative");
+
+  ArbPoly ret;
+  arb_poly_randtest(ret.t, state._data(), length, precision, magbits);
+  return ret;
+}
+
+::arbxx::size ArbPoly::length() const noexcept { return arb_poly_length(t); }
+
+::arbxx::size ArbPoly::degree() const noexcept { return arb_poly_degree(t); }
+
+Arb ArbPoly::get_coeff(::arbxx::size n) const {
+  LIBARBXX_CHECK_ARGUMENT(n >= 0, "index of a coefficient must not be negative");
+
+  Arb ret;
+  arb_poly_get_coeff_arb(ret.arb_t(), t, n);
+  return ret;
+}
+
+void ArbPoly::set_coeff(::arbxx::size n, const Arb& c) {
+  LIBARBXX_CHECK_ARGUMENT(n >= 0, "index of a coefficient must not be negative");
+
+  arb_poly_set_coeff_arb(t, n, c.arb_t());
+}
+
+ArbPoly ArbPoly::add(const ArbPoly& rhs, prec precision) const {
+  ArbPoly ret;
+  arb_poly_add(ret.t, t, rhs.t, precision);
+  return ret;
+}
+
+ArbPoly ArbPoly::sub(const ArbPoly& rhs, prec precision) const {
+  ArbPoly ret;
+  arb_poly_sub(ret.t, t, rhs.t, precision);
+  return ret;
+}
+
+ArbPoly ArbPoly::mul(const ArbPoly& rhs, prec precision) const {
+  ArbPoly ret;
+  arb_poly_mul(ret.t, t, rhs.t, precision);
+  return ret;
+}
+
+ArbPoly ArbPoly::neg() const {
+  ArbPoly ret;
+  arb_poly_neg(ret.t, t);
+  return ret;
+}
+
+Arb ArbPoly::evaluate(const Arb& x, prec precision) const {
+  Arb ret;
+  arb_poly_evaluate(ret.arb_t(), t, x.arb_t(), precision);
+  return ret;
+}
+
+std::vector<Arb> ArbPoly::evaluate(const Arb* x, ::arbxx::size length, prec precision, Algorithm algorithm) const {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "number of points must not be negative");
+
+  std::vector<Arb> ret(static_cast<size_t>(length));
+  evaluate(ret.data(), x, length, precision, algorithm);
+  return ret;
+}
+
+std::vector<Arb> ArbPoly::evaluate(const std::vector<Arb>& x, prec precision, Algorithm algorithm) const {
+  return evaluate(x.data(), static_cast<::arbxx::size>(x.size()), precision, algorithm);
+}
+
+// The points and values are Arb which have the same layout as an
+// arb_struct, see the static_assert in arb_vector.cc.
+void ArbPoly::evaluate(Arb* y, const Arb* x, ::arbxx::size length, prec precision, Algorithm algorithm) const {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "number of points must not be negative");
+
+  if (algorithm == Algorithm::AUTOMATIC)
+    algorithm = std::min(this->length(), length) >= FAST_THRESHOLD ? Algorithm::FAST : Algorithm::HORNER;
+
+  arb_ptr values = reinterpret_cast<arb_ptr>(y);
+  arb_srcptr points = reinterpret_cast<arb_srcptr>(x);
+
+  switch (algorithm) {
+    case Algorithm::HORNER:
+      run_on_threads((length + HORNER_BLOCK - 1) / HORNER_BLOCK, [&](::arbxx::size block) {
+        const ::arbxx::size begin = block * HORNER_BLOCK;
+        horner(values + begin, t->coeffs, this->length(), points + begin, std::min(HORNER_BLOCK, length - begin), precision);
+      });
+      break;
+    case Algorithm::FAST:
+      arb_poly_evaluate_vec_fast(values, t, points, length, precision);
+      break;
+    default:
+      LIBARBXX_UNREACHABLE("unknown algorithm for evaluation of polynomials");
+  }
+}
+
+bool ArbPoly::equal(const ArbPoly& rhs) const { return arb_poly_equal(t, rhs.t); }
+
+arb_poly_t& ArbPoly::arb_poly_t() noexcept { return t; }
+
+const arb_poly_t& ArbPoly::arb_poly_t() const noexcept { return t; }
+
+void swap(ArbPoly& f, ArbPoly& g) noexcept { arb_poly_swap(f.t, g.t); }
+
+std::ostream& operator<<(std::ostream& os, const ArbPoly& self) {
+  os << "[";
+  for (::arbxx::size i = 0; i < self.length(); i++) {
+    if (i)
+      os << ", ";
+    os << *reinterpret_cast<const Arb*>(self.t->coeffs + i);
+  }
+  return os << "]";
+}
+
+}  // namespace arbxx
@@ -0,0 +1,201 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/arb_vector.hpp"
+
+#include <arb.h>
+#include <flint/fmpz.h>
+
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+// We hand out references to the arb_struct in our block of memory as
+// references to Arb, so an Arb must be nothing but an arb_struct.
+static_assert(sizeof(Arb) == sizeof(arb_struct), "Arb must have the same layout as arb_struct");
+static_assert(std::is_standard_layout_v<Arb>, "Arb must have the same layout as arb_struct");
+
+ArbVector::ArbVector() noexcept : data(nullptr), length(0) {}
+
+ArbVector::ArbVector(::arbxx::size length) : data(nullptr), length(length) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length of vector must not be negative");
+  if (length)
+    data = _arb_vec_init(length);
+}
+
+ArbVector::ArbVector(const std::vector<long>& values) : ArbVector(static_cast<::arbxx::size>(values.size())) {
+  for (::arbxx::size i = 0; i < length; i++)
+    arb_set_si(data + i, values[i]);
+}
+
+ArbVector::ArbVector(const std::vector<mpz_class>& values) : ArbVector(static_cast<::arbxx::size>(values.size())) {
+  for (::arbxx::size i = 0; i < length; i++) {
+    fmpz_t z;
+    fmpz_init_set_readonly(z, values[i].get_mpz_t());
+    arb_set_fmpz(data + i, z);
+    fmpz_clear_readonly(z);
+  }
+}
+
+ArbVector::ArbVector(const std::vector<Arb>& values) : ArbVector(static_cast<::arbxx::size>(values.size())) {
+  for (::arbxx::size i = 0; i < length; i++)
+    arb_set(data + i, values[i].arb_t());
+}
+
+ArbVector::ArbVector(const ArbVector& rhs) : ArbVector(rhs.length) {
+  _arb_vec_set(data, rhs.data, length);
+}
+
+ArbVector::ArbVector(ArbVector&& rhs) noexcept : data(std::exchange(rhs.data, nullptr)), length(std::exchange(rhs.length, 0)) {}
+
+ArbVector::~ArbVector() noexcept {
+  if (data)
+    _arb_vec_clear(data, length);
+}
+
+ArbVector& ArbVector::operator=(const ArbVector& rhs) {
+  if (this == &rhs)
+    return *this;
+
+  if (length == rhs.length) {
+    _arb_vec_set(data, rhs.data, length);
+    return *this;
+  }
+
+  return *this = ArbVector(rhs);
+}
+
+ArbVector& ArbVector::operator=(ArbVector&& rhs) noexcept {
+  swap(*this, rhs);
+  return *this;
+}
+
+::arbxx::size ArbVector::size() const noexcept { return length; }
+
+bool ArbVector::empty() const noexcept { return length == 0; }
+
+Arb& ArbVector::operator[](::arbxx::size i) noexcept { return reinterpret_cast<Arb*>(data)[i]; }
+
+const Arb& ArbVector::operator[](::arbxx::size i) const noexcept { return reinterpret_cast<const Arb*>(data)[i]; }
+
+ArbVector::iterator ArbVector::begin() noexcept { return reinterpret_cast<Arb*>(data); }
+
+ArbVector::iterator ArbVector::end() noexcept { return begin() + length; }
+
+ArbVector::const_iterator ArbVector::begin() const noexcept { return reinterpret_cast<const Arb*>(data); }
+
+ArbVector::const_iterator ArbVector::end() const noexcept { return begin() + length; }
+
+arb_ptr ArbVector::arb_ptr() noexcept { return data; }
+
+arb_srcptr ArbVector::arb_ptr() const noexcept { return data; }
+
+ArbVector& ArbVector::add(const ArbVector& rhs, prec precision) {
+  LIBARBXX_CHECK_ARGUMENT(length == rhs.length, "vectors must have the same length");
+  _arb_vec_add(data, data, rhs.data, length, precision);
+  return *this;
+}
+
+ArbVector& ArbVector::sub(const ArbVector& rhs, prec precision) {
+  LIBARBXX_CHECK_ARGUMENT(length == rhs.length, "vectors must have the same length");
+  _arb_vec_sub(data, data, rhs.data, length, precision);
+  return *this;
+}
+
+ArbVector& ArbVector::mul(const ArbVector& rhs, prec precision) {
+  LIBARBXX_CHECK_ARGUMENT(length == rhs.length, "vectors must have the same length");
+  // Arb has no _arb_vec_mul, but at least we only pay for a single call into
+  // our library for the entire vector.
+  for (::arbxx::size i = 0; i < length; i++)
+    arb_mul(data + i, data + i, rhs.data + i, precision);
+  return *this;
+}
+
+ArbVector& ArbVector::neg() {
+  _arb_vec_neg(data, data, length);
+  return *this;
+}
+
+ArbVector& ArbVector::scalar_mul(const Arb& c, prec precision) {
+  _arb_vec_scalar_mul(data, data, length, c.arb_t(), precision);
+  return *this;
+}
+
+ArbVector& ArbVector::scalar_addmul(const ArbVector& rhs, const Arb& c, prec precision) {
+  LIBARBXX_CHECK_ARGUMENT(length == rhs.length, "vectors must have the same length");
+  _arb_vec_scalar_addmul(data, rhs.data, length, c.arb_t(), precision);
+  return *this;
+}
+
+Arb ArbVector::dot(const ArbVector& rhs, prec precision) const {
+  LIBARBXX_CHECK_ARGUMENT(length == rhs.length, "vectors must have the same length");
+  Arb ret;
+  arb_dot(ret.arb_t(), nullptr, 0, data, 1, rhs.data, 1, length, precision);
+  return ret;
+}
+
+Arb ArbVector::sum(prec precision) const {
+  // A dot product with a stride zero vector of ones adds up all the entries
+  // with a single rounding.
+  const slong one = 1;
+  Arb ret;
+  arb_dot_si(ret.arb_t(), nullptr, 0, data, 1, &one, 0, length, precision);
+  return ret;
+}
+
+bool ArbVector::equal(const ArbVector& rhs) const {
+  if (length != rhs.length)
+    return false;
+
+  for (::arbxx::size i = 0; i < length; i++)
+    if (!arb_equal(data + i, rhs.data + i))
+      return false;
+
+  return true;
+}
+
+ArbVector::operator std::vector<double>() const {
+  std::vector<double> ret(length);
+  for (::arbxx::size i = 0; i < length; i++)
+    ret[i] = arf_get_d(arb_midref(data + i), ARF_RND_NEAR);
+  return ret;
+}
+
+void swap(ArbVector& lhs, ArbVector& rhs) noexcept {
+  using std::swap;
+  swap(lhs.data, rhs.data);
+  swap(lhs.length, rhs.length);
+}
+
+std::ostream& operator<<(std::ostream& os, const ArbVector& self) {
+  os << "[";
+  for (::arbxx::size i = 0; i < self.size(); i++) {
+    if (i)
+      os << ", ";
+    os << self[i];
+  }
+  return os << "]";
+}
+
+}  // namespace arbxx
@@ -0,0 +1,391 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/arena.hpp"
+
+#include <flint/flint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+// A block of memory from which an arena hands out allocations.
+struct Arena::Chunk {
+  char* begin;
+  char* end;
+  char* cursor;
+
+  // The number of live allocations in this chunk plus one while the arena
+  // that owns this chunk is alive. Whoever drops this to zero releases the
+  // chunk.
+  std::atomic<std::size_t> references;
+
+  bool contains(const void* ptr) const noexcept { return begin <= ptr && ptr < end; }
+};
+
+namespace {
+
+// Every allocation from an arena is prefixed by its size so that it can be
+// reallocated.
+struct alignas(16) Prefix {
+  std::size_t size;
+};
+
+// The innermost arena of this thread.
+thread_local Arena* current = nullptr;
+
+// The memory functions that FLINT used before we installed our own.
+void* (*underlying_malloc)(size_t);
+void* (*underlying_calloc)(size_t, size_t);
+void* (*underlying_realloc)(void*, size_t);
+void (*underlying_free)(void*);
+
+std::once_flag installed;
+
+}  // namespace
+
+// Implements the memory functions that we install into FLINT.
+struct LIBARBXX_LOCAL ArenaAllocator {
+  // The memory of a chunk of some arena.
+  struct Range {
+    const char* begin;
+    const char* end;
+    Arena::Chunk* chunk;
+
+    bool operator<(const Range& rhs) const noexcept { return begin < rhs.begin; }
+  };
+
+  // An immutable snapshot of all chunks of all arenas in all threads, sorted
+  // by the address of their memory. Since memory can be freed in a different
+  // thread, this is needed to decide whether a pointer has been allocated
+  // from an arena.
+  using Registry = std::vector<Range>;
+
+  // Announces which snapshot of the registry a thread is currently reading
+  // so that it is not freed underneath it.
+  struct Hazard {
+    std::atomic<const Registry*> reading{nullptr};
+    bool used = true;
+  };
+
+  // Releases the hazard of a thread when the thread terminates.
+  struct HazardOwner {
+    ~HazardOwner();
+  };
+
+  // The registry is replaced whenever a chunk is created or destroyed, which
+  // is rare compared to the lookups that happen on every free. Lookups
+  // therefore take no locks; writers serialize on the mutex, publish a new
+  // snapshot, and free old snapshots that no thread announces to be reading.
+  // (None of this is ever destroyed since memory might be freed during
+  // static deinitialization.)
+  static inline std::mutex registry_mutex;
+  static inline std::atomic<const Registry*> registry{nullptr};
+  static inline std::atomic<std::size_t> registered{0};
+  static inline std::vector<const Registry*>* retired = nullptr;
+  static inline std::vector<Hazard*>* hazards = nullptr;
+
+  static void install() {
+    std::call_once(installed, []() {
+      registry = new Registry();
+      retired = new std::vector<const Registry*>();
+      hazards = new std::vector<Hazard*>();
+      __flint_get_memory_functions(&underlying_malloc, &underlying_calloc, &underlying_realloc, &underlying_free);
+      __flint_set_memory_functions(&malloc, &calloc, &realloc, &free);
+    });
+  }
+
+  static constexpr std::size_t align(std::size_t size) noexcept { return (size + alignof(Prefix) - 1) & ~(alignof(Prefix) - 1); }
+
+  // Replace the registry with `next`. The caller must hold the registry
+  // mutex.
+  static void publish(const Registry* next) noexcept {
+    retired->push_back(registry.exchange(next));
+
+    retired->erase(std::remove_if(retired->begin(), retired->end(),
+                                  [](const Registry* snapshot) {
+                                    for (const Hazard* hazard : *hazards)
+                                      if (hazard->reading.load() == snapshot)
+                                        return false;
+                                    delete snapshot;
+                                    return true;
+                                  }),
+                   retired->end());
+  }
+
+  static Arena::Chunk* create(std::size_t size) {
+    char* memory = static_cast<char*>(underlying_malloc(size));
+    if (memory == nullptr)
+      return nullptr;
+
+    auto* chunk = new Arena::Chunk{memory, memory + size, memory, {1}};
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto* next = new Registry(*registry.load());
+    const Range range{chunk->begin, chunk->end, chunk};
+    next->insert(std::upper_bound(next->begin(), next->end(), range), range);
+    publish(next);
+    registered.fetch_add(1, std::memory_order_release);
+
+    return chunk;
+  }
+
+  static void destroy(Arena::Chunk* chunk) noexcept {
+    {
+      std::lock_guard<std::mutex> lock(registry_mutex);
+      auto* next = new Registry(*registry.load());
+      next->erase(std::remove_if(next->begin(), next->end(), [&](const Range& range) { return range.chunk == chunk; }), next->end());
+      publish(next);
+      registered.fetch_sub(1, std::memory_order_release);
+    }
+
+    underlying_free(chunk->begin);
+    delete chunk;
+  }
+
+  // Return the chunk of `registry` that contains `ptr` or nullptr if there is
+  // no such chunk.
+  static Arena::Chunk* lookup(const Registry& registry, const void* ptr) noexcept {
+    auto it = std::upper_bound(registry.begin(), registry.end(), Range{static_cast<const char*>(ptr), nullptr, nullptr});
+    if (it == registry.begin())
+      return nullptr;
+    --it;
+    // Only the bounds stored in the snapshot are used to decide containment.
+    // The chunk itself might already be gone if `ptr` is not from it.
+    return it->begin <= ptr && ptr < it->end ? it->chunk : nullptr;
+  }
+
+  // Return the hazard of the current thread or nullptr if the thread is
+  // terminating.
+  static Hazard* hazard() noexcept;
+
+  // Return the chunk that `ptr` has been allocated from or nullptr if it has
+  // not been allocated from an arena.
+  static Arena::Chunk* find(const void* ptr) noexcept {
+    // Most memory is freed by the thread that allocated it.
+    for (const Arena* arena = current; arena != nullptr; arena = arena->previous)
+      for (auto chunk = arena->chunks.rbegin(); chunk != arena->chunks.rend(); chunk++)
+        if ((*chunk)->contains(ptr))
+          return *chunk;
+
+    if (registered.load(std::memory_order_acquire) == 0)
+      return nullptr;
+
+    Hazard* hazard = ArenaAllocator::hazard();
+    if (hazard == nullptr) {
+      std::lock_guard<std::mutex> lock(registry_mutex);
+      return lookup(*registry.load(), ptr);
+    }
+
+    // Announce the snapshot we are going to read and make sure that it has
+    // not been replaced (and possibly freed) before the announcement became
+    // visible to writers.
+    const Registry* snapshot = registry.load();
+    while (true) {
+      hazard->reading.store(snapshot);
+      const Registry* published = registry.load();
+      if (published == snapshot)
+        break;
+      snapshot = published;
+    }
+
+    Arena::Chunk* chunk = lookup(*snapshot, ptr);
+    hazard->reading.store(nullptr, std::memory_order_release);
+    return chunk;
+  }
+
+  // Return `size` bytes from the innermost arena of this thread.
+  static void* allocate(Arena& arena, std::size_t size) noexcept {
+    const std::size_t bytes = sizeof(Prefix) + align(size);
+
+    if (bytes > arena.chunk_size / 2)
+      return underlying_malloc(size);
+
+    Arena::Chunk* chunk = arena.chunks.empty() ? nullptr : arena.chunks.back();
+    if (chunk == nullptr || bytes > static_cast<std::size_t>(chunk->end - chunk->cursor)) {
+      // Reuse a chunk whose allocations have all been freed, or allocate a
+      // new one.
+      auto unused = std::find_if(arena.chunks.begin(), arena.chunks.end(), [](Arena::Chunk* c) { return c->references.load(std::memory_order_acquire) == 1; });
+      if (unused != arena.chunks.end()) {
+        chunk = *unused;
+        chunk->cursor = chunk->begin;
+        std::rotate(unused, unused + 1, arena.chunks.end());
+      } else {
+        chunk = create(arena.chunk_size);
+        if (chunk == nullptr)
+          return nullptr;
+        arena.chunks.push_back(chunk);
+      }
+    }
+
+    auto* prefix = reinterpret_cast<Prefix*>(chunk->cursor);
+    prefix->size = size;
+    chunk->cursor += bytes;
+    chunk->references.fetch_add(1, std::memory_order_relaxed);
+    arena.served++;
+
+    return prefix + 1;
+  }
+
+  // Release an allocation from `chunk`.
+  static void release(Arena::Chunk* chunk, void* ptr) noexcept {
+    const std::size_t references = chunk->references.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+    if (references == 0) {
+      destroy(chunk);
+      return;
+    }
+
+    if (current != nullptr && !current->chunks.empty() && current->chunks.back() == chunk) {
+      if (references == 1) {
+        // All allocations from the current chunk have been freed; start over.
+        chunk->cursor = chunk->begin;
+      } else {
+        // Undo the last allocation if this was it.
+        Prefix* prefix = static_cast<Prefix*>(ptr) - 1;
+        if (reinterpret_cast<char*>(ptr) + align(prefix->size) == chunk->cursor)
+          chunk->cursor = reinterpret_cast<char*>(prefix);
+      }
+    }
+  }
+
+  static void* malloc(size_t size) {
+    if (current != nullptr)
+      return allocate(*current, size);
+    return underlying_malloc(size);
+  }
+
+  static void* calloc(size_t count, size_t size) {
+    if (current != nullptr) {
+      if (size != 0 && count > SIZE_MAX / size)
+        return nullptr;
+
+      void* ptr = allocate(*current, count * size);
+      if (ptr != nullptr)
+        std::memset(ptr, 0, count * size);
+      return ptr;
+    }
+    return underlying_calloc(count, size);
+  }
+
+  static void* realloc(void* ptr, size_t size) {
+    if (ptr == nullptr)
+      return malloc(size);
+
+    Arena::Chunk* chunk = find(ptr);
+    if (chunk == nullptr)
+      return underlying_realloc(ptr, size);
+
+    Prefix* prefix = static_cast<Prefix*>(ptr) - 1;
+
+    // Grow the last allocation of the current chunk in place.
+    if (current != nullptr && !current->chunks.empty() && current->chunks.back() == chunk && reinterpret_cast<char*>(ptr) + align(prefix->size) == chunk->cursor && align(size) <= static_cast<std::size_t>(chunk->end - reinterpret_cast<char*>(ptr)) && sizeof(Prefix) + align(size) <= current->chunk_size / 2) {
+      chunk->cursor = reinterpret_cast<char*>(ptr) + align(size);
+      prefix->size = size;
+      return ptr;
+    }
+
+    void* moved = malloc(size);
+    if (moved == nullptr)
+      return nullptr;
+
+    std::memcpy(moved, ptr, std::min(prefix->size, size));
+    release(chunk, ptr);
+    return moved;
+  }
+
+  static void free(void* ptr) {
+    if (ptr == nullptr)
+      return;
+
+    Arena::Chunk* chunk = find(ptr);
+    if (chunk == nullptr)
+      underlying_free(ptr);
+    else
+      release(chunk, ptr);
+  }
+};
+
+namespace {
+
+// The hazard of this thread. This is trivially destructible, so it can
+// still be inspected while other thread locals are being destroyed.
+thread_local ArenaAllocator::Hazard* current_hazard = nullptr;
+thread_local bool terminating = false;
+
+}  // namespace
+
+ArenaAllocator::HazardOwner::~HazardOwner() {
+  terminating = true;
+  if (current_hazard == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  current_hazard->reading.store(nullptr);
+  current_hazard->used = false;
+  current_hazard = nullptr;
+}
+
+ArenaAllocator::Hazard* ArenaAllocator::hazard() noexcept {
+  if (current_hazard == nullptr && !terminating) {
+    // Hazards are never freed but reused by later threads.
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto unused = std::find_if(hazards->begin(), hazards->end(), [](const Hazard* h) { return !h->used; });
+    if (unused == hazards->end()) {
+      hazards->push_back(new Hazard());
+      unused = hazards->end() - 1;
+    }
+    (*unused)->used = true;
+    current_hazard = *unused;
+
+    static thread_local HazardOwner owner;
+  }
+  return current_hazard;
+}
+
+Arena::Arena(std::size_t chunk_size) : previous(current), chunk_size(chunk_size) {
+  LIBARBXX_CHECK_ARGUMENT(chunk_size >= 1024, "chunks of an arena must have at least 1024 bytes");
+
+  ArenaAllocator::install();
+  current = this;
+}
+
+Arena::~Arena() noexcept {
+  current = previous;
+
+  // Drop the reference that this arena holds on its chunks. Chunks that
+  // still contain live allocations are released when these are freed.
+  for (Chunk* chunk : chunks) {
+    if (chunk->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      ArenaAllocator::destroy(chunk);
+  }
+}
+
+std::size_t Arena::allocations() const noexcept { return served; }
+
+bool Arena::active() noexcept { return current != nullptr; }
+
+}  // namespace arbxx
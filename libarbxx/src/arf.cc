@@ -24,6 +24,8 @@
 
 #include <ostream>
 
+#include "../arbxx/precision.hpp"
+#include "util/hash.ipp"
 #include "util/integer.ipp"
 
 namespace {
@@ -172,6 +174,194 @@ Arf& Arf::operator=(double rhs) {
   return *this;
 }
 
+Arf& Arf::operator+=(const Arf& rhs) {
+  arf_add(t, t, rhs.t, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator+=(short rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arf& Arf::operator+=(unsigned short rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arf& Arf::operator+=(int rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arf& Arf::operator+=(unsigned int rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arf& Arf::operator+=(long rhs) {
+  arf_add_si(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator+=(unsigned long rhs) {
+  arf_add_ui(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator+=(long long rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arf& Arf::operator+=(unsigned long long rhs) {
+  return *this += to_supported_integer(rhs);
+}
+
+Arf& Arf::operator+=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arf_add_fmpz(t, t, z, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Arf& Arf::operator-=(const Arf& rhs) {
+  arf_sub(t, t, rhs.t, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator-=(short rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator-=(unsigned short rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator-=(int rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator-=(unsigned int rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator-=(long rhs) {
+  arf_sub_si(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator-=(unsigned long rhs) {
+  arf_sub_ui(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator-=(long long rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator-=(unsigned long long rhs) {
+  return *this -= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator-=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arf_sub_fmpz(t, t, z, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Arf& Arf::operator*=(const Arf& rhs) {
+  arf_mul(t, t, rhs.t, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator*=(short rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator*=(unsigned short rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator*=(int rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator*=(unsigned int rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator*=(long rhs) {
+  arf_mul_si(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator*=(unsigned long rhs) {
+  arf_mul_ui(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator*=(long long rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator*=(unsigned long long rhs) {
+  return *this *= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator*=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arf_mul_fmpz(t, t, z, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
+Arf& Arf::operator/=(const Arf& rhs) {
+  arf_div(t, t, rhs.t, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator/=(short rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator/=(unsigned short rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator/=(int rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator/=(unsigned int rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator/=(long rhs) {
+  arf_div_si(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator/=(unsigned long rhs) {
+  arf_div_ui(t, t, rhs, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  return *this;
+}
+
+Arf& Arf::operator/=(long long rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator/=(unsigned long long rhs) {
+  return *this /= to_supported_integer(rhs);
+}
+
+Arf& Arf::operator/=(const mpz_class& rhs) {
+  fmpz_t z;
+  fmpz_init_set_readonly(z, rhs.get_mpz_t());
+  arf_div_fmpz(t, t, z, PrecisionScope::precision(), static_cast<arf_rnd_t>(PrecisionScope::round()));
+  fmpz_clear_readonly(z);
+  return *this;
+}
+
 Arf& Arf::operator<<=(long rhs) {
   arf_mul_2exp_si(t, t, rhs);
   return *this;
@@ -329,7 +519,9 @@ std::ostream& operator<<(std::ostream& os, const Arf& self) {
 namespace std {
 
 size_t hash<arbxx::Arf>::operator()(const arbxx::Arf& self) const {
-  return hash<double>()(static_cast<double>(self));
+  size_t seed = 0;
+  arbxx::hash_combine(seed, self.arf_t());
+  return seed;
 }
 
 }  // namespace std
@@ -0,0 +1,165 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/compare.hpp"
+
+#include <arb.h>
+#include <arf.h>
+#include <mag.h>
+
+#include <optional>
+
+#include "../arbxx/arb_vector.hpp"
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+namespace {
+
+// An enclosure of an element x by its sign and exponents lo and hi such that
+// 2^lo <= |x| < 2^hi.
+struct Magnitude {
+  int sign;
+  slong lo;
+  slong hi;
+};
+
+// Return the magnitude of x if it can be read off the exponents of its
+// midpoint and radius, i.e., if x has a definite sign and its exponents are
+// not huge.
+std::optional<Magnitude> magnitude(const arb_t x) {
+  const arf_struct* mid = arb_midref(x);
+  const mag_struct* rad = arb_radref(x);
+
+  if (arf_is_zero(mid)) {
+    if (mag_is_zero(rad))
+      return Magnitude{0, 0, 0};
+    return std::nullopt;
+  }
+
+  if (arf_is_special(mid) || mag_is_inf(rad) || COEFF_IS_MPZ(ARF_EXP(mid)))
+    return std::nullopt;
+
+  // The midpoint m satisfies 2^(e-1) <= |m| < 2^e.
+  const slong e = ARF_EXP(mid);
+  const int sign = ARF_SGNBIT(mid) ? -1 : 1;
+
+  if (mag_is_zero(rad))
+    return Magnitude{sign, e - 1, e};
+
+  // The radius is less than 2^MAG_EXP(rad). If it is at most a quarter of
+  // 2^(e - 1), then 2^(e - 2) < |x| < 2^(e + 1).
+  if (COEFF_IS_MPZ(MAG_EXP(rad)) || MAG_EXP(rad) > e - 2)
+    return std::nullopt;
+
+  return Magnitude{sign, e - 2, e + 1};
+}
+
+std::optional<Magnitude> magnitude(long x) {
+  if (x == 0)
+    return Magnitude{0, 0, 0};
+
+  const ulong abs = x < 0 ? -static_cast<ulong>(x) : static_cast<ulong>(x);
+  const slong bits = FLINT_BIT_COUNT(abs);
+  return Magnitude{x < 0 ? -1 : 1, bits - 1, bits};
+}
+
+// Return 1 if x < y, 0 if x >= y, and -1 if this cannot be decided from the
+// magnitudes alone.
+int lt(const Magnitude& x, const Magnitude& y) {
+  if (x.sign != y.sign)
+    return x.sign < y.sign;
+
+  if (x.sign == 0)
+    return 0;
+
+  bool less;
+  if (x.hi <= y.lo)
+    less = true;
+  else if (x.lo >= y.hi)
+    less = false;
+  else
+    return -1;
+
+  // For negative elements, the smaller magnitude is the bigger element.
+  return x.sign > 0 ? less : !less;
+}
+
+std::optional<Magnitude> magnitude(const Arb& x) { return magnitude(x.arb_t()); }
+
+// Return the i-th element on the right hand side of a comparison.
+const Arb& at(const Arb* rhs, ::arbxx::size i) { return rhs[i]; }
+
+long at(long rhs, ::arbxx::size) { return rhs; }
+
+template <typename Rhs>
+Comparison compare(const Arb* lhs, Rhs rhs, ::arbxx::size length) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length must not be negative");
+
+  Comparison ret{Bitmask(length), Bitmask(length)};
+
+  for (::arbxx::size i = 0; i < length; i++) {
+    const auto& y = at(rhs, i);
+
+    int decided = -1;
+    {
+      const auto a = magnitude(lhs[i]);
+      if (a) {
+        const auto b = magnitude(y);
+        if (b)
+          decided = lt(*a, *b);
+      }
+    }
+
+    if (decided == -1) {
+      // Only now compare the actual mantissas.
+      const auto less = lhs[i] < y;
+      if (!less)
+        ret.undecided.set(i);
+      else if (*less)
+        ret.lt.set(i);
+    } else if (decided) {
+      ret.lt.set(i);
+    }
+  }
+
+  return ret;
+}
+
+}  // namespace
+
+Comparison compare(const Arb* lhs, const Arb* rhs, ::arbxx::size length) { return compare<const Arb*>(lhs, rhs, length); }
+
+Comparison compare(const Arb* lhs, long rhs, ::arbxx::size length) { return compare<long>(lhs, rhs, length); }
+
+Comparison compare(const std::vector<Arb>& lhs, const std::vector<Arb>& rhs) {
+  LIBARBXX_CHECK_ARGUMENT(lhs.size() == rhs.size(), "vectors must have the same length");
+  return compare(lhs.data(), rhs.data(), static_cast<::arbxx::size>(lhs.size()));
+}
+
+Comparison compare(const std::vector<Arb>& lhs, long rhs) { return compare(lhs.data(), rhs, static_cast<::arbxx::size>(lhs.size())); }
+
+Comparison compare(const ArbVector& lhs, const ArbVector& rhs) {
+  LIBARBXX_CHECK_ARGUMENT(lhs.size() == rhs.size(), "vectors must have the same length");
+  return compare(lhs.begin(), rhs.begin(), lhs.size());
+}
+
+Comparison compare(const ArbVector& lhs, long rhs) { return compare(lhs.begin(), rhs, lhs.size()); }
+
+}  // namespace arbxx
@@ -0,0 +1,33 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/decide.hpp"
+
+#include <stdexcept>
+
+#include "util/assert.ipp"
+
+namespace arbxx::detail {
+
+void check_decide_precisions(prec start, prec max) {
+  LIBARBXX_CHECK_ARGUMENT(start >= 1, "decide() needs a positive initial precision but got " << start);
+  LIBARBXX_CHECK_ARGUMENT(start <= max, "initial precision " << start << " of decide() exceeds the maximum precision " << max);
+}
+
+}  // namespace arbxx::detail
@@ -0,0 +1,125 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/hybrid_arb.hpp"
+
+#include <arb.h>
+#include <arf.h>
+
+#include <cmath>
+#include <ostream>
+
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+HybridArb::HybridArb(const Arb& x) : HybridArb() {
+  if (arb_is_finite(x.arb_t())) {
+    arf_t a, b;
+    arf_init(a);
+    arf_init(b);
+
+    arb_get_interval_arf(a, b, x.arb_t(), std::numeric_limits<double>::digits);
+    lower = arf_get_d(a, ARF_RND_FLOOR);
+    upper = arf_get_d(b, ARF_RND_CEIL);
+
+    arf_clear(a);
+    arf_clear(b);
+
+    if (representable(lower) && representable(upper))
+      return;
+  }
+
+  arb = std::make_unique<Arb>(x);
+}
+
+HybridArb::operator Arb() const {
+  if (arb)
+    return *arb;
+
+  Arb ret;
+
+  arf_t a, b;
+  arf_init(a);
+  arf_init(b);
+
+  arf_set_d(a, lower);
+  arf_set_d(b, upper);
+  if (lower == upper)
+    arb_set_arf(ret.arb_t(), a);
+  else
+    arb_set_interval_arf(ret.arb_t(), a, b, FALLBACK_PRECISION);
+
+  arf_clear(a);
+  arf_clear(b);
+
+  return ret;
+}
+
+void HybridArb::spill() {
+  Arb enclosure;
+
+  if (std::isnan(lower) || std::isnan(upper)) {
+    arb_indeterminate(enclosure.arb_t());
+  } else {
+    arf_t a, b;
+    arf_init(a);
+    arf_init(b);
+
+    arf_set_d(a, lower);
+    arf_set_d(b, upper);
+    arb_set_interval_arf(enclosure.arb_t(), a, b, FALLBACK_PRECISION);
+
+    arf_clear(a);
+    arf_clear(b);
+  }
+
+  arb = std::make_unique<Arb>(std::move(enclosure));
+}
+
+HybridArb HybridArb::fallback(Operation operation, const HybridArb& lhs, const HybridArb& rhs) {
+  const Arb a = static_cast<Arb>(lhs);
+  const Arb b = static_cast<Arb>(rhs);
+
+  Arb ret;
+  switch (operation) {
+    case Operation::ADD:
+      arb_add(ret.arb_t(), a.arb_t(), b.arb_t(), FALLBACK_PRECISION);
+      break;
+    case Operation::SUB:
+      arb_sub(ret.arb_t(), a.arb_t(), b.arb_t(), FALLBACK_PRECISION);
+      break;
+    case Operation::MUL:
+      arb_mul(ret.arb_t(), a.arb_t(), b.arb_t(), FALLBACK_PRECISION);
+      break;
+    case Operation::DIV:
+      arb_div(ret.arb_t(), a.arb_t(), b.arb_t(), FALLBACK_PRECISION);
+      break;
+    default:
+      LIBARBXX_UNREACHABLE("unknown operation on HybridArb");
+  }
+
+  return HybridArb(ret);
+}
+
+std::ostream& operator<<(std::ostream& os, const HybridArb& self) {
+  return os << static_cast<Arb>(self);
+}
+
+}  // namespace arbxx
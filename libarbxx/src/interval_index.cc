@@ -0,0 +1,198 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/interval_index.hpp"
+
+#include <arb.h>
+#include <arf.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+namespace {
+
+// Set lower and upper to the endpoints of x.
+void endpoints(arf_t lower, arf_t upper, const arb_t x) {
+  if (arf_is_nan(arb_midref(x))) {
+    arf_neg_inf(lower);
+    arf_pos_inf(upper);
+    return;
+  }
+
+  // This is exact unless the radius is much smaller than the last bit of
+  // the midpoint.
+  const prec precision = std::max<slong>(arb_bits(x), MAG_BITS) + MAG_BITS;
+  arb_get_interval_arf(lower, upper, x, precision);
+}
+
+// Return the endpoints of the length elements starting at x.
+std::pair<std::vector<Arf>, std::vector<Arf>> endpoints(const Arb* x, ::arbxx::size length) {
+  std::vector<Arf> lower(static_cast<size_t>(length)), upper(static_cast<size_t>(length));
+  for (::arbxx::size i = 0; i < length; i++)
+    endpoints(lower[i].arf_t(), upper[i].arf_t(), x[i].arb_t());
+  return {std::move(lower), std::move(upper)};
+}
+
+// Return the positions of the intervals [lower, upper] ordered by their
+// lower endpoints, then by their upper endpoints.
+std::vector<::arbxx::size> order(const std::vector<Arf>& lower, const std::vector<Arf>& upper) {
+  std::vector<::arbxx::size> ret(lower.size());
+  std::iota(ret.begin(), ret.end(), 0);
+  std::sort(ret.begin(), ret.end(), [&](::arbxx::size i, ::arbxx::size j) {
+    if (const int cmp = arf_cmp(lower[i].arf_t(), lower[j].arf_t()))
+      return cmp < 0;
+    if (const int cmp = arf_cmp(upper[i].arf_t(), upper[j].arf_t()))
+      return cmp < 0;
+    return i < j;
+  });
+  return ret;
+}
+
+}  // namespace
+
+std::vector<::arbxx::size> interval_sort(Arb* x, ::arbxx::size length) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length must not be negative");
+
+  const auto [lower, upper] = endpoints(x, length);
+  const auto permutation = order(lower, upper);
+
+  // Apply the permutation by following its cycles so that every element is
+  // only swapped into place once.
+  std::vector<bool> done(permutation.size());
+  for (::arbxx::size i = 0; i < length; i++) {
+    if (done[i])
+      continue;
+    for (::arbxx::size j = i;; j = permutation[j]) {
+      done[j] = true;
+      if (permutation[j] == i)
+        break;
+      arb_swap(x[j].arb_t(), x[permutation[j]].arb_t());
+    }
+  }
+
+  return permutation;
+}
+
+std::vector<::arbxx::size> interval_sort(std::vector<Arb>& x) { return interval_sort(x.data(), static_cast<::arbxx::size>(x.size())); }
+
+std::vector<::arbxx::size> interval_clusters(const Arb* x, ::arbxx::size length) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length must not be negative");
+
+  std::vector<::arbxx::size> ret;
+
+  // The largest upper endpoint of the current cluster.
+  Arf reach, lower, upper;
+  for (::arbxx::size i = 0; i < length; i++) {
+    endpoints(lower.arf_t(), upper.arf_t(), x[i].arb_t());
+
+    if (i == 0 || arf_cmp(lower.arf_t(), reach.arf_t()) > 0) {
+      ret.push_back(i);
+      swap(reach, upper);
+    } else if (arf_cmp(upper.arf_t(), reach.arf_t()) > 0) {
+      swap(reach, upper);
+    }
+  }
+
+  ret.push_back(length);
+  return ret;
+}
+
+std::vector<::arbxx::size> interval_clusters(const std::vector<Arb>& x) { return interval_clusters(x.data(), static_cast<::arbxx::size>(x.size())); }
+
+IntervalIndex::IntervalIndex() noexcept {}
+
+IntervalIndex::IntervalIndex(const Arb* x, ::arbxx::size length) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length must not be negative");
+
+  auto [lower, upper] = endpoints(x, length);
+  indices = order(lower, upper);
+
+  this->lower.resize(indices.size());
+  this->upper.resize(indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    swap(this->lower[i], lower[indices[i]]);
+    swap(this->upper[i], upper[indices[i]]);
+  }
+
+  // Compute the largest upper endpoint of each subtree bottom up.
+  maximum.resize(indices.size());
+  const auto build = [&](const auto& build, ::arbxx::size begin, ::arbxx::size end) -> const Arf* {
+    if (begin == end)
+      return nullptr;
+
+    const ::arbxx::size root = begin + (end - begin) / 2;
+    const Arf* max = &this->upper[root];
+    for (const Arf* child : {build(build, begin, root), build(build, root + 1, end)})
+      if (child != nullptr && arf_cmp(child->arf_t(), max->arf_t()) > 0)
+        max = child;
+
+    arf_set(maximum[root].arf_t(), max->arf_t());
+    return &maximum[root];
+  };
+  build(build, 0, size());
+}
+
+IntervalIndex::IntervalIndex(const std::vector<Arb>& x) : IntervalIndex(x.data(), static_cast<::arbxx::size>(x.size())) {}
+
+::arbxx::size IntervalIndex::size() const noexcept { return static_cast<::arbxx::size>(indices.size()); }
+
+std::vector<::arbxx::size> IntervalIndex::containing(const Arf& x) const {
+  std::vector<::arbxx::size> ret;
+  if (!arf_is_nan(x.arf_t()))
+    query(0, size(), x, x, ret);
+  return ret;
+}
+
+std::vector<::arbxx::size> IntervalIndex::overlapping(const Arb& y) const {
+  Arf lower, upper;
+  endpoints(lower.arf_t(), upper.arf_t(), y.arb_t());
+
+  std::vector<::arbxx::size> ret;
+  query(0, size(), lower, upper, ret);
+  return ret;
+}
+
+void IntervalIndex::query(::arbxx::size begin, ::arbxx::size end, const Arf& lower, const Arf& upper, std::vector<::arbxx::size>& indices) const {
+  if (begin == end)
+    return;
+
+  const ::arbxx::size root = begin + (end - begin) / 2;
+
+  // No ball in this subtree reaches lower.
+  if (arf_cmp(maximum[root].arf_t(), lower.arf_t()) < 0)
+    return;
+
+  query(begin, root, lower, upper, indices);
+
+  // The root and all balls to its right start after upper.
+  if (arf_cmp(this->lower[root].arf_t(), upper.arf_t()) > 0)
+    return;
+
+  if (arf_cmp(this->upper[root].arf_t(), lower.arf_t()) >= 0)
+    indices.push_back(this->indices[root]);
+
+  query(root + 1, end, lower, upper, indices);
+}
+
+}  // namespace arbxx
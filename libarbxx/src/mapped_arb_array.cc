@@ -0,0 +1,297 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/mapped_arb_array.hpp"
+
+#include <arb.h>
+#include <fcntl.h>
+#include <flint/fmpz.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+
+#include "../arbxx/arb_vector.hpp"
+
+namespace arbxx {
+
+namespace {
+
+// The header of a file written by MappedArbArray::write(), see the
+// documentation of MappedArbArray for a description of the fields.
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byteorder;
+  std::uint32_t limb_bits;
+  std::uint32_t record_size;
+  std::uint64_t length;
+  std::uint8_t reserved[32];
+};
+
+static_assert(sizeof(Header) == 64, "header of a mapped array must have 64 bytes");
+
+constexpr char MAGIC[8] = {'A', 'R', 'B', 'X', 'X', 'M', 'A', 'P'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t BYTEORDER = 0x01020304;
+
+// Return whether an arb_struct does not refer to any memory outside of the
+// struct itself.
+bool is_inline(const arb_struct& x) noexcept {
+  return !ARF_HAS_PTR(arb_midref(&x)) && !COEFF_IS_MPZ(*ARF_EXPREF(arb_midref(&x))) && !COEFF_IS_MPZ(*MAG_EXPREF(arb_radref(&x)));
+}
+
+// Encode an offset in the file as an fmpz in the same way that FLINT encodes
+// pointers to an mpz.
+fmpz encode_offset(std::uint64_t offset) noexcept { return static_cast<fmpz>(PTR_TO_COEFF(offset)); }
+
+std::uint64_t decode_offset(fmpz value) noexcept { return static_cast<std::uint64_t>(static_cast<ulong>(value) << 2); }
+
+// The bytes that an exponent that does not fit into an fmpz occupies in the
+// file after the arb_struct.
+std::uint64_t exponent_bytes(const fmpz_t exponent) noexcept {
+  return sizeof(std::int64_t) + std::abs(COEFF_TO_PTR(*exponent)->_mp_size) * sizeof(mp_limb_t);
+}
+
+void write_exponent(std::ostream& out, const fmpz_t exponent) {
+  const __mpz_struct* z = COEFF_TO_PTR(*exponent);
+  const std::int64_t size = z->_mp_size;
+  out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  out.write(reinterpret_cast<const char*>(z->_mp_d), std::abs(size) * sizeof(mp_limb_t));
+}
+
+void write(const std::filesystem::path& path, arb_srcptr values, ::arbxx::size length) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::system_error(errno, std::generic_category(), "cannot open " + path.string());
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteorder = BYTEORDER;
+  header.limb_bits = FLINT_BITS;
+  header.record_size = sizeof(arb_struct);
+  header.length = length;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  // Write the arb_struct and replace pointers with offsets of the data that
+  // we write after the last arb_struct.
+  std::uint64_t offset = sizeof(Header) + length * sizeof(arb_struct);
+  for (::arbxx::size i = 0; i < length; i++) {
+    arb_struct record = values[i];
+
+    if (!is_inline(record)) {
+      if (ARF_HAS_PTR(arb_midref(&record))) {
+        ARF_PTR_D(arb_midref(&record)) = reinterpret_cast<mp_ptr>(offset);
+        offset += ARF_SIZE(arb_midref(&record)) * sizeof(mp_limb_t);
+      }
+      for (fmpz* exponent : {ARF_EXPREF(arb_midref(&record)), MAG_EXPREF(arb_radref(&record))}) {
+        if (COEFF_IS_MPZ(*exponent)) {
+          const std::uint64_t bytes = exponent_bytes(exponent);
+          *exponent = encode_offset(offset);
+          offset += bytes;
+        }
+      }
+    }
+
+    out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+
+  // Write the data in the same order as the offsets above.
+  for (::arbxx::size i = 0; i < length; i++) {
+    const arb_struct& value = values[i];
+
+    if (is_inline(value))
+      continue;
+
+    if (ARF_HAS_PTR(arb_midref(&value)))
+      out.write(reinterpret_cast<const char*>(ARF_PTR_D(arb_midref(&value))), ARF_SIZE(arb_midref(&value)) * sizeof(mp_limb_t));
+    for (const fmpz* exponent : {ARF_EXPREF(arb_midref(&value)), MAG_EXPREF(arb_radref(&value))}) {
+      if (COEFF_IS_MPZ(*exponent))
+        write_exponent(out, exponent);
+    }
+  }
+
+  out.flush();
+  if (!out)
+    throw std::system_error(errno, std::generic_category(), "failed to write " + path.string());
+}
+
+}  // namespace
+
+// A shallow copy of an arb_struct whose mantissa and exponents point into
+// the mapped memory.
+struct LIBARBXX_LOCAL Shallow {
+  arb_struct value;
+  __mpz_struct exponents[2];
+};
+
+struct LIBARBXX_LOCAL MappedArbArray::Implementation {
+  explicit Implementation(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), "cannot open " + path.string());
+
+    struct stat st;
+    if (::fstat(fd, &st)) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "cannot stat " + path.string());
+    }
+
+    bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes < sizeof(Header)) {
+      ::close(fd);
+      throw std::logic_error("malformed file, " + path.string() + " is too short to contain an array of Arb elements");
+    }
+
+    void* mapped = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+      throw std::system_error(error, std::generic_category(), "cannot map " + path.string());
+
+    mapping = static_cast<const char*>(mapped);
+
+    try {
+      Header header;
+      std::memcpy(&header, mapping, sizeof(header));
+
+      if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)))
+        throw std::logic_error("malformed file, " + path.string() + " does not contain an array of Arb elements");
+      if (header.version != VERSION)
+        throw std::logic_error("malformed file, unsupported version " + std::to_string(header.version) + " of array of Arb elements");
+      if (header.byteorder != BYTEORDER || header.limb_bits != FLINT_BITS || header.record_size != sizeof(arb_struct))
+        throw std::logic_error("cannot map " + path.string() + " which has been written on an incompatible platform");
+      if (header.length > (bytes - sizeof(Header)) / sizeof(arb_struct))
+        throw std::logic_error("malformed file, " + path.string() + " is truncated");
+
+      length = static_cast<::arbxx::size>(header.length);
+      records = reinterpret_cast<const arb_struct*>(mapping + sizeof(Header));
+      shallow = std::make_unique<std::atomic<const Shallow*>[]>(header.length);
+    } catch (...) {
+      ::munmap(const_cast<char*>(mapping), bytes);
+      throw;
+    }
+  }
+
+  ~Implementation() noexcept {
+    for (::arbxx::size i = 0; i < length; i++)
+      delete shallow[i].load(std::memory_order_relaxed);
+    ::munmap(const_cast<char*>(mapping), bytes);
+  }
+
+  // Return a pointer to `size` bytes at `offset` in the mapped memory.
+  const char* at(std::uint64_t offset, std::uint64_t size) const {
+    if (offset > bytes || size > bytes - offset)
+      throw std::logic_error("malformed file, offset of Arb data is out of bounds");
+    return mapping + offset;
+  }
+
+  // Return the shallow copy of the `i`-th element, create it if necessary.
+  // If several threads create the same copy concurrently, all but one
+  // discard theirs.
+  const arb_struct& resolve(::arbxx::size i) const {
+    const Shallow* resolved = shallow[i].load(std::memory_order_acquire);
+    if (resolved != nullptr)
+      return resolved->value;
+
+    auto copy = std::make_unique<Shallow>();
+    copy->value = records[i];
+
+    arf_ptr mid = arb_midref(&copy->value);
+    if (ARF_HAS_PTR(mid)) {
+      const auto offset = reinterpret_cast<std::uint64_t>(ARF_PTR_D(mid));
+      ARF_PTR_D(mid) = reinterpret_cast<mp_ptr>(const_cast<char*>(at(offset, ARF_SIZE(mid) * sizeof(mp_limb_t))));
+    }
+
+    fmpz* exponents[] = {ARF_EXPREF(mid), MAG_EXPREF(arb_radref(&copy->value))};
+    for (int e = 0; e < 2; e++) {
+      if (!COEFF_IS_MPZ(*exponents[e]))
+        continue;
+
+      const std::uint64_t offset = decode_offset(*exponents[e]);
+
+      std::int64_t size;
+      std::memcpy(&size, at(offset, sizeof(size)), sizeof(size));
+
+      __mpz_struct& z = copy->exponents[e];
+      z._mp_size = static_cast<int>(size);
+      z._mp_alloc = std::abs(z._mp_size);
+      z._mp_d = reinterpret_cast<mp_ptr>(const_cast<char*>(at(offset + sizeof(size), z._mp_alloc * sizeof(mp_limb_t))));
+
+      *exponents[e] = static_cast<fmpz>(PTR_TO_COEFF(&z));
+    }
+
+    if (shallow[i].compare_exchange_strong(resolved, copy.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+      return copy.release()->value;
+    return resolved->value;
+  }
+
+  const char* mapping;
+  std::size_t bytes;
+
+  ::arbxx::size length;
+  const arb_struct* records;
+
+  // The shallow copies of elements that are not inline, indexed like the
+  // records; null where no copy has been created yet. Readers do not take
+  // any locks. The copies do not own any memory so they must not be
+  // cleared.
+  std::unique_ptr<std::atomic<const Shallow*>[]> shallow;
+};
+
+MappedArbArray::MappedArbArray(const std::filesystem::path& path) : impl(std::make_unique<Implementation>(path)) {}
+
+MappedArbArray::MappedArbArray(MappedArbArray&&) noexcept = default;
+
+MappedArbArray::~MappedArbArray() noexcept = default;
+
+MappedArbArray& MappedArbArray::operator=(MappedArbArray&&) noexcept = default;
+
+void MappedArbArray::write(const std::filesystem::path& path, const std::vector<Arb>& values) {
+  // An Arb has the same layout as an arb_struct, see arb_vector.cc.
+  ::arbxx::write(path, reinterpret_cast<arb_srcptr>(values.data()), static_cast<::arbxx::size>(values.size()));
+}
+
+void MappedArbArray::write(const std::filesystem::path& path, const ArbVector& values) {
+  ::arbxx::write(path, values.arb_ptr(), values.size());
+}
+
+::arbxx::size MappedArbArray::size() const noexcept { return impl ? impl->length : 0; }
+
+bool MappedArbArray::empty() const noexcept { return size() == 0; }
+
+const Arb& MappedArbArray::operator[](::arbxx::size i) const {
+  const arb_struct& record = impl->records[i];
+  if (is_inline(record))
+    return reinterpret_cast<const Arb&>(record);
+  return reinterpret_cast<const Arb&>(impl->resolve(i));
+}
+
+}  // namespace arbxx
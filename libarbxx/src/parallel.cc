@@ -0,0 +1,93 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/parallel.hpp"
+
+#include <arb.h>
+
+#include <algorithm>
+
+#include "../arbxx/arb_vector.hpp"
+#include "util/assert.ipp"
+#include "util/thread_pool.ipp"
+
+namespace arbxx::parallel {
+
+namespace {
+
+// The number of elements that are reduced by a single call to arb_dot().
+// The chunks must not depend on the number of threads so that the result
+// does not either.
+constexpr ::arbxx::size CHUNK = 4096;
+
+Arb reduce(arb_srcptr x, arb_srcptr y, slong ystep, ::arbxx::size length, prec precision) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length must not be negative");
+
+  Arb ret;
+  if (length == 0)
+    return ret;
+
+  const ::arbxx::size chunks = (length + CHUNK - 1) / CHUNK;
+  arb_ptr partials = _arb_vec_init(chunks);
+
+  run_on_threads(chunks, [&](::arbxx::size chunk) {
+    const ::arbxx::size begin = chunk * CHUNK;
+    arb_dot(partials + chunk, nullptr, 0, x + begin, 1, y + begin * ystep, ystep, std::min(CHUNK, length - begin), precision);
+  });
+
+  // Combine the partial sums pairwise in an order that only depends on the
+  // number of chunks.
+  for (::arbxx::size width = 1; width < chunks; width *= 2)
+    for (::arbxx::size i = 0; i + width < chunks; i += 2 * width)
+      arb_add(partials + i, partials + i, partials + i + width, precision);
+
+  arb_swap(ret.arb_t(), partials);
+  _arb_vec_clear(partials, chunks);
+
+  return ret;
+}
+
+}  // namespace
+
+// The elements of the ranges are Arb which have the same layout as an
+// arb_struct, see the static_assert in arb_vector.cc.
+
+Arb sum(const Arb* x, ::arbxx::size length, prec precision) {
+  // A sum is a dot product with a vector of ones.
+  static const Arb one{1};
+  return reduce(reinterpret_cast<arb_srcptr>(x), one.arb_t(), 0, length, precision);
+}
+
+Arb sum(const std::vector<Arb>& x, prec precision) { return sum(x.data(), static_cast<::arbxx::size>(x.size()), precision); }
+
+Arb sum(const ArbVector& x, prec precision) { return sum(x.begin(), x.size(), precision); }
+
+Arb dot(const Arb* x, const Arb* y, ::arbxx::size length, prec precision) { return reduce(reinterpret_cast<arb_srcptr>(x), reinterpret_cast<arb_srcptr>(y), 1, length, precision); }
+
+Arb dot(const std::vector<Arb>& x, const std::vector<Arb>& y, prec precision) {
+  LIBARBXX_CHECK_ARGUMENT(x.size() == y.size(), "vectors must have the same length");
+  return dot(x.data(), y.data(), static_cast<::arbxx::size>(x.size()), precision);
+}
+
+Arb dot(const ArbVector& x, const ArbVector& y, prec precision) {
+  LIBARBXX_CHECK_ARGUMENT(x.size() == y.size(), "vectors must have the same length");
+  return dot(x.begin(), y.begin(), x.size(), precision);
+}
+
+}  // namespace arbxx::parallel
@@ -0,0 +1,370 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/parse.hpp"
+
+#include <arb.h>
+#include <fcntl.h>
+#include <flint/fmpz.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "../arbxx/arb.hpp"
+#include "util/assert.ipp"
+#include "util/thread_pool.ipp"
+
+namespace arbxx {
+
+namespace {
+
+// The number of bytes of input that are split into fields by a single task
+// of ingest().
+constexpr std::size_t CHUNK = std::size_t(1) << 18;
+
+// The number of decimal digits that always fit into a ulong.
+constexpr int LIMB_DIGITS = std::numeric_limits<ulong>::digits10;
+
+// Decimal exponents with more digits are left to arb_set_str().
+constexpr slong MAX_DECIMAL_EXPONENT = 99999999;
+
+constexpr ulong power(ulong base, int exponent) { return exponent == 0 ? 1 : base * power(base, exponent - 1); }
+
+// The largest k such that 5^k fits into a ulong, i.e., multiplication by
+// 10^k = 5^k·2^k only needs a single rounding.
+constexpr int MAX_EXACT_POWER = [] {
+  int k = 0;
+  while (power(5, k) <= std::numeric_limits<ulong>::max() / 5)
+    k++;
+  return k;
+}();
+
+bool is_separator(char c) { return c == '\n' || c == ','; }
+
+bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+std::string_view trim(std::string_view value) {
+  while (!value.empty() && is_space(value.front()))
+    value.remove_prefix(1);
+  while (!value.empty() && is_space(value.back()))
+    value.remove_suffix(1);
+  return value;
+}
+
+// Set x to the value of a plain decimal number [+-]ddd[.ddd][e[+-]ddd] and
+// return true; return false without modifying x if value is not of this
+// form.
+bool parse_decimal(arb_t x, std::string_view value, prec precision) {
+  const char* p = value.data();
+  const char* const end = p + value.size();
+
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-'))
+    negative = *p++ == '-';
+
+  const char* const integer = p;
+  while (p != end && is_digit(*p))
+    p++;
+  const char* const integer_end = p;
+
+  const char* fraction = p;
+  if (p != end && *p == '.') {
+    fraction = ++p;
+    while (p != end && is_digit(*p))
+      p++;
+  }
+  const char* const fraction_end = p;
+
+  if (integer == integer_end && fraction == fraction_end)
+    return false;
+
+  slong exponent = 0;
+  if (p != end && (*p == 'e' || *p == 'E')) {
+    p++;
+
+    bool negative_exponent = false;
+    if (p != end && (*p == '+' || *p == '-'))
+      negative_exponent = *p++ == '-';
+
+    const char* const digits = p;
+    while (p != end && is_digit(*p)) {
+      if (exponent > MAX_DECIMAL_EXPONENT / 10)
+        return false;
+      exponent = 10 * exponent + (*p++ - '0');
+    }
+
+    if (p == digits)
+      return false;
+
+    if (negative_exponent)
+      exponent = -exponent;
+  }
+
+  if (p != end)
+    return false;
+
+  exponent -= fraction_end - fraction;
+
+  // Accumulate the digits of the mantissa in a limb and only move them to an
+  // fmpz when the limb is full.
+  ulong limb = 0;
+  int digits = 0;
+  bool large = false;
+  fmpz_t mantissa;
+  fmpz_init(mantissa);
+
+  const auto push = [&](char c) {
+    if (c == '0' && !large && limb == 0)
+      return;
+    if (digits == LIMB_DIGITS) {
+      fmpz_mul_ui(mantissa, mantissa, power(10, digits));
+      fmpz_add_ui(mantissa, mantissa, limb);
+      large = true;
+      limb = 0;
+      digits = 0;
+    }
+    limb = 10 * limb + (c - '0');
+    digits++;
+  };
+
+  std::for_each(integer, integer_end, push);
+  std::for_each(fraction, fraction_end, push);
+
+  if (large) {
+    fmpz_mul_ui(mantissa, mantissa, power(10, digits));
+    fmpz_add_ui(mantissa, mantissa, limb);
+    arb_set_fmpz(x, mantissa);
+  } else {
+    arb_set_ui(x, limb);
+  }
+
+  fmpz_clear(mantissa);
+
+  if (negative)
+    arb_neg(x, x);
+
+  // Scale the exact mantissa by 10^exponent. For small exponents this
+  // rounds only once.
+  if (exponent == 0) {
+    arb_set_round(x, x, precision);
+  } else if (exponent > 0 && exponent <= MAX_EXACT_POWER) {
+    arb_mul_ui(x, x, power(5, static_cast<int>(exponent)), precision);
+    arb_mul_2exp_si(x, x, exponent);
+  } else if (exponent < 0 && -exponent <= MAX_EXACT_POWER) {
+    arb_div_ui(x, x, power(5, static_cast<int>(-exponent)), precision);
+    arb_mul_2exp_si(x, x, exponent);
+  } else {
+    arb_t scale;
+    arb_init(scale);
+    arb_ui_pow_ui(scale, 10, static_cast<ulong>(exponent > 0 ? exponent : -exponent), precision + 8);
+    if (exponent > 0)
+      arb_mul(x, x, scale, precision);
+    else
+      arb_div(x, x, scale, precision);
+    arb_clear(scale);
+  }
+
+  return true;
+}
+
+// Splits a buffer into fields and parses them in parallel.
+class Ingestion {
+ public:
+  explicit Ingestion(std::string_view buffer) : buffer(strip(buffer)) {
+    chunks = static_cast<::arbxx::size>((this->buffer.size() + CHUNK - 1) / CHUNK);
+
+    // Count the separators in each chunk so that every chunk knows the index
+    // of the fields that start in it.
+    separators.resize(chunks + 1);
+    run_on_threads(chunks, [&](::arbxx::size chunk) {
+      const auto [begin, end] = range(chunk);
+      separators[chunk + 1] = std::count_if(this->buffer.begin() + begin, this->buffer.begin() + end, is_separator);
+    });
+    std::partial_sum(separators.begin(), separators.end(), separators.begin());
+  }
+
+  ::arbxx::size count() const { return this->buffer.empty() ? 0 : separators.back() + 1; }
+
+  IngestResult parse(Arb* out, prec precision) const {
+    std::vector<std::vector<ParseError>> errors(chunks);
+
+    run_on_threads(chunks, [&](::arbxx::size chunk) {
+      const auto [begin, end] = range(chunk);
+
+      // Skip the field that started in the previous chunk.
+      std::size_t start = begin;
+      ::arbxx::size index = separators[chunk];
+      if (begin != 0 && !is_separator(buffer[begin - 1])) {
+        const auto separator = std::find_if(buffer.begin() + begin, buffer.begin() + end, is_separator);
+        if (separator == buffer.begin() + end)
+          return;
+        start = static_cast<std::size_t>(separator - buffer.begin()) + 1;
+        index++;
+      }
+
+      // Parse the fields that start in this chunk. An empty field at the very
+      // end of the buffer belongs to the last chunk.
+      while (start < end || (start == end && end == buffer.size())) {
+        const auto stop = static_cast<std::size_t>(std::find_if(buffer.begin() + start, buffer.end(), is_separator) - buffer.begin());
+
+        if (!::arbxx::parse(out[index], buffer.substr(start, stop - start), precision))
+          errors[chunk].push_back({index, start});
+
+        index++;
+
+        if (stop == buffer.size())
+          break;
+
+        start = stop + 1;
+      }
+    });
+
+    IngestResult result;
+    result.count = count();
+    for (const auto& e : errors)
+      result.errors.insert(result.errors.end(), e.begin(), e.end());
+    return result;
+  }
+
+ private:
+  // Drop trailing whitespace and a single trailing separator so that the
+  // final newline of a file does not produce another field.
+  static std::string_view strip(std::string_view buffer) {
+    while (!buffer.empty() && is_space(buffer.back()))
+      buffer.remove_suffix(1);
+    if (!buffer.empty() && is_separator(buffer.back()))
+      buffer.remove_suffix(1);
+    return buffer;
+  }
+
+  std::pair<std::size_t, std::size_t> range(::arbxx::size chunk) const {
+    const std::size_t begin = static_cast<std::size_t>(chunk) * CHUNK;
+    return {begin, std::min(buffer.size(), begin + CHUNK)};
+  }
+
+  std::string_view buffer;
+  ::arbxx::size chunks;
+
+  // The number of separators before each chunk.
+  std::vector<::arbxx::size> separators;
+};
+
+// A read-only mapping of a file into memory.
+class Mapping {
+ public:
+  explicit Mapping(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), "cannot open " + path.string());
+
+    struct stat st;
+    if (::fstat(fd, &st)) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "cannot stat " + path.string());
+    }
+
+    bytes = static_cast<std::size_t>(st.st_size);
+    if (bytes == 0) {
+      ::close(fd);
+      return;
+    }
+
+    void* mapped = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (mapped == MAP_FAILED)
+      throw std::system_error(error, std::generic_category(), "cannot map " + path.string());
+
+    // All of the file is going to be read, so start reading it right away.
+    ::madvise(mapped, bytes, MADV_WILLNEED);
+
+    mapping = static_cast<const char*>(mapped);
+  }
+
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  ~Mapping() {
+    if (mapping != nullptr)
+      ::munmap(const_cast<char*>(mapping), bytes);
+  }
+
+  std::string_view view() const { return {mapping, bytes}; }
+
+ private:
+  const char* mapping = nullptr;
+  std::size_t bytes = 0;
+};
+
+}  // namespace
+
+bool parse(Arb& x, std::string_view value, prec precision) {
+  value = trim(value);
+
+  if (parse_decimal(x.arb_t(), value, precision))
+    return true;
+
+  // Everything else is left to Arb which needs a NUL terminated string.
+  thread_local std::string buffer;
+  buffer.assign(value);
+
+  if (value.empty() || value.find('\0') != std::string_view::npos || arb_set_str(x.arb_t(), buffer.c_str(), precision)) {
+    arb_indeterminate(x.arb_t());
+    return false;
+  }
+
+  return true;
+}
+
+Arb parse(std::string_view value, prec precision) {
+  Arb ret;
+  if (!parse(ret, value, precision))
+    throw std::invalid_argument("cannot parse \"" + std::string(value) + "\" as an element of Arb");
+  return ret;
+}
+
+IngestResult ingest(Arb* out, ::arbxx::size capacity, std::string_view buffer, prec precision) {
+  const Ingestion ingestion(buffer);
+  LIBARBXX_CHECK_ARGUMENT(ingestion.count() <= capacity, "buffer contains " << ingestion.count() << " fields but there is only room for " << capacity << " elements");
+  return ingestion.parse(out, precision);
+}
+
+IngestResult ingest(std::vector<Arb>& out, std::string_view buffer, prec precision) {
+  const Ingestion ingestion(buffer);
+  out.resize(static_cast<std::size_t>(ingestion.count()));
+  return ingestion.parse(out.data(), precision);
+}
+
+IngestResult ingest_file(std::vector<Arb>& out, const std::filesystem::path& path, prec precision) {
+  const Mapping mapping(path);
+  return ingest(out, mapping.view(), precision);
+}
+
+}  // namespace arbxx
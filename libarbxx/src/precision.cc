@@ -0,0 +1,47 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/precision.hpp"
+
+namespace arbxx {
+
+namespace {
+
+// The state of the innermost PrecisionScope of this thread. Since this is
+// thread local, reading and writing it never synchronizes with other threads.
+thread_local prec current_precision = ARB_PRECISION_FAST;
+thread_local Arf::Round current_round = Arf::Round::NEAR;
+
+}  // namespace
+
+PrecisionScope::PrecisionScope(prec precision, Arf::Round round) noexcept : previous_precision(current_precision), previous_round(current_round) {
+  current_precision = precision;
+  current_round = round;
+}
+
+PrecisionScope::~PrecisionScope() noexcept {
+  current_precision = previous_precision;
+  current_round = previous_round;
+}
+
+prec PrecisionScope::precision() noexcept { return current_precision; }
+
+Arf::Round PrecisionScope::round() noexcept { return current_round; }
+
+}  // namespace arbxx
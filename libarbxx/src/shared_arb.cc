@@ -0,0 +1,59 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/shared_arb.hpp"
+
+#include <atomic>
+#include <ostream>
+#include <utility>
+
+namespace arbxx {
+
+namespace {
+
+// All default constructed elements share the same exact zero.
+const std::shared_ptr<Arb>& zero() {
+  static const auto zero = std::make_shared<Arb>();
+  return zero;
+}
+
+}  // namespace
+
+SharedArb::SharedArb() : value(zero()) {}
+
+SharedArb::SharedArb(const Arb& x) : value(std::make_shared<Arb>(x)) {}
+
+SharedArb::SharedArb(Arb&& x) : value(std::make_shared<Arb>(std::move(x))) {}
+
+Arb& SharedArb::mutate() {
+  if (value.use_count() > 1) {
+    value = std::make_shared<Arb>(*value);
+  } else {
+    // The last other owner might just have released the storage in another
+    // thread. The release decremented the reference count with release
+    // semantics; this fence makes that thread's final reads of the storage
+    // happen before our writes.
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *value;
+}
+
+std::ostream& operator<<(std::ostream& os, const SharedArb& self) { return os << *self; }
+
+}  // namespace arbxx
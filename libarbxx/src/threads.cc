@@ -0,0 +1,69 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/threads.hpp"
+
+#include <flint/flint.h>
+#include <flint/thread_pool.h>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+namespace {
+
+std::once_flag pool_created;
+
+// Create FLINT's global thread pool with one worker per additional core
+// unless it has been created already. The pool is never resized afterwards
+// since flint_set_num_threads() aborts if another thread is using the pool.
+void create_pool() {
+  std::call_once(pool_created, []() {
+    if (global_thread_pool_initialized)
+      return;
+    // flint_set_num_threads() also changes the count of this thread.
+    const int threads = flint_get_num_threads();
+    flint_set_num_threads(std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+    flint_reset_num_workers(threads - 1);
+  });
+}
+
+}  // namespace
+
+ThreadScope::ThreadScope(int threads) : previous_threads(flint_get_num_threads()) {
+  LIBARBXX_CHECK_ARGUMENT(threads >= 1, "number of threads must be positive");
+  create_pool();
+  // FLINT keeps the number of workers a thread may request from the pool in
+  // a thread local variable. Unlike flint_set_num_threads(), this does not
+  // touch the pool that is shared by all threads.
+  flint_reset_num_workers(threads - 1);
+}
+
+ThreadScope::~ThreadScope() noexcept {
+  flint_reset_num_workers(previous_threads - 1);
+}
+
+int ThreadScope::threads() noexcept { return flint_get_num_threads(); }
+
+}  // namespace arbxx
@@ -0,0 +1,295 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include "../arbxx/to_chars.hpp"
+
+#include <arb.h>
+#include <arf.h>
+#include <flint/fmpz.h>
+#include <mag.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "../arbxx/arb.hpp"
+#include "../arbxx/arf.hpp"
+#include "util/assert.ipp"
+
+namespace arbxx {
+
+namespace {
+
+// A lower bound for log10(2).
+constexpr double LOG10_2 = 0.30102999566398119;
+
+// Binary exponents beyond this are formatted with arb_get_str() since the
+// powers of ten we would need are huge.
+constexpr slong MAX_EXPONENT = slong(1) << 20;
+
+// Return whether the exponent of an arf_t or mag_t is too big for our
+// algorithm.
+bool huge(const fmpz_t exponent) { return COEFF_IS_MPZ(*exponent) || std::abs(*exponent) > MAX_EXPONENT; }
+
+// Return floor(log10(2^(e - 1))), possibly off by one.
+slong decimal_exponent(slong e) { return static_cast<slong>(std::floor(static_cast<double>(e - 1) * LOG10_2)); }
+
+// Return a formatter for format whose buffers are reused between calls on the
+// same thread.
+DecimalFormatter& formatter(DecimalFormat format) {
+  thread_local std::unique_ptr<DecimalFormatter> formatter;
+  thread_local DecimalFormat current;
+
+  if (!formatter || current.digits != format.digits || current.radius_digits != format.radius_digits) {
+    formatter = std::make_unique<DecimalFormatter>(format);
+    current = format;
+  }
+
+  return *formatter;
+}
+
+std::to_chars_result copy(char* first, char* last, std::string_view s) {
+  if (last - first < static_cast<std::ptrdiff_t>(s.size()))
+    return {last, std::errc::value_too_large};
+  std::memcpy(first, s.data(), s.size());
+  return {first + s.size(), std::errc()};
+}
+
+}  // namespace
+
+DecimalFormatter::DecimalFormatter(DecimalFormat format) : options(format) {
+  LIBARBXX_CHECK_ARGUMENT(format.digits >= 1, "number of digits must be positive");
+  LIBARBXX_CHECK_ARGUMENT(format.radius_digits >= 0, "number of digits of the radius must not be negative");
+
+  arb_init(scaled);
+  arb_init(power);
+  arf_init(bound);
+  mag_init(error);
+  fmpz_init(integer);
+  fmpz_init(lower);
+  fmpz_init(upper);
+}
+
+DecimalFormatter::~DecimalFormatter() noexcept {
+  arb_clear(scaled);
+  arb_clear(power);
+  arf_clear(bound);
+  mag_clear(error);
+  fmpz_clear(integer);
+  fmpz_clear(lower);
+  fmpz_clear(upper);
+}
+
+std::to_chars_result DecimalFormatter::to_chars(char* first, char* last, const Arb& x) { return copy(first, last, format(x)); }
+
+std::to_chars_result DecimalFormatter::to_chars(char* first, char* last, const Arf& x) { return copy(first, last, format(x)); }
+
+std::string_view DecimalFormatter::format(const Arb& x) {
+  buffer.clear();
+  write(x.arb_t(), options.radius_digits != 0);
+  return buffer;
+}
+
+std::string_view DecimalFormatter::format(const Arf& x) {
+  // A shallow ball of radius zero around x which must not be cleared.
+  arb_struct ball;
+  *arb_midref(&ball) = *x.arf_t();
+  mag_init(arb_radref(&ball));
+
+  buffer.clear();
+  write(&ball, false);
+  return buffer;
+}
+
+void DecimalFormatter::append(std::string& out, const Arb* x, ::arbxx::size length, char separator) {
+  LIBARBXX_CHECK_ARGUMENT(length >= 0, "length must not be negative");
+
+  for (::arbxx::size i = 0; i < length; i++) {
+    buffer.clear();
+    write(x[i].arb_t(), options.radius_digits != 0);
+    out += buffer;
+    out += separator;
+  }
+}
+
+void DecimalFormatter::write(arb_srcptr x, bool radius) {
+  const arf_struct* mid = arb_midref(x);
+  const mag_struct* rad = arb_radref(x);
+
+  if (arf_is_nan(mid)) {
+    buffer += "nan";
+    return;
+  }
+
+  if (mag_is_inf(rad)) {
+    buffer += "[+/- inf]";
+    return;
+  }
+
+  if (arf_is_inf(mid)) {
+    buffer += arf_sgn(mid) > 0 ? "+inf" : "-inf";
+    return;
+  }
+
+  if ((!arf_is_zero(mid) && huge(ARF_EXPREF(mid))) || (!mag_is_zero(rad) && huge(MAG_EXPREF(rad)))) {
+    char* s = arb_get_str(x, options.digits, radius ? ARB_STR_MORE : ARB_STR_NO_RADIUS);
+    buffer += s;
+    flint_free(s);
+    return;
+  }
+
+  if (arf_is_zero(mid)) {
+    if (!radius || mag_is_zero(rad)) {
+      buffer += "0";
+    } else {
+      buffer += "[+/- ";
+      write_upper(rad, 0, options.radius_digits);
+      buffer += "]";
+    }
+    return;
+  }
+
+  const slong e = round(x, options.digits);
+
+  if (!radius || mag_is_zero(error)) {
+    write_decimal(e, options.digits);
+    return;
+  }
+
+  buffer += "[";
+  write_decimal(e, options.digits);
+  buffer += " +/- ";
+  write_upper(error, e - options.digits + 1, options.radius_digits);
+  buffer += "]";
+}
+
+slong DecimalFormatter::round(arb_srcptr x, int digits) {
+  const arf_struct* mid = arb_midref(x);
+  const slong exponent = ARF_EXP(mid);
+
+  fmpz_ui_pow_ui(lower, 10, digits - 1);
+  fmpz_ui_pow_ui(upper, 10, digits);
+
+  // The working precision is large enough so that the scaling by a power of
+  // ten is exact if the result is an integer, so that exact decimals are
+  // written without a radius.
+  const prec wp = 4 * digits + 64 + std::abs(exponent) + arf_bits(mid);
+
+  slong e = decimal_exponent(exponent);
+  while (true) {
+    const slong k = digits - 1 - e;
+    arb_ui_pow_ui(power, 10, static_cast<ulong>(std::abs(k)), wp);
+    if (k >= 0)
+      arb_mul(scaled, x, power, wp);
+    else
+      arb_div(scaled, x, power, wp);
+
+    arf_get_fmpz(integer, arb_midref(scaled), ARF_RND_NEAR);
+
+    if (fmpz_cmpabs(integer, upper) >= 0)
+      e++;
+    else if (fmpz_cmpabs(integer, lower) < 0)
+      e--;
+    else
+      break;
+  }
+
+  arf_set_fmpz(bound, integer);
+  arf_sub(bound, arb_midref(scaled), bound, ARF_PREC_EXACT, ARF_RND_DOWN);
+  arf_get_mag(error, bound);
+  mag_add(error, error, arb_radref(scaled));
+
+  return e;
+}
+
+void DecimalFormatter::write_upper(const mag_t r, slong unit, int digits) {
+  fmpz_ui_pow_ui(lower, 10, digits - 1);
+  fmpz_ui_pow_ui(upper, 10, digits);
+
+  arf_set_mag(bound, r);
+
+  slong e = decimal_exponent(MAG_EXP(r));
+  while (true) {
+    const slong k = digits - 1 - e;
+    arb_ui_pow_ui(power, 10, static_cast<ulong>(std::abs(k)), 64);
+    arb_set_arf(scaled, bound);
+    if (k >= 0)
+      arb_mul(scaled, scaled, power, 64);
+    else
+      arb_div(scaled, scaled, power, 64);
+
+    arb_get_ubound_arf(bound, scaled, 64);
+    arf_get_fmpz(integer, bound, ARF_RND_CEIL);
+    arf_set_mag(bound, r);
+
+    if (fmpz_cmp(integer, upper) >= 0)
+      e++;
+    else if (fmpz_cmp(integer, lower) < 0)
+      e--;
+    else
+      break;
+  }
+
+  write_decimal(e + unit, digits);
+}
+
+void DecimalFormatter::write_decimal(slong e, int digits) {
+  scratch.resize(fmpz_sizeinbase(integer, 10) + 2);
+  fmpz_get_str(scratch.data(), 10, integer);
+
+  const char* s = scratch.data();
+  if (*s == '-') {
+    buffer += '-';
+    s++;
+  }
+
+  if (e >= -4 && e < digits) {
+    // Fixed notation such as 1337.00 or 0.0123
+    if (e >= 0) {
+      buffer.append(s, static_cast<size_t>(e + 1));
+      if (e + 1 < digits) {
+        buffer += '.';
+        buffer.append(s + e + 1, static_cast<size_t>(digits - e - 1));
+      }
+    } else {
+      buffer += "0.";
+      buffer.append(static_cast<size_t>(-e - 1), '0');
+      buffer.append(s, static_cast<size_t>(digits));
+    }
+  } else {
+    // Scientific notation such as 1.23e+100 or 1.23e-100
+    buffer += s[0];
+    if (digits > 1) {
+      buffer += '.';
+      buffer.append(s + 1, static_cast<size_t>(digits - 1));
+    }
+    buffer += e > 0 ? "e+" : "e";
+
+    char exponent[24];
+    const auto [end, ec] = std::to_chars(exponent, exponent + sizeof(exponent), e);
+    buffer.append(exponent, end);
+  }
+}
+
+std::to_chars_result to_chars(char* first, char* last, const Arb& x, DecimalFormat format) { return formatter(format).to_chars(first, last, x); }
+
+std::to_chars_result to_chars(char* first, char* last, const Arf& x, DecimalFormat format) { return formatter(format).to_chars(first, last, x); }
+
+}  // namespace arbxx
@@ -0,0 +1,120 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBARBXX_UTIL_CONSTANT_IPP
+#define LIBARBXX_UTIL_CONSTANT_IPP
+
+#include <arb.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "../../arbxx/forward.hpp"
+
+namespace arbxx {
+namespace {
+
+// A process wide cache of a mathematical constant such as pi.
+//
+// The cache holds the constant at the highest precision that has been
+// requested so far. Requests for lower precision round this value down
+// which is much cheaper than computing it again. Reading from the cache
+// does not take any locks; when a thread needs more precision than is
+// cached, it computes the constant at (at least) twice the cached precision
+// and publishes it. So a sequence of rising requests only recomputes the
+// constant a logarithmic number of times.
+//
+// Entries that have been replaced are kept until the cache is destroyed, so
+// a reader never needs to announce that it holds an entry and a read is a
+// single atomic load. Since the precision of the entries roughly doubles,
+// there are only logarithmically many of them and together they take about
+// as much memory as the latest entry.
+class ConstantCache {
+ public:
+  explicit ConstantCache(void (*compute)(arb_t, slong)) : compute(compute) {}
+
+  ConstantCache(const ConstantCache&) = delete;
+  ConstantCache& operator=(const ConstantCache&) = delete;
+
+  ~ConstantCache() {
+    delete latest.load();
+    for (const Entry* entry : retired)
+      delete entry;
+  }
+
+  // Set ret to the constant at precision prec.
+  void get(arb_t ret, prec prec) {
+    const Entry* cached = latest.load(std::memory_order_acquire);
+    if (cached != nullptr && cached->precision >= prec) {
+      arb_set_round(ret, cached->value, prec);
+      return;
+    }
+    const ::arbxx::prec cached_precision = cached == nullptr ? 0 : cached->precision;
+
+    // Compute the constant with headroom so that slowly increasing requests
+    // do not recompute the constant every time.
+    const ::arbxx::prec precision = std::max((prec + 63) / 64 * 64, 2 * cached_precision);
+    Entry* entry = new Entry(precision);
+    compute(entry->value, precision);
+    arb_set_round(ret, entry->value, prec);
+
+    publish(entry);
+  }
+
+ private:
+  struct Entry {
+    explicit Entry(::arbxx::prec precision) : precision(precision) { arb_init(value); }
+    ~Entry() { arb_clear(value); }
+
+    const ::arbxx::prec precision;
+    arb_t value;
+  };
+
+  // Make entry the latest value unless another thread published a better
+  // value in the meantime.
+  void publish(Entry* entry) {
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    const Entry* current = latest.load(std::memory_order_relaxed);
+    if (current != nullptr && current->precision >= entry->precision) {
+      delete entry;
+      return;
+    }
+
+    if (current != nullptr)
+      retired.push_back(current);
+    latest.store(entry, std::memory_order_release);
+  }
+
+  void (*compute)(arb_t, slong);
+  std::atomic<const Entry*> latest{nullptr};
+
+  // Serializes publishers; readers never take this lock.
+  std::mutex mutex;
+  // Replaced entries that might still be read by some thread. Guarded by
+  // the mutex.
+  std::vector<const Entry*> retired;
+};
+
+}  // namespace
+}  // namespace arbxx
+
+#endif
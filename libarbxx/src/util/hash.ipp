@@ -0,0 +1,69 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBARBXX_UTIL_HASH_IPP
+#define LIBARBXX_UTIL_HASH_IPP
+
+#include <arf.h>
+#include <flint/fmpz.h>
+#include <mag.h>
+
+#include <boost/functional/hash.hpp>
+#include <cstddef>
+#include <cstdlib>
+
+namespace arbxx {
+namespace {
+
+// Hash the value of an fmpz_t without converting it, i.e., by hashing the
+// limbs of an mpz_t directly.
+void hash_combine(size_t& seed, const fmpz_t value) {
+  if (!COEFF_IS_MPZ(*value)) {
+    boost::hash_combine(seed, *value);
+    return;
+  }
+
+  const __mpz_struct* z = COEFF_TO_PTR(*value);
+  boost::hash_combine(seed, z->_mp_size);
+  boost::hash_range(seed, z->_mp_d, z->_mp_d + std::abs(z->_mp_size));
+}
+
+// Hash an arf_t. Since Arb normalizes the mantissa of an arf_t, two arf_t
+// that compare equal have the same exponent and the same limbs.
+void hash_combine(size_t& seed, const arf_t value) {
+  hash_combine(seed, ARF_EXPREF(value));
+  boost::hash_combine(seed, ARF_XSIZE(value));
+
+  mp_srcptr limbs;
+  mp_size_t size;
+  ARF_GET_MPN_READONLY(limbs, size, value);
+  boost::hash_range(seed, limbs, limbs + size);
+}
+
+// Hash a mag_t. Its mantissa is normalized, so mag_t that are identical have
+// the same exponent and the same mantissa.
+void hash_combine(size_t& seed, const mag_t value) {
+  hash_combine(seed, MAG_EXPREF(value));
+  boost::hash_combine(seed, MAG_MAN(value));
+}
+
+}  // namespace
+}  // namespace arbxx
+
+#endif
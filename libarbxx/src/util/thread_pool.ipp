@@ -0,0 +1,76 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#ifndef LIBARBXX_UTIL_THREAD_POOL_IPP
+#define LIBARBXX_UTIL_THREAD_POOL_IPP
+
+#include <flint/thread_pool.h>
+#include <flint/thread_support.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "../../arbxx/forward.hpp"
+#include "../../arbxx/threads.hpp"
+
+namespace arbxx {
+namespace {
+
+// Call task(i) for all 0 <= i < tasks on the threads of FLINT's thread pool
+// that are available to the current thread, see ThreadScope. The tasks are
+// handed out in no particular order.
+template <typename Task>
+void run_on_threads(::arbxx::size tasks, const Task& task) {
+  struct Work {
+    const Task& task;
+    ::arbxx::size tasks;
+    std::atomic<::arbxx::size> next{0};
+
+    static void work(void* arg) {
+      auto& self = *static_cast<Work*>(arg);
+      while (true) {
+        const ::arbxx::size i = self.next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= self.tasks)
+          return;
+        self.task(i);
+      }
+    }
+  } work{task, tasks};
+
+  if (tasks <= 0)
+    return;
+
+  thread_pool_handle* handles;
+  const slong workers = flint_request_threads(&handles, std::min<slong>(ThreadScope::threads(), tasks));
+
+  for (slong i = 0; i < workers; i++)
+    thread_pool_wake(global_thread_pool, handles[i], 0, Work::work, &work);
+
+  Work::work(&work);
+
+  for (slong i = 0; i < workers; i++)
+    thread_pool_wait(global_thread_pool, handles[i]);
+
+  flint_give_back_threads(handles, workers);
+}
+
+}  // namespace
+}  // namespace arbxx
+
+#endif
@@ -0,0 +1,268 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <boost/lexical_cast.hpp>
+#include <complex>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include "../arbxx/acb.hpp"
+#include "../arbxx/precision.hpp"
+#include "../arbxx/yap/acb.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+using boost::lexical_cast;
+using std::string;
+
+namespace arbxx::test {
+
+namespace {
+
+Acb random(ArbTester& arbs, prec prec = 53) {
+  return Acb(arbs.random(prec), arbs.random(prec));
+}
+
+}  // namespace
+
+TEST_CASE("Create/Destroy Acb", "[acb]") {
+  delete new Acb();
+}
+
+TEST_CASE("Initialization of Acb", "[acb]") {
+  REQUIRE(Acb(1u).equal(Acb(1)));
+  REQUIRE(Acb(1l).equal(Acb(1)));
+  REQUIRE(Acb(1ul).equal(Acb(1)));
+  REQUIRE(Acb(1ll).equal(Acb(1)));
+  REQUIRE(Acb(1ull).equal(Acb(1)));
+  REQUIRE(Acb(mpz_class(1)).equal(Acb(1)));
+  REQUIRE(Acb(Arb(1)).equal(Acb(1)));
+  REQUIRE(Acb(Arb(1), Arb()).equal(Acb(1)));
+  REQUIRE(Acb(Arf(1)).equal(Acb(1)));
+  REQUIRE(Acb(Arf(1), Arf(-2)).equal(Acb(Arb(1), Arb(-2))));
+  REQUIRE(Acb(Arf(mpz_class(1), -1)).is_exact());
+
+  REQUIRE((Acb(Arb(1), Arb(1)) = 1u).equal(Acb(1)));
+  REQUIRE((Acb() = 1ll).equal(Acb(1)));
+  REQUIRE((Acb() = mpz_class(1)).equal(Acb(1)));
+  REQUIRE((Acb() = Arb(1)).equal(Acb(1)));
+
+  const Acb third(mpq_class(1, 3), 256);
+  REQUIRE(third.real().equal(Arb(mpq_class(1, 3), 256)));
+  REQUIRE(third.imag().equal(Arb()));
+
+  const Acb parsed("[3.25 +/- 0.0001]", "-1", 64);
+  REQUIRE(parsed.real().equal(Arb("[3.25 +/- 0.0001]", 64)));
+  REQUIRE(parsed.imag().equal(Arb(-1)));
+}
+
+TEST_CASE("Real and Imaginary Part of Acb", "[acb]") {
+  Acb x(Arb(1), Arb(2));
+
+  SECTION("Parts are Views into the Element") {
+    REQUIRE(x.real().arb_t() == acb_realref(x.acb_t()));
+    REQUIRE(x.imag().arb_t() == acb_imagref(x.acb_t()));
+  }
+
+  SECTION("Parts can be Modified in Place") {
+    x.real() = 3;
+    x.imag() += 1;
+    REQUIRE(x.equal(Acb(Arb(3), Arb(3))));
+  }
+
+  SECTION("Moving Keeps the Parts") {
+    const Acb y = std::move(x);
+    REQUIRE(y.equal(Acb(Arb(1), Arb(2))));
+    REQUIRE(x.is_finite());
+  }
+}
+
+TEST_CASE("Relational Operators with Acb", "[acb]") {
+  const Acb x(Arb(1), Arb(2));
+
+  REQUIRE(*(x == x));
+  REQUIRE(!*(x != x));
+  REQUIRE(!*(x == Acb(1)));
+  REQUIRE(*(x != 1));
+  REQUIRE(*(Acb(1) == 1));
+  REQUIRE(*(1 == Acb(1)));
+  REQUIRE(*(Acb(1) == Arb(1)));
+  const mpz_class large = mpz_class(1) << 128;
+  REQUIRE(*(Acb(large) == large));
+
+  const Acb third(mpq_class(1, 3), 256);
+  REQUIRE(!(third == third).has_value());
+  REQUIRE(*(third != mpq_class(4, 3)));
+  REQUIRE(!(third == mpq_class(1, 3)).has_value());
+
+  // The real parts agree but the imaginary parts do not.
+  Acb y = third;
+  y.imag() = 1;
+  REQUIRE(*(y != mpq_class(1, 3)));
+}
+
+TEST_CASE("Predicates of Acb", "[acb]") {
+  REQUIRE(Acb(1).is_exact());
+  REQUIRE(!Acb(mpq_class(1, 3)).is_exact());
+  REQUIRE(Acb::one().is_real());
+  REQUIRE(!Acb::i().is_real());
+  REQUIRE(Acb::i().is_finite());
+  REQUIRE(!Acb::indeterminate().is_finite());
+}
+
+TEST_CASE("Print Acb", "[acb]") {
+  REQUIRE(lexical_cast<string>(Acb()) == "0");
+  REQUIRE(lexical_cast<string>(Acb(1)) == "1.00000");
+  REQUIRE(lexical_cast<string>(Acb::i()) == "1.00000*I");
+  REQUIRE(lexical_cast<string>(Acb(Arb(1), Arb(2))) == "1.00000 + 2.00000*I");
+  REQUIRE(lexical_cast<string>(Acb(Arb(1), Arb(-2))) == "1.00000 - 2.00000*I");
+}
+
+TEST_CASE("Cast to std::complex", "[acb]") {
+  REQUIRE(static_cast<std::complex<double>>(Acb(Arb(1), Arb(-2))) == std::complex<double>(1, -2));
+}
+
+TEST_CASE("In-place Arithmetic with Acb", "[acb]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+  PrecisionScope scope{prec};
+
+  for (int i = 0; i < 128; i++) {
+    const Acb x = random(arbs), y = random(arbs);
+    const Arb r = arbs.random();
+
+    Acb expected, actual;
+
+    acb_mul(expected.acb_t(), x.acb_t(), y.acb_t(), prec);
+    actual = x;
+    actual *= y;
+    REQUIRE(actual.equal(expected));
+
+    acb_div_arb(expected.acb_t(), x.acb_t(), r.arb_t(), prec);
+    actual = x;
+    actual /= r;
+    REQUIRE(actual.equal(expected));
+
+    acb_sub_si(expected.acb_t(), x.acb_t(), -3, prec);
+    actual = x;
+    actual -= -3;
+    REQUIRE(actual.equal(expected));
+
+    acb_add_ui(expected.acb_t(), x.acb_t(), 3, prec);
+    actual = x;
+    actual += 3ull;
+    REQUIRE(actual.equal(expected));
+  }
+}
+
+TEST_CASE("Binary Operators on Acb", "[acb][yap]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+
+  for (int i = 0; i < 128; i++) {
+    const Acb x = random(arbs), y = random(arbs), z = random(arbs);
+    const Arb r = arbs.random();
+
+    Acb expected;
+
+    acb_add(expected.acb_t(), x.acb_t(), y.acb_t(), prec);
+    REQUIRE((x + y)(prec).equal(expected));
+
+    acb_sub(expected.acb_t(), x.acb_t(), y.acb_t(), prec);
+    REQUIRE((x - y)(prec).equal(expected));
+
+    acb_mul(expected.acb_t(), x.acb_t(), y.acb_t(), prec);
+    REQUIRE((x * y)(prec).equal(expected));
+
+    acb_div(expected.acb_t(), x.acb_t(), y.acb_t(), prec);
+    REQUIRE((x / y)(prec).equal(expected));
+
+    acb_mul_arb(expected.acb_t(), x.acb_t(), r.arb_t(), prec);
+    REQUIRE((x * r)(prec).equal(expected));
+    REQUIRE((r * x)(prec).equal(expected));
+
+    acb_sub_si(expected.acb_t(), x.acb_t(), 3, prec);
+    acb_neg(expected.acb_t(), expected.acb_t());
+    REQUIRE((3 - x)(prec).equal(expected));
+
+    expected = x;
+    acb_addmul(expected.acb_t(), y.acb_t(), z.acb_t(), prec);
+    REQUIRE((x + y * z)(prec).equal(expected));
+    REQUIRE((y * z + x)(prec).equal(expected));
+
+    Acb lhs, rhs;
+    acb_add(lhs.acb_t(), x.acb_t(), y.acb_t(), prec);
+    acb_sub_arb(rhs.acb_t(), z.acb_t(), r.arb_t(), prec);
+    acb_mul(expected.acb_t(), lhs.acb_t(), rhs.acb_t(), prec);
+    REQUIRE(((x + y) * (z - r))(prec).equal(expected));
+  }
+}
+
+TEST_CASE("In-place Arithmetic of Acb with Expressions", "[acb][yap]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+  PrecisionScope scope{prec};
+
+  for (int i = 0; i < 128; i++) {
+    const Acb y = random(arbs), z = random(arbs);
+    Acb x = random(arbs);
+
+    Acb expected = x;
+    acb_addmul(expected.acb_t(), x.acb_t(), y.acb_t(), prec);
+    x += x * y;
+    REQUIRE(x.equal(expected));
+
+    Acb sum;
+    acb_add(sum.acb_t(), y.acb_t(), z.acb_t(), prec);
+    acb_div(expected.acb_t(), x.acb_t(), sum.acb_t(), prec);
+    x /= y + z;
+    REQUIRE(x.equal(expected));
+  }
+}
+
+TEST_CASE("Rounding of Acb", "[acb][yap]") {
+  const Acb x(mpq_class(1, 3), 256);
+
+  Acb expected;
+  acb_set_round(expected.acb_t(), x.acb_t(), 16);
+  REQUIRE(x(16).equal(expected));
+  REQUIRE(x(256).equal(x));
+}
+
+TEST_CASE("Hashing of Acb", "[acb][hash]") {
+  const std::hash<Acb> hash;
+
+  ArbTester arbs;
+  for (int i = 0; i < 128; i++) {
+    const Acb x = random(arbs, 256);
+    const Acb y = x;
+    REQUIRE(hash(x) == hash(y));
+  }
+
+  // Swapping the real and the imaginary part changes the hash.
+  REQUIRE(hash(Acb(Arb(1), Arb(2))) != hash(Acb(Arb(2), Arb(1))));
+
+  std::unordered_set<size_t> hashes;
+  for (int i = 0; i < 1024; i++)
+    hashes.insert(hash(Acb(Arb(1), Arb(i))));
+  REQUIRE(hashes.size() == 1024);
+}
+
+}  // namespace arbxx::test
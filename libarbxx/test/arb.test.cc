@@ -19,8 +19,19 @@
  *********************************************************************/
 
 #include <boost/lexical_cast.hpp>
+#include <functional>
+#include <limits>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
 
 #include "../arbxx/arb.hpp"
+#include "../arbxx/precision.hpp"
+#include "../arbxx/yap/arb.hpp"
+#include "arb.hpp"
+#include "util/constant.ipp"
 #include "external/catch2/single_include/catch2/catch.hpp"
 
 using boost::lexical_cast;
@@ -95,6 +106,133 @@ TEMPLATE_TEST_CASE("Relation Operators with Integers", "[arb]", unsigned short,
   REQUIRE(((x <= y) && !*(x >= y)));
 }
 
+namespace {
+
+// Return balls whose bounds are integers or lie between integers close to
+// (a multiple of) `center`, so that comparisons with integers are often
+// decided by an exact tie.
+std::vector<Arb> ballsAround(const mpz_class& center, ArbTester& arbs) {
+  std::vector<Arb> balls;
+  for (int lower = -2; lower <= 2; lower++) {
+    for (int upper = lower; upper <= 2; upper++) {
+      balls.emplace_back(std::pair{Arf(mpz_class(center + lower)), Arf(mpz_class(center + upper))});
+      balls.emplace_back(std::pair{Arf(mpz_class(2 * (center + lower) - 1), -1), Arf(mpz_class(2 * (center + upper) + 1), -1)});
+    }
+  }
+  for (int i = 0; i < 16; i++) {
+    balls.push_back((Arb(center) + arbs.random(64, 4))(64));
+  }
+  return balls;
+}
+
+}  // namespace
+
+TEMPLATE_TEST_CASE("Relation Operators with Integers agree with Arb", "[arb]", unsigned short, short, unsigned int, int, unsigned long, long, unsigned long long, long long, mpz_class) {
+  ArbTester arbs;
+
+  std::vector<mpz_class> centers{0, 1, 7};
+  if constexpr (std::is_same_v<TestType, mpz_class>) {
+    centers.push_back(mpz_class(1) << 64);
+    centers.push_back(mpz_class(1) << 200);
+    centers.push_back(-(mpz_class(3) << 200) + 1);
+  } else if constexpr (std::is_signed_v<TestType>) {
+    centers.push_back(-1);
+    centers.push_back(mpz_class(std::to_string(std::numeric_limits<TestType>::min() + 2)));
+  }
+  if constexpr (!std::is_same_v<TestType, mpz_class>)
+    centers.push_back(mpz_class(std::to_string(std::numeric_limits<TestType>::max() - 2)));
+
+  for (const auto& center : centers) {
+    for (const auto& x : ballsAround(center, arbs)) {
+      for (int delta = -2; delta <= 2; delta++) {
+        const mpz_class value = center + delta;
+
+        TestType y;
+        if constexpr (std::is_same_v<TestType, mpz_class>)
+          y = value;
+        else if (value.fits_slong_p())
+          y = static_cast<TestType>(value.get_si());
+        else
+          y = static_cast<TestType>(value.get_ui());
+
+        if constexpr (!std::is_same_v<TestType, mpz_class>)
+          if (std::to_string(y) != value.get_str())
+            continue;
+
+        const Arb Y(value);
+
+        REQUIRE((x == y) == (x == Y));
+        REQUIRE((x != y) == (x != Y));
+        REQUIRE((x < y) == (x < Y));
+        REQUIRE((x > y) == (x > Y));
+        REQUIRE((x <= y) == (x <= Y));
+        REQUIRE((x >= y) == (x >= Y));
+        REQUIRE((y == x) == (Y == x));
+        REQUIRE((y != x) == (Y != x));
+        REQUIRE((y < x) == (Y < x));
+        REQUIRE((y > x) == (Y > x));
+        REQUIRE((y <= x) == (Y <= x));
+        REQUIRE((y >= x) == (Y >= x));
+      }
+    }
+  }
+}
+
+TEST_CASE("Relation Operators with Rationals", "[arb]") {
+  ArbTester arbs;
+
+  SECTION("Dyadic Rationals are Compared Exactly") {
+    const mpq_class y(3, 4);
+    const Arb Y(y);
+    REQUIRE(Y.is_exact());
+
+    for (const auto& x : {Y, Arb(std::pair{Arf(1, -1), Arf(3, -2)}), Arb(std::pair{Arf(3, -2), Arf(1)}), Arb(mpq_class(1, 3), 256)}) {
+      REQUIRE((x == y) == (x == Y));
+      REQUIRE((x != y) == (x != Y));
+      REQUIRE((x < y) == (x < Y));
+      REQUIRE((x > y) == (x > Y));
+      REQUIRE((x <= y) == (x <= Y));
+      REQUIRE((x >= y) == (x >= Y));
+    }
+  }
+
+  SECTION("Comparisons are Decided whenever Possible") {
+    const mpq_class y(1, 3);
+
+    // An approximation of 1/3 at 1024 bits is not distinguishable from 1/3
+    // unless we compare it exactly with the rational.
+    Arb x(y, 1024);
+    REQUIRE(!(x < y).has_value());
+    REQUIRE(!(x == y).has_value());
+
+    Arf midpoint = static_cast<Arf>(x);
+    REQUIRE(*(Arb(midpoint) != y));
+    REQUIRE(*(Arb(midpoint) < y) != *(Arb(midpoint) > y));
+
+    for (int i = 0; i < 1024; i++) {
+      const Arb z = arbs.random(i % 2 ? 64 : 256, 2);
+      const Arb Y(y, 4096);
+
+      // At 4096 bits, Y is much smaller than z so whenever the relation to Y
+      // is decided, it must be the same for y.
+      if ((z < Y).has_value()) REQUIRE((z < y) == (z < Y));
+      if ((z > Y).has_value()) REQUIRE((z > Y) == (z > y));
+      if ((z <= Y).has_value()) REQUIRE((z <= y) == (z <= Y));
+      if ((z >= Y).has_value()) REQUIRE((z >= Y) == (z >= y));
+      if ((z != Y).has_value()) REQUIRE((z != y) == (z != Y));
+    }
+  }
+
+  SECTION("Special Values") {
+    const mpq_class y(1, 3);
+    REQUIRE(!(Arb::indeterminate() < y).has_value());
+    REQUIRE(!(Arb::zero_pm_inf() < y).has_value());
+    REQUIRE(*(Arb::pos_inf() > y));
+    REQUIRE(*(Arb::neg_inf() < y));
+    REQUIRE(*(Arb::neg_inf() < 0));
+  }
+}
+
 TEST_CASE("Unary Minus of Arb", "[arb]") {
   Arb x(1);
 
@@ -135,6 +273,74 @@ TEST_CASE("One", "[arb][one]") {
   REQUIRE(x == 1);
 }
 
+TEST_CASE("Constants", "[arb][constants]") {
+  using Constant = std::pair<Arb (*)(prec), void (*)(arb_t, slong)>;
+  const auto constant = GENERATE(Constant{Arb::pi, arb_const_pi}, Constant{Arb::log2, arb_const_log2}, Constant{Arb::e, arb_const_e}, Constant{Arb::euler, arb_const_euler});
+
+  // Request the constants in an order that makes the cache round down some
+  // of the time.
+  const prec prec = GENERATE(64, 1024, 2, 256, 4096, 53);
+
+  const Arb x = constant.first(prec);
+
+  Arb expected;
+  constant.second(expected.arb_t(), prec);
+
+  REQUIRE(arb_overlaps(x.arb_t(), expected.arb_t()));
+  REQUIRE(arb_rel_accuracy_bits(x.arb_t()) >= arb_rel_accuracy_bits(expected.arb_t()) - 2);
+}
+
+TEST_CASE("Constants from Several Threads", "[arb][constants]") {
+  Arb expected;
+  arb_const_pi(expected.arb_t(), 4096);
+
+  std::vector<std::thread> threads;
+  std::vector<int> contained(4);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      contained[t] = true;
+      for (prec prec = 2 + t; prec < 4096; prec += 61) {
+        const Arb pi = Arb::pi(prec);
+        contained[t] = contained[t] && arb_contains(pi.arb_t(), expected.arb_t()) && arb_rel_accuracy_bits(pi.arb_t()) >= prec - 2;
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int t = 0; t < 4; t++)
+    REQUIRE(contained[t]);
+}
+
+TEST_CASE("Constants are Computed Rarely", "[arb][constants]") {
+  static int computations;
+  computations = 0;
+
+  ConstantCache cache([](arb_t ret, slong prec) {
+    computations++;
+    arb_const_pi(ret, prec);
+  });
+
+  Arb expected;
+  arb_const_pi(expected.arb_t(), 65536);
+
+  // Requests of slowly rising precision, about a thousand of them, should
+  // only need a logarithmic number of computations.
+  int requests = 0;
+  for (prec prec = 2; prec < 65536; prec += 61) {
+    Arb pi;
+    cache.get(pi.arb_t(), prec);
+    requests++;
+
+    REQUIRE(arb_overlaps(pi.arb_t(), expected.arb_t()));
+    REQUIRE(arb_rel_accuracy_bits(pi.arb_t()) >= prec - 2);
+  }
+
+  REQUIRE(requests > 1000);
+  REQUIRE(computations <= 12);
+}
+
 TEST_CASE("Infinite Values", "[arb][inf]") {
   Arb x = Arb::pos_inf();
   Arb y = Arb::neg_inf();
@@ -150,4 +356,262 @@ TEST_CASE("Indeterminate Value", "[arb][indeterminate]") {
   REQUIRE(!(x <= 0));
 }
 
+TEST_CASE("Binary Operators on Arb", "[arb][yap]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+
+  for (int i = 0; i < 128; i++) {
+    Arb x = arbs.random(), y = arbs.random();
+
+    Arb expected;
+
+    arb_add(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE((x + y)(prec).equal(expected));
+
+    arb_sub(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE((x - y)(prec).equal(expected));
+
+    arb_mul(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE((x * y)(prec).equal(expected));
+
+    arb_div(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE((x / y)(prec).equal(expected));
+
+    arb_add_si(expected.arb_t(), x.arb_t(), 0, prec);
+    arb_neg(expected.arb_t(), expected.arb_t());
+    REQUIRE((-(x + 0))(prec).equal(expected));
+  }
+}
+
+TEST_CASE("Fused Multiply Add with Arb", "[arb][yap]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+
+  for (int i = 0; i < 128; i++) {
+    Arb x = arbs.random(), y = arbs.random(), z = arbs.random();
+
+    Arb expected = x;
+
+    arb_addmul(expected.arb_t(), y.arb_t(), z.arb_t(), prec);
+    REQUIRE((x + y * z)(prec).equal(expected));
+    REQUIRE((y * z + x)(prec).equal(expected));
+
+    expected = x;
+    arb_submul(expected.arb_t(), y.arb_t(), z.arb_t(), prec);
+    REQUIRE((x - y * z)(prec).equal(expected));
+    REQUIRE((-(y * z - x))(prec).equal(expected));
+  }
+}
+
+TEST_CASE("Nested Expressions with Arb", "[arb][yap]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+
+  for (int i = 0; i < 128; i++) {
+    Arb x = arbs.random(), y = arbs.random(), z = arbs.random();
+
+    Arb lhs, rhs, expected;
+    arb_add(lhs.arb_t(), x.arb_t(), y.arb_t(), prec);
+    arb_sub(rhs.arb_t(), y.arb_t(), z.arb_t(), prec);
+    arb_mul(expected.arb_t(), lhs.arb_t(), rhs.arb_t(), prec);
+    REQUIRE(((x + y) * (y - z))(prec).equal(expected));
+
+    arb_div(expected.arb_t(), z.arb_t(), lhs.arb_t(), prec);
+    REQUIRE((z / (x + y))(prec).equal(expected));
+
+    auto sum = x + y;
+    auto expression = sum * sum;
+    arb_mul(expected.arb_t(), lhs.arb_t(), lhs.arb_t(), prec);
+    REQUIRE(expression(prec).equal(expected));
+  }
+}
+
+TEST_CASE("Arithmetic of Arb with Integers", "[arb][yap]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+
+  for (int i = 0; i < 128; i++) {
+    Arb x = arbs.random(), y = arbs.random();
+
+    Arb expected;
+
+    arb_add_si(expected.arb_t(), x.arb_t(), -3, prec);
+    REQUIRE((x + -3)(prec).equal(expected));
+    REQUIRE((-3 + x)(prec).equal(expected));
+
+    arb_sub_ui(expected.arb_t(), x.arb_t(), 3, prec);
+    REQUIRE((x - 3u)(prec).equal(expected));
+    arb_neg(expected.arb_t(), expected.arb_t());
+    REQUIRE((3u - x)(prec).equal(expected));
+
+    arb_mul_si(expected.arb_t(), x.arb_t(), 3, prec);
+    REQUIRE((x * 3)(prec).equal(expected));
+    REQUIRE((3 * x)(prec).equal(expected));
+
+    arb_div_si(expected.arb_t(), x.arb_t(), -3, prec);
+    REQUIRE((x / -3l)(prec).equal(expected));
+
+    arb_ui_div(expected.arb_t(), 3, x.arb_t(), prec);
+    REQUIRE((3 / x)(prec).equal(expected));
+    arb_neg(expected.arb_t(), expected.arb_t());
+    REQUIRE((-3 / x)(prec).equal(expected));
+
+    const mpz_class large = mpz_class(1) << 256;
+    fmpz_t large_;
+    fmpz_init(large_);
+    fmpz_set_mpz(large_, large.get_mpz_t());
+
+    arb_add_fmpz(expected.arb_t(), x.arb_t(), large_, prec);
+    REQUIRE((x + large)(prec).equal(expected));
+
+    expected = x;
+    arb_addmul_fmpz(expected.arb_t(), y.arb_t(), large_, prec);
+    REQUIRE((x + y * large)(prec).equal(expected));
+
+    fmpz_clear(large_);
+  }
+}
+
+TEST_CASE("Rounding of Arb", "[arb][yap]") {
+  Arb x(mpq_class(1, 3), 256);
+
+  Arb expected;
+  arb_set_round(expected.arb_t(), x.arb_t(), 16);
+  REQUIRE(x(16).equal(expected));
+  REQUIRE(x(256).equal(x));
+}
+
+TEST_CASE("Elementary Functions of Arb", "[arb][yap][functions]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+  const Arb x = arbs.random(prec);
+  const Arb y = arbs.random(prec);
+
+  Arb expected;
+
+  const auto unary = [&](const Arb& actual, void (*f)(arb_t, const arb_t, slong)) {
+    f(expected.arb_t(), x.arb_t(), prec);
+    return actual.equal(expected);
+  };
+
+  REQUIRE(unary(exp(x)(prec), arb_exp));
+  REQUIRE(unary(expm1(x)(prec), arb_expm1));
+  REQUIRE(unary(log(x)(prec), arb_log));
+  REQUIRE(unary(log1p(x)(prec), arb_log1p));
+  REQUIRE(unary(sqrt(x)(prec), arb_sqrt));
+  REQUIRE(unary(sin(x)(prec), arb_sin));
+  REQUIRE(unary(cos(x)(prec), arb_cos));
+  REQUIRE(unary(tan(x)(prec), arb_tan));
+  REQUIRE(unary(atan(x)(prec), arb_atan));
+  REQUIRE(unary(sinh(x)(prec), arb_sinh));
+  REQUIRE(unary(cosh(x)(prec), arb_cosh));
+  REQUIRE(unary(tanh(x)(prec), arb_tanh));
+  REQUIRE(unary(gamma(x)(prec), arb_gamma));
+
+  SECTION("Functions of Expressions") {
+    arb_add(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    arb_exp(expected.arb_t(), expected.arb_t(), prec);
+    arb_mul_si(expected.arb_t(), expected.arb_t(), 2, prec);
+    REQUIRE((2 * exp(x + y))(prec).equal(expected));
+
+    const auto sum = x + y;
+    arb_add(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    arb_sin(expected.arb_t(), expected.arb_t(), prec);
+    REQUIRE(sin(sum)(prec).equal(expected));
+
+    arb_cos(expected.arb_t(), x.arb_t(), prec);
+    arb_cos(expected.arb_t(), expected.arb_t(), prec);
+    REQUIRE(cos(cos(x))(prec).equal(expected));
+  }
+
+  SECTION("Exponential Minus One") {
+    arb_expm1(expected.arb_t(), x.arb_t(), prec);
+    REQUIRE((exp(x) - 1)(prec).equal(expected));
+    REQUIRE((exp(x) - 1u)(prec).equal(expected));
+    REQUIRE((exp(x) - Arb(1))(prec).equal(expected));
+
+    arb_exp(expected.arb_t(), x.arb_t(), prec);
+    arb_sub_si(expected.arb_t(), expected.arb_t(), 2, prec);
+    REQUIRE((exp(x) - 2)(prec).equal(expected));
+
+    arb_add(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    arb_expm1(expected.arb_t(), expected.arb_t(), prec);
+    REQUIRE((exp(x + y) - 1)(prec).equal(expected));
+  }
+
+  SECTION("Functions of Two Arguments") {
+    arb_atan2(expected.arb_t(), y.arb_t(), x.arb_t(), prec);
+    REQUIRE(atan2(y, x)(prec).equal(expected));
+
+    arb_atan2(expected.arb_t(), y.arb_t(), Arb(1).arb_t(), prec);
+    REQUIRE(atan2(y, 1)(prec).equal(expected));
+
+    arb_pow(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(pow(x, y)(prec).equal(expected));
+
+    arb_pow_ui(expected.arb_t(), x.arb_t(), 3, prec);
+    REQUIRE(pow(x, 3)(prec).equal(expected));
+    REQUIRE(pow(x, mpz_class(3))(prec).equal(expected));
+
+    fmpz_t e;
+    fmpz_init(e);
+    fmpz_set_si(e, -3);
+    arb_pow_fmpz(expected.arb_t(), x.arb_t(), e, prec);
+    fmpz_clear(e);
+    REQUIRE(pow(x, -3)(prec).equal(expected));
+
+    arb_mul(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    arb_pow_ui(expected.arb_t(), expected.arb_t(), 2, prec);
+    REQUIRE(pow(x * y, 2)(prec).equal(expected));
+  }
+
+  SECTION("Fused Functions") {
+    Arb s, c;
+
+    arb_sin_cos(s.arb_t(), c.arb_t(), x.arb_t(), prec);
+    auto sin_cos_ = sin_cos(x, prec);
+    REQUIRE(sin_cos_.first.equal(s));
+    REQUIRE(sin_cos_.second.equal(c));
+
+    arb_sinh_cosh(s.arb_t(), c.arb_t(), x.arb_t(), prec);
+    PrecisionScope scope{prec};
+    auto sinh_cosh_ = sinh_cosh(x);
+    REQUIRE(sinh_cosh_.first.equal(s));
+    REQUIRE(sinh_cosh_.second.equal(c));
+  }
+}
+
+TEST_CASE("Hashing of Arb", "[arb][hash]") {
+  const std::hash<Arb> hash;
+
+  SECTION("Equal Elements have Equal Hashes") {
+    ArbTester arbs;
+    for (int i = 0; i < 128; i++) {
+      const Arb x = arbs.random(256, 16);
+      const Arb y = x;
+      REQUIRE(hash(x) == hash(y));
+    }
+
+    REQUIRE(hash(Arb(mpq_class(1, 3), 256)) == hash(Arb(mpq_class(1, 3), 256)));
+    REQUIRE(hash(Arb(1)) == hash(Arb(mpz_class(1))));
+  }
+
+  SECTION("Elements that Differ only in the Radius") {
+    const Arb x(mpq_class(1, 3), 256);
+    Arb y = x;
+    mag_mul_2exp_si(arb_radref(y.arb_t()), arb_radref(y.arb_t()), 1);
+    REQUIRE(!x.equal(y));
+    REQUIRE(hash(x) != hash(y));
+    REQUIRE(std::hash<Arf>()(static_cast<Arf>(x)) == std::hash<Arf>()(static_cast<Arf>(y)));
+  }
+
+  SECTION("Elements that Agree in the First 53 Bits") {
+    std::unordered_set<size_t> hashes;
+    for (int i = 0; i < 1024; i++)
+      hashes.insert(hash(Arb(std::pair{Arf((mpz_class(1) << 200) + i, -200), Arf((mpz_class(1) << 200) + i, -200)})));
+
+    REQUIRE(hashes.size() == 1024);
+  }
+}
+
 }  // namespace arbxx::test
@@ -0,0 +1,226 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../arbxx/arb_batch.hpp"
+#include "../arbxx/arb_vector.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+namespace {
+
+// Return random elements; the length is chosen so that the vectorized
+// kernels also have to process a tail of elements.
+std::vector<Arb> random(ArbTester& arbs, prec prec) {
+  std::vector<Arb> ret;
+  for (int i = 0; i < 1027; i++)
+    ret.push_back(i % 7 ? arbs.random(prec, 6) : Arb(i - 512));
+  return ret;
+}
+
+// Return the exact lower and upper bound of x.
+std::pair<Arf, Arf> endpoints(const Arb& x) {
+  std::pair<Arf, Arf> ret;
+  arb_get_lbound_arf(ret.first.arf_t(), x.arb_t(), ARF_PREC_EXACT);
+  arb_get_ubound_arf(ret.second.arf_t(), x.arb_t(), ARF_PREC_EXACT);
+  return ret;
+}
+
+// Forces the kernels called `name` for the lifetime of this object.
+struct ForcedKernels {
+  explicit ForcedKernels(const std::string& name) : previous(ArbBatch::kernels()), supported(detail::use_arb_batch_kernels(name.c_str())) {}
+
+  ~ForcedKernels() { detail::use_arb_batch_kernels(previous.c_str()); }
+
+  std::string previous;
+  bool supported;
+};
+
+}  // namespace
+
+TEST_CASE("Create ArbBatch", "[arb_batch]") {
+  ArbTester arbs;
+
+  SECTION("Empty Batches") {
+    ArbBatch x;
+    REQUIRE(x.empty());
+    REQUIRE(x.add(x).empty());
+  }
+
+  SECTION("Batches of Zeros") {
+    ArbBatch x(3);
+    REQUIRE(x.size() == 3);
+    for (::arbxx::size i = 0; i < x.size(); i++)
+      REQUIRE(x[i].equal(Arb()));
+  }
+
+  SECTION("Batches from Elements") {
+    for (prec prec : {32, 53, 256}) {
+      const auto x = random(arbs, prec);
+      const ArbBatch batch{x};
+      REQUIRE(batch.size() == static_cast<::arbxx::size>(x.size()));
+      for (::arbxx::size i = 0; i < batch.size(); i++) {
+        REQUIRE(arb_contains(batch[i].arb_t(), x[i].arb_t()));
+        if (prec <= 53)
+          REQUIRE(arf_equal(arb_midref(batch[i].arb_t()), arb_midref(x[i].arb_t())));
+      }
+      REQUIRE(ArbBatch{ArbVector{x}}.size() == batch.size());
+    }
+  }
+
+  SECTION("Elements that do not fit into a Double") {
+    Arb indeterminate;
+    arb_indeterminate(indeterminate.arb_t());
+
+    const ArbBatch x{std::vector{Arb(mpz_class(mpz_class(1) << 2048)), indeterminate}};
+    REQUIRE(!arb_is_finite(x[0].arb_t()));
+    REQUIRE(!arb_is_finite(x[1].arb_t()));
+  }
+
+  SECTION("Selected Kernels") {
+    const char* kernels = ArbBatch::kernels();
+    REQUIRE((std::strcmp(kernels, "avx512") == 0 || std::strcmp(kernels, "avx2") == 0 || std::strcmp(kernels, "scalar") == 0));
+
+    {
+      const ForcedKernels forced{"scalar"};
+      REQUIRE(forced.supported);
+      REQUIRE(std::strcmp(ArbBatch::kernels(), "scalar") == 0);
+    }
+    REQUIRE(std::strcmp(ArbBatch::kernels(), kernels) == 0);
+
+    const ForcedKernels forced{"unknown"};
+    REQUIRE(!forced.supported);
+    REQUIRE(std::strcmp(ArbBatch::kernels(), kernels) == 0);
+  }
+}
+
+TEST_CASE("Arithmetic with ArbBatch", "[arb_batch]") {
+  // Run the checks for all the kernels that this CPU supports.
+  const ForcedKernels forced{GENERATE(as<std::string>{}, "avx512", "avx2", "scalar")};
+  if (!forced.supported)
+    return;
+  CAPTURE(ArbBatch::kernels());
+
+  ArbTester arbs;
+
+  const auto x = random(arbs, 53);
+  const auto y = random(arbs, 53);
+  const ArbBatch a{x}, b{y};
+
+  SECTION("Addition") {
+    ArbBatch sum = a;
+    sum.add(b);
+
+    for (::arbxx::size i = 0; i < sum.size(); i++) {
+      // The sum of balls is attained at the endpoints.
+      const auto [s, t] = endpoints(a[i]);
+      const auto [u, v] = endpoints(b[i]);
+      Arf lower, upper;
+      arf_add(lower.arf_t(), s.arf_t(), u.arf_t(), ARF_PREC_EXACT, ARF_RND_DOWN);
+      arf_add(upper.arf_t(), t.arf_t(), v.arf_t(), ARF_PREC_EXACT, ARF_RND_DOWN);
+      REQUIRE(arb_contains_arf(sum[i].arb_t(), lower.arf_t()));
+      REQUIRE(arb_contains_arf(sum[i].arb_t(), upper.arf_t()));
+
+      Arb expected;
+      arb_add(expected.arb_t(), x[i].arb_t(), y[i].arb_t(), 53);
+      REQUIRE(arb_overlaps(sum[i].arb_t(), expected.arb_t()));
+
+      if (a[i].is_exact() && b[i].is_exact() && expected.is_exact())
+        REQUIRE(sum[i].equal(expected));
+    }
+  }
+
+  SECTION("Multiplication") {
+    ArbBatch product = a;
+    product.mul(b);
+
+    for (::arbxx::size i = 0; i < product.size(); i++) {
+      // The extrema of the product of balls are attained at the corners.
+      const auto [s, t] = endpoints(a[i]);
+      const auto [u, v] = endpoints(b[i]);
+      for (const Arf* lhs : {&s, &t}) {
+        for (const Arf* rhs : {&u, &v}) {
+          Arf corner;
+          arf_mul(corner.arf_t(), lhs->arf_t(), rhs->arf_t(), ARF_PREC_EXACT, ARF_RND_DOWN);
+          REQUIRE(arb_contains_arf(product[i].arb_t(), corner.arf_t()));
+        }
+      }
+
+      Arb expected;
+      arb_mul(expected.arb_t(), x[i].arb_t(), y[i].arb_t(), 53);
+      REQUIRE(arb_overlaps(product[i].arb_t(), expected.arb_t()));
+
+      if (a[i].is_exact() && b[i].is_exact() && expected.is_exact())
+        REQUIRE(product[i].equal(expected));
+    }
+  }
+
+  SECTION("Overflow") {
+    const Arb huge{mpz_class(mpz_class(1) << 1000)};
+    ArbBatch z{std::vector{huge, huge, Arb(1)}};
+    z.mul(z);
+    REQUIRE(!arb_is_finite(z[0].arb_t()));
+    REQUIRE(z[2].equal(Arb(1)));
+  }
+
+  SECTION("Mismatched Lengths") {
+    ArbBatch z{3};
+    REQUIRE_THROWS_AS(z.add(a), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Relations of ArbBatch", "[arb_batch]") {
+  // Run the checks for all the kernels that this CPU supports.
+  const ForcedKernels forced{GENERATE(as<std::string>{}, "avx512", "avx2", "scalar")};
+  if (!forced.supported)
+    return;
+  CAPTURE(ArbBatch::kernels());
+
+  ArbTester arbs;
+
+  const auto x = random(arbs, 53);
+  const auto y = random(arbs, 53);
+
+  const auto lt = ArbBatch{x}.lt(ArbBatch{y});
+  REQUIRE(lt.size() == x.size());
+
+  size_t decided = 0;
+  for (size_t i = 0; i < x.size(); i++) {
+    // Since the batch encloses the original elements, a decided relation
+    // must hold for them as well.
+    if (lt[i]) {
+      decided++;
+      REQUIRE((x[i] < y[i]) == lt[i]);
+    }
+  }
+  REQUIRE(decided > x.size() / 2);
+
+  SECTION("Exact Elements") {
+    const auto z = ArbBatch{ArbVector{std::vector<long>{1, 2, 3, 4, 5}}}.lt(ArbBatch{ArbVector{std::vector<long>{5, 4, 3, 2, 1}}});
+    REQUIRE(z == std::vector<std::optional<bool>>{true, true, false, false, false});
+  }
+}
+
+}  // namespace arbxx::test
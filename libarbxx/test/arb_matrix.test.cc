@@ -0,0 +1,141 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <flint/flintxx/frandxx.h>
+
+#include <stdexcept>
+
+#include "../arbxx/arb_matrix.hpp"
+#include "../arbxx/threads.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Create and Copy ArbMatrix", "[arb_matrix]") {
+  ArbMatrix A(2, 3);
+  REQUIRE(A.nrows() == 2);
+  REQUIRE(A.ncols() == 3);
+
+  A(1, 2) = 7;
+  REQUIRE(A(1, 2).equal(Arb(7)));
+  REQUIRE(arb_equal(arb_mat_entry(A.arb_mat_t(), 1, 2), Arb(7).arb_t()));
+
+  ArbMatrix B = A;
+  REQUIRE(B.equal(A));
+
+  ArbMatrix C = std::move(B);
+  REQUIRE(C.equal(A));
+  REQUIRE(B.nrows() == 0);
+
+  C = ArbMatrix::one(4);
+  REQUIRE(C.nrows() == 4);
+  REQUIRE(!C.equal(A));
+
+  C = A;
+  REQUIRE(C.equal(A));
+
+  REQUIRE_THROWS_AS(ArbMatrix(-1, 1), std::invalid_argument);
+}
+
+TEST_CASE("Multiplication of ArbMatrix", "[arb_matrix]") {
+  flint::frandxx state;
+  const prec prec = GENERATE(64, 128, 1024);
+  const size n = GENERATE(1, 7, 64);
+  const int threads = GENERATE(1, 4);
+
+  ThreadScope scope(threads);
+
+  for (int i = 0; i < 4; i++) {
+    const auto A = ArbMatrix::randtest(state, n, n + 1, prec, 10);
+    const auto B = ArbMatrix::randtest(state, n + 1, n, prec, 10);
+
+    const auto classical = A.mul(B, prec, ArbMatrix::Algorithm::CLASSICAL);
+
+    ArbMatrix expected(n, n);
+    arb_mat_mul_classical(expected.arb_mat_t(), A.arb_mat_t(), B.arb_mat_t(), prec);
+    REQUIRE(classical.equal(expected));
+
+    for (auto algorithm : {ArbMatrix::Algorithm::AUTOMATIC, ArbMatrix::Algorithm::THREADED, ArbMatrix::Algorithm::BLOCK}) {
+      const auto product = A.mul(B, prec, algorithm);
+      REQUIRE(product.nrows() == n);
+      REQUIRE(product.ncols() == n);
+      REQUIRE(arb_mat_overlaps(product.arb_mat_t(), classical.arb_mat_t()));
+    }
+  }
+
+  REQUIRE_THROWS_AS(ArbMatrix(2, 3).mul(ArbMatrix(2, 3), prec), std::invalid_argument);
+}
+
+TEST_CASE("Linear Algebra with ArbMatrix", "[arb_matrix]") {
+  flint::frandxx state;
+  const prec prec = GENERATE(64, 256);
+  const size n = GENERATE(1, 5, 32);
+
+  ThreadScope scope(GENERATE(1, 4));
+
+  for (int i = 0; i < 4; i++) {
+    // A random perturbation of the identity is invertible.
+    auto A = ArbMatrix::randtest(state, n, n, prec, 1);
+    for (size j = 0; j < n; j++)
+      arb_add_si(A(j, j).arb_t(), A(j, j).arb_t(), 4 * n, prec);
+
+    const auto B = ArbMatrix::randtest(state, n, 2, prec, 10);
+
+    const auto X = A.solve(B, prec);
+    REQUIRE(X.has_value());
+    REQUIRE(arb_mat_contains(A.mul(*X, prec).arb_mat_t(), B.arb_mat_t()));
+
+    const auto inverse = A.inv(prec);
+    REQUIRE(inverse.has_value());
+    REQUIRE(arb_mat_contains(A.mul(*inverse, prec).arb_mat_t(), ArbMatrix::one(n).arb_mat_t()));
+
+    Arb expected;
+    arb_mat_det(expected.arb_t(), A.arb_mat_t(), prec);
+    REQUIRE(A.det(prec).equal(expected));
+  }
+
+  SECTION("Singular Matrices") {
+    ArbMatrix zero(3, 3);
+    REQUIRE(!zero.solve(ArbMatrix::one(3), prec));
+    REQUIRE(!zero.inv(prec));
+    REQUIRE(zero.det(prec).equal(Arb()));
+  }
+}
+
+TEST_CASE("Nesting of Thread Scopes", "[arb_matrix]") {
+  const int threads = ThreadScope::threads();
+
+  {
+    ThreadScope outer(4);
+    REQUIRE(ThreadScope::threads() == 4);
+
+    {
+      ThreadScope inner(2);
+      REQUIRE(ThreadScope::threads() == 2);
+    }
+
+    REQUIRE(ThreadScope::threads() == 4);
+  }
+
+  REQUIRE(ThreadScope::threads() == threads);
+
+  REQUIRE_THROWS_AS(ThreadScope(0), std::invalid_argument);
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,135 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <flint/flintxx/frandxx.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "../arbxx/arb_poly.hpp"
+#include "../arbxx/threads.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Create and Copy ArbPoly", "[arb_poly]") {
+  ArbPoly f{{Arb{1}, Arb{2}, Arb{0}}};
+  REQUIRE(f.length() == 2);
+  REQUIRE(f.degree() == 1);
+  REQUIRE(f.get_coeff(1).equal(Arb{2}));
+  REQUIRE(f.get_coeff(2).equal(Arb{}));
+
+  f.set_coeff(3, Arb{7});
+  REQUIRE(f.degree() == 3);
+  REQUIRE(arb_equal(f.arb_poly_t()->coeffs + 3, Arb{7}.arb_t()));
+
+  ArbPoly g = f;
+  REQUIRE(g.equal(f));
+
+  ArbPoly h = std::move(g);
+  REQUIRE(h.equal(f));
+  REQUIRE(g.length() == 0);
+
+  h = ArbPoly{};
+  REQUIRE(h.degree() == -1);
+
+  h = f;
+  REQUIRE(h.equal(f));
+
+  REQUIRE_THROWS_AS(f.get_coeff(-1), std::invalid_argument);
+}
+
+TEST_CASE("Arithmetic of ArbPoly", "[arb_poly]") {
+  flint::frandxx state;
+  const prec prec = GENERATE(64, 256);
+
+  for (int i = 0; i < 16; i++) {
+    const auto f = ArbPoly::randtest(state, 8, prec, 10);
+    const auto g = ArbPoly::randtest(state, 12, prec, 10);
+
+    ArbPoly expected;
+    arb_poly_mul(expected.arb_poly_t(), f.arb_poly_t(), g.arb_poly_t(), prec);
+    REQUIRE(f.mul(g, prec).equal(expected));
+
+    arb_poly_add(expected.arb_poly_t(), f.arb_poly_t(), g.arb_poly_t(), prec);
+    REQUIRE(f.add(g, prec).equal(expected));
+
+    REQUIRE(arb_poly_contains(f.add(g, prec).sub(g, prec).arb_poly_t(), f.arb_poly_t()));
+    REQUIRE(arb_poly_contains(f.add(f.neg(), prec).arb_poly_t(), ArbPoly{}.arb_poly_t()));
+  }
+}
+
+TEST_CASE("Evaluation of ArbPoly", "[arb_poly]") {
+  flint::frandxx state;
+  ArbTester arbs;
+
+  const prec prec = GENERATE(64, 256);
+  const ::arbxx::size length = GENERATE(0, 1, 2, 17, 300);
+  const ::arbxx::size points = GENERATE(0, 1, 33, 300);
+
+  const auto f = ArbPoly::randtest(state, length, prec, 4);
+
+  std::vector<Arb> x;
+  for (::arbxx::size i = 0; i < points; i++)
+    x.push_back(arbs.random(prec, 2));
+
+  std::vector<Arb> expected;
+  for (const auto& xi : x) {
+    Arb yi;
+    arb_poly_evaluate_horner(yi.arb_t(), f.arb_poly_t(), xi.arb_t(), prec);
+    expected.push_back(yi);
+    REQUIRE(arb_overlaps(f.evaluate(xi, prec).arb_t(), yi.arb_t()));
+  }
+
+  const auto horner = [&]() {
+    ThreadScope scope{1};
+    return f.evaluate(x, prec, ArbPoly::Algorithm::HORNER);
+  }();
+
+  const int threads = GENERATE(1, 4);
+  ThreadScope scope{threads};
+
+  for (const auto algorithm : {ArbPoly::Algorithm::AUTOMATIC, ArbPoly::Algorithm::HORNER, ArbPoly::Algorithm::FAST}) {
+    const auto y = f.evaluate(x, prec, algorithm);
+    REQUIRE(y.size() == x.size());
+    for (size_t i = 0; i < y.size(); i++) {
+      REQUIRE(arb_overlaps(y[i].arb_t(), expected[i].arb_t()));
+      if (algorithm == ArbPoly::Algorithm::HORNER)
+        REQUIRE(y[i].equal(horner[i]));
+    }
+  }
+}
+
+TEST_CASE("Evaluation of ArbPoly at Exact Points", "[arb_poly]") {
+  // f = 1 + 2x + 3x²
+  const ArbPoly f{{Arb{1}, Arb{2}, Arb{3}}};
+
+  std::vector<Arb> x;
+  for (int i = -100; i <= 100; i++)
+    x.push_back(Arb{i});
+
+  for (const auto algorithm : {ArbPoly::Algorithm::HORNER, ArbPoly::Algorithm::FAST}) {
+    const auto y = f.evaluate(x, 64, algorithm);
+    for (int i = -100; i <= 100; i++)
+      REQUIRE(arb_contains_si(y[i + 100].arb_t(), 1 + 2 * i + 3 * i * i));
+  }
+}
+
+}  // namespace arbxx::test
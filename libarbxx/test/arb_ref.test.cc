@@ -0,0 +1,164 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <arb_mat.h>
+
+#include <sstream>
+
+// Views are deliberately included before the expression templates, see the
+// test "Views and Fused Expressions" below.
+#include "../arbxx/arb_ref.hpp"
+#include "../arbxx/yap/arb.hpp"
+#include "../arbxx/yap/arf.hpp"
+#include "arb.hpp"
+#include "arf.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Views of Borrowed Elements", "[arb_ref]") {
+  ArbTester arbs;
+
+  arb_ptr v = _arb_vec_init(3);
+  arb_set(v + 0, arbs.random().arb_t());
+  arb_set_si(v + 1, 1);
+  arb_set_si(v + 2, 2);
+
+  SECTION("Views do not Copy") {
+    ArbRef x{v + 0};
+    ArbCRef y{v + 0};
+    REQUIRE(x.arb_t() == v);
+    REQUIRE(y.arb_t() == v);
+    REQUIRE(&*x == &*y);
+    REQUIRE(x.mid().arf_t() == arb_midref(v));
+  }
+
+  SECTION("Relations") {
+    const ArbCRef x{v + 0}, one{v + 1};
+    const ArbRef two{v + 2};
+
+    REQUIRE(*(one < two));
+    REQUIRE(*(two > one));
+    REQUIRE(*(one != two));
+    REQUIRE(*(one == 1));
+    REQUIRE(*(2 == two));
+    REQUIRE(*(one <= Arb(1)));
+    REQUIRE(*(Arb(3) >= two));
+    REQUIRE(!(x == x).has_value());
+    REQUIRE(!(x < ArbRef{v + 0}).has_value());
+
+    REQUIRE(one.mid() < two.mid());
+    REQUIRE(two.mid() == 2);
+    REQUIRE(Arf(2) >= one.mid());
+  }
+
+  SECTION("Conversions") {
+    const ArbCRef one{v + 1};
+    REQUIRE(static_cast<double>(one) == 1);
+    REQUIRE(static_cast<Arf>(one) == 1);
+    REQUIRE(static_cast<std::pair<Arf, Arf>>(one) == std::pair<Arf, Arf>(1, 1));
+    REQUIRE(static_cast<double>(one.mid()) == 1);
+
+    const Arb& x = ArbCRef{v + 0};
+    REQUIRE(x.arb_t() == v);
+    REQUIRE(x.equal(Arb(ArbCRef{v + 0})));
+  }
+
+  SECTION("Printing") {
+    std::stringstream expected, actual;
+    expected << *reinterpret_cast<const Arb*>(v + 0) << " " << Arb(2);
+    actual << ArbCRef{v + 0} << " " << ArbRef{v + 2};
+    REQUIRE(actual.str() == expected.str());
+  }
+
+  SECTION("Assignment Writes Through") {
+    ArbRef x{v + 0};
+    x = 3;
+    REQUIRE(arb_equal_si(v + 0, 3));
+
+    x = ArbCRef{v + 2};
+    REQUIRE(arb_equal_si(v + 0, 2));
+
+    // Assigning a view to a view assigns the element, not the view.
+    ArbRef y{v + 1};
+    x = y;
+    REQUIRE(x.arb_t() == v);
+    REQUIRE(arb_equal_si(v + 0, 1));
+
+    x += 1;
+    x *= ArbCRef{v + 2};
+    REQUIRE(arb_equal_si(v + 0, 4));
+
+    x.mid() = 5;
+    x.mid() <<= 1;
+    REQUIRE(arb_equal_si(v + 0, 10));
+
+    swap(x, y);
+    REQUIRE(arb_equal_si(v + 0, 1));
+    REQUIRE(arb_equal_si(v + 1, 10));
+  }
+
+  _arb_vec_clear(v, 3);
+}
+
+TEST_CASE("Views of Matrix Entries", "[arb_ref]") {
+  arb_mat_t m;
+  arb_mat_init(m, 2, 2);
+  arb_mat_one(m);
+
+  for (slong i = 0; i < 2; i++)
+    for (slong j = 0; j < 2; j++) {
+      ArbRef entry{arb_mat_entry(m, i, j)};
+      REQUIRE(*(entry == (i == j ? 1 : 0)));
+      entry += 1;
+    }
+
+  REQUIRE(*(ArbCRef{arb_mat_entry(m, 0, 0)} == 2));
+  REQUIRE(*(ArbCRef{arb_mat_entry(m, 0, 1)} == 1));
+
+  arb_mat_clear(m);
+}
+
+TEST_CASE("Views and Fused Expressions", "[arb_ref][yap]") {
+  // The helpers of views must not interfere with the detection of fused
+  // multiply-adds of named subexpressions, regardless of include order.
+  ArbTester arbs;
+  ArfTester arfs;
+  const prec prec = GENERATE(2, 64, 256);
+
+  for (int i = 0; i < 128; i++) {
+    const Arb x = arbs.random(), y = arbs.random(), z = arbs.random();
+    const auto product = x * y;
+    const auto sum = z + product;
+    static_assert(detail::is_fusable_product<decltype(boost::yap::right(sum))>, "product of named subexpression not fused");
+
+    Arb expected = z;
+    arb_addmul(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(sum(prec).equal(expected));
+
+    const Arf a = arfs.random(), b = arfs.random(), c = arfs.random();
+    const auto ab = a * b;
+
+    Arf fused;
+    arf_fma(fused.arf_t(), a.arf_t(), b.arf_t(), c.arf_t(), prec, ARF_RND_NEAR);
+    REQUIRE((c + ab)(prec, Arf::Round::NEAR) == fused);
+  }
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,168 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <stdexcept>
+#include <vector>
+
+#include "../arbxx/arb_vector.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+namespace {
+
+ArbVector random(ArbTester& arbs, size length) {
+  ArbVector ret(length);
+  for (auto& x : ret)
+    x = arbs.random();
+  return ret;
+}
+
+}  // namespace
+
+TEST_CASE("Create and Copy ArbVector", "[arb_vector]") {
+  SECTION("Empty Vectors") {
+    ArbVector v;
+    REQUIRE(v.empty());
+    REQUIRE(v.begin() == v.end());
+
+    ArbVector w = v;
+    REQUIRE(w.empty());
+    REQUIRE(w.equal(v));
+  }
+
+  SECTION("Vectors of Zeros") {
+    ArbVector v(3);
+    REQUIRE(v.size() == 3);
+    for (const auto& x : v)
+      REQUIRE(x.equal(Arb()));
+  }
+
+  SECTION("Vectors from Integers") {
+    ArbVector v(std::vector<long>{-1, 0, 1});
+    ArbVector w(std::vector<mpz_class>{-1, 0, 1});
+    REQUIRE(v.size() == 3);
+    REQUIRE(v.equal(w));
+    REQUIRE(v[0].equal(Arb(-1)));
+    REQUIRE(v[2].equal(Arb(1)));
+
+    REQUIRE(static_cast<std::vector<double>>(v) == std::vector<double>{-1, 0, 1});
+  }
+
+  SECTION("Copy, Move, and Assignment") {
+    ArbTester arbs;
+    ArbVector v = random(arbs, 16);
+
+    ArbVector w = v;
+    REQUIRE(w.equal(v));
+    REQUIRE(w.arb_ptr() != v.arb_ptr());
+
+    ArbVector u = std::move(w);
+    REQUIRE(u.equal(v));
+    REQUIRE(w.empty());
+
+    u = ArbVector(3);
+    REQUIRE(u.size() == 3);
+
+    u = v;
+    REQUIRE(u.equal(v));
+
+    v[0] = 1;
+    REQUIRE(!u.equal(v));
+  }
+
+  SECTION("Negative Length") {
+    REQUIRE_THROWS_AS(ArbVector(-1), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Bulk Arithmetic with ArbVector", "[arb_vector]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+  const size length = GENERATE(0, 1, 17);
+
+  for (int i = 0; i < 16; i++) {
+    const ArbVector x = random(arbs, length), y = random(arbs, length);
+    const Arb c = arbs.random();
+
+    ArbVector actual = x;
+    actual.add(y, prec);
+    for (size j = 0; j < length; j++) {
+      Arb expected;
+      arb_add(expected.arb_t(), x[j].arb_t(), y[j].arb_t(), prec);
+      REQUIRE(actual[j].equal(expected));
+    }
+
+    actual = x;
+    actual.sub(y, prec);
+    for (size j = 0; j < length; j++) {
+      Arb expected;
+      arb_sub(expected.arb_t(), x[j].arb_t(), y[j].arb_t(), prec);
+      REQUIRE(actual[j].equal(expected));
+    }
+
+    actual = x;
+    actual.mul(y, prec);
+    for (size j = 0; j < length; j++) {
+      Arb expected;
+      arb_mul(expected.arb_t(), x[j].arb_t(), y[j].arb_t(), prec);
+      REQUIRE(actual[j].equal(expected));
+    }
+
+    actual = x;
+    actual.scalar_mul(c, prec);
+    for (size j = 0; j < length; j++) {
+      Arb expected;
+      arb_mul(expected.arb_t(), x[j].arb_t(), c.arb_t(), prec);
+      REQUIRE(actual[j].equal(expected));
+    }
+
+    actual = x;
+    actual.scalar_addmul(y, c, prec);
+    for (size j = 0; j < length; j++) {
+      Arb expected = x[j];
+      arb_addmul(expected.arb_t(), y[j].arb_t(), c.arb_t(), prec);
+      REQUIRE(actual[j].equal(expected));
+    }
+
+    actual = x;
+    actual.neg();
+    for (size j = 0; j < length; j++)
+      REQUIRE(actual[j].equal(-x[j]));
+
+    // The dot product and the sum are rounded differently than a naive
+    // summation but both must contain the exact result.
+    Arb dot, sum;
+    for (size j = 0; j < length; j++) {
+      arb_addmul(dot.arb_t(), x[j].arb_t(), y[j].arb_t(), prec);
+      arb_add(sum.arb_t(), sum.arb_t(), x[j].arb_t(), prec);
+    }
+    REQUIRE(arb_overlaps(dot.arb_t(), x.dot(y, prec).arb_t()));
+    REQUIRE(arb_overlaps(sum.arb_t(), x.sum(prec).arb_t()));
+  }
+}
+
+TEST_CASE("Bulk Arithmetic with ArbVectors of Different Length", "[arb_vector]") {
+  ArbVector x(2), y(3);
+  REQUIRE_THROWS_AS(x.add(y, 64), std::invalid_argument);
+  REQUIRE_THROWS_AS(x.dot(y, 64), std::invalid_argument);
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,164 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <utility>
+
+#include "../arbxx/arbp.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEMPLATE_TEST_CASE("Conversion between Arb and ArbP", "[arbp]", ArbP<2>, ArbP<64>, ArbP<128>, ArbP<256>) {
+  ArbTester arbs;
+
+  for (int i = 0; i < 128; i++) {
+    const Arb x = arbs.random(512);
+
+    Arb expected;
+    arb_set_round(expected.arb_t(), x.arb_t(), TestType::precision);
+
+    const TestType y{x};
+    REQUIRE(static_cast<Arb>(y).equal(expected));
+  }
+
+  REQUIRE(static_cast<Arb>(TestType{3}).equal(Arb(3)));
+  REQUIRE(static_cast<Arb>(TestType{-3l}).equal(Arb(-3)));
+}
+
+TEMPLATE_TEST_CASE("Arithmetic with ArbP", "[arbp]", ArbP<2>, ArbP<64>, ArbP<128>, ArbP<256>) {
+  ArbTester arbs;
+  const prec prec = TestType::precision;
+
+  for (int i = 0; i < 128; i++) {
+    const Arb x = arbs.random(prec), y = arbs.random(prec);
+    const TestType x_{x}, y_{y};
+
+    Arb expected;
+
+    arb_add(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(static_cast<Arb>(x_ + y_).equal(expected));
+
+    arb_sub(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(static_cast<Arb>(x_ - y_).equal(expected));
+
+    arb_mul(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(static_cast<Arb>(x_ * y_).equal(expected));
+
+    arb_div(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(static_cast<Arb>(x_ / y_).equal(expected));
+
+    arb_add_si(expected.arb_t(), x.arb_t(), -3, prec);
+    REQUIRE(static_cast<Arb>(x_ + -3).equal(expected));
+    REQUIRE(static_cast<Arb>(-3 + x_).equal(expected));
+
+    arb_mul_ui(expected.arb_t(), x.arb_t(), 3, prec);
+    REQUIRE(static_cast<Arb>(x_ * 3u).equal(expected));
+
+    arb_div_si(expected.arb_t(), x.arb_t(), 3, prec);
+    REQUIRE(static_cast<Arb>(x_ / 3).equal(expected));
+
+    arb_sub_si(expected.arb_t(), x.arb_t(), -7, prec);
+    arb_neg(expected.arb_t(), expected.arb_t());
+    REQUIRE(static_cast<Arb>(-7 - x_).equal(expected));
+    REQUIRE((7u - x_).equal(-(x_ - 7u)));
+
+    arb_set_si(expected.arb_t(), -7);
+    arb_div(expected.arb_t(), expected.arb_t(), x.arb_t(), prec);
+    REQUIRE(static_cast<Arb>(-7 / x_).equal(expected));
+
+    arb_set_ui(expected.arb_t(), 7);
+    arb_div(expected.arb_t(), expected.arb_t(), x.arb_t(), prec);
+    REQUIRE(static_cast<Arb>(7ul / x_).equal(expected));
+
+    TestType z = x_;
+    z *= y_;
+    z -= x_;
+    arb_mul(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    arb_sub(expected.arb_t(), expected.arb_t(), x.arb_t(), prec);
+    REQUIRE(static_cast<Arb>(z).equal(expected));
+
+    arb_neg(expected.arb_t(), x.arb_t());
+    REQUIRE(static_cast<Arb>(-x_).equal(expected));
+  }
+}
+
+TEMPLATE_TEST_CASE("Relations of ArbP", "[arbp]", ArbP<2>, ArbP<64>, ArbP<128>, ArbP<256>) {
+  const TestType one{1}, two{2};
+
+  REQUIRE(*(one < two));
+  REQUIRE(*(two > one));
+  REQUIRE(*(one <= one));
+  REQUIRE(*(two >= one));
+  REQUIRE(*(one == one));
+  REQUIRE(*(one != two));
+  REQUIRE(!*(two < one));
+
+  const TestType third = one / 3;
+  REQUIRE(!(third < third).has_value());
+  REQUIRE(!(third == third).has_value());
+  REQUIRE(third.equal(third));
+}
+
+TEMPLATE_TEST_CASE("Copy and Move ArbP", "[arbp]", ArbP<2>, ArbP<64>, ArbP<128>, ArbP<256>) {
+  ArbTester arbs;
+
+  const TestType x{arbs.random(512)};
+
+  TestType y = x;
+  REQUIRE(y.equal(x));
+
+  TestType z = std::move(y);
+  REQUIRE(z.equal(x));
+  REQUIRE(y.equal(TestType{}));
+
+  y = z;
+  REQUIRE(y.equal(x));
+
+  // Elements with an exponent that is a big integer are copied by Arb.
+  TestType large{1};
+  arb_mul_2exp_si(large.arb_t(), large.arb_t(), COEFF_MAX);
+  arb_mul_2exp_si(large.arb_t(), large.arb_t(), COEFF_MAX);
+
+  y = large;
+  REQUIRE(y.equal(large));
+  large = x;
+  REQUIRE(large.equal(x));
+
+  TestType copy{y};
+  REQUIRE(copy.equal(y));
+  swap(copy, large);
+  REQUIRE(large.equal(y));
+  REQUIRE(copy.equal(x));
+}
+
+TEST_CASE("Mantissas of ArbP are Inline", "[arbp]") {
+  STATIC_REQUIRE(ArbP<64>::inline_mantissa);
+  STATIC_REQUIRE(ArbP<2 * FLINT_BITS>::inline_mantissa);
+  STATIC_REQUIRE(!ArbP<2 * FLINT_BITS + 1>::inline_mantissa);
+
+  ArbTester arbs;
+  ArbP<2 * FLINT_BITS> x{arbs.random(1024)};
+  for (int i = 0; i < 16; i++)
+    x *= ArbP<2 * FLINT_BITS>{arbs.random(1024)};
+
+  REQUIRE(!ARF_HAS_PTR(arb_midref(x.arb_t())));
+}
+
+}  // namespace arbxx::test
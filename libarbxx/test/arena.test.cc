@@ -0,0 +1,163 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <flint/flint.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../arbxx/arena.hpp"
+#include "../arbxx/precision.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Arithmetic in an Arena", "[arena]") {
+  const prec prec = GENERATE(64, 1024, 65536);
+
+  ArbTester arbs;
+  std::vector<Arb> values;
+  for (int i = 0; i < 64; i++)
+    values.push_back(arbs.random(prec));
+
+  // The results of a computation do not depend on where their memory comes
+  // from.
+  const auto compute = [&]() {
+    PrecisionScope scope(prec);
+    std::vector<Arb> results;
+    for (size_t i = 0; i + 1 < values.size(); i++) {
+      Arb x = values[i];
+      x *= values[i + 1];
+      x += values[i];
+      x /= values[i + 1];
+      results.push_back(x);
+    }
+    return results;
+  };
+
+  const auto expected = compute();
+
+  REQUIRE(!Arena::active());
+
+  std::vector<Arb> results;
+  {
+    const std::size_t chunk_size = GENERATE(1024, Arena::DEFAULT_CHUNK_SIZE);
+    Arena arena(chunk_size);
+    REQUIRE(Arena::active());
+
+    results = compute();
+
+    // Small mantissas live inside an Arf; large ones do not fit into a chunk.
+    if (prec > 64 && static_cast<std::size_t>(prec) / 8 < chunk_size / 4)
+      REQUIRE(arena.allocations() > 0);
+  }
+
+  REQUIRE(!Arena::active());
+
+  // The results escaped the arena but are still valid.
+  REQUIRE(results.size() == expected.size());
+  for (size_t i = 0; i < results.size(); i++)
+    REQUIRE(results[i].equal(expected[i]));
+}
+
+TEST_CASE("Nesting of Arenas", "[arena]") {
+  Arb escaped;
+  {
+    Arena outer;
+    Arb x(mpq_class(1, 3), 4096);
+    {
+      Arena inner;
+      Arb y(mpq_class(1, 5), 4096);
+      REQUIRE(inner.allocations() > 0);
+
+      const auto allocations = outer.allocations();
+      Arb z(mpq_class(1, 7), 4096);
+      REQUIRE(outer.allocations() == allocations);
+
+      escaped = std::move(y);
+    }
+    REQUIRE(Arena::active());
+    x = escaped;
+  }
+
+  REQUIRE(escaped.equal(Arb(mpq_class(1, 5), 4096)));
+
+  REQUIRE_THROWS_AS(Arena(0), std::invalid_argument);
+}
+
+TEST_CASE("Overflowing calloc in an Arena", "[arena]") {
+  Arena arena;
+
+  void* (*malloc)(size_t);
+  void* (*calloc)(size_t, size_t);
+  void* (*realloc)(void*, size_t);
+  void (*free)(void*);
+  __flint_get_memory_functions(&malloc, &calloc, &realloc, &free);
+
+  REQUIRE(calloc(SIZE_MAX / 8 + 2, 8) == nullptr);
+  REQUIRE(calloc(2, SIZE_MAX / 2 + 1) == nullptr);
+
+  void* ptr = calloc(0, SIZE_MAX);
+  free(ptr);
+  REQUIRE(arena.allocations() == 1);
+}
+
+TEST_CASE("Arenas are Thread Local", "[arena]") {
+  std::vector<Arb> escaped(4);
+
+  {
+    Arena arena;
+
+    std::vector<std::thread> threads;
+    std::vector<int> active(4);
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back([&, t]() {
+        active[t] = Arena::active();
+
+        Arena local;
+        for (int i = 0; i < 1024; i++) {
+          Arb x(mpq_class(1, 3 + t), 4096);
+          x += 1;
+          if (i == 0)
+            escaped[t] = x;
+        }
+      });
+    }
+    for (auto& thread : threads)
+      thread.join();
+
+    for (int t = 0; t < 4; t++)
+      REQUIRE(!active[t]);
+
+    REQUIRE(arena.allocations() == 0);
+  }
+
+  // Elements allocated in an arena of another thread can be freed here.
+  for (int t = 0; t < 4; t++) {
+    Arb expected(mpq_class(1, 3 + t), 4096);
+    expected += 1;
+    REQUIRE(escaped[t].equal(expected));
+  }
+  escaped.clear();
+}
+
+}  // namespace arbxx::test
@@ -19,8 +19,12 @@
  *********************************************************************/
 
 #include <boost/lexical_cast.hpp>
+#include <functional>
+#include <unordered_set>
 
 #include "../arbxx/arf.hpp"
+#include "../arbxx/yap/arf.hpp"
+#include "arf.hpp"
 #include "external/catch2/single_include/catch2/catch.hpp"
 
 using boost::lexical_cast;
@@ -60,4 +64,212 @@ TEST_CASE("Floor & Ceil", "[arf]") {
   REQUIRE(Arf(.6).ceil() == 1);
 }
 
+TEST_CASE("Hashing of Arf", "[arf][hash]") {
+  const std::hash<Arf> hash;
+
+  SECTION("Equal Elements have Equal Hashes") {
+    REQUIRE(hash(Arf(1)) == hash(Arf(mpz_class(2), -1)));
+    REQUIRE(hash(Arf(-3)) == hash(Arf(mpz_class(-3))));
+    REQUIRE(hash(Arf()) == hash(Arf(mpz_class(0), 1337)));
+
+    const mpz_class large = (mpz_class(1) << 256) + 1;
+    REQUIRE(hash(Arf(large, 7)) == hash(Arf(large << 3, 4)));
+
+    // Exponents that do not fit into a machine word.
+    REQUIRE(hash(Arf(1) << (1L << 62)) == hash(Arf(2) << ((1L << 62) - 1)));
+  }
+
+  SECTION("Elements that Agree in the First 53 Bits") {
+    std::unordered_set<size_t> hashes;
+    for (int i = 0; i < 1024; i++)
+      hashes.insert(hash(Arf((mpz_class(1) << 200) + i, -200)));
+
+    REQUIRE(hashes.size() == 1024);
+  }
+
+  SECTION("Elements that Differ only in Sign or Exponent") {
+    REQUIRE(hash(Arf(1)) != hash(Arf(-1)));
+    REQUIRE(hash(Arf(1)) != hash(Arf(2)));
+  }
+}
+
+TEST_CASE("Binary Operators on Arf", "[arf][yap]") {
+  ArfTester arfs;
+  const prec prec = GENERATE(2, 64, 256);
+  const auto round = GENERATE(Arf::Round::NEAR, Arf::Round::DOWN, Arf::Round::UP, Arf::Round::FLOOR, Arf::Round::CEIL);
+  const auto rnd = static_cast<arf_rnd_t>(round);
+
+  for (int i = 0; i < 128; i++) {
+    const Arf x = arfs.random(), y = arfs.random();
+
+    Arf expected;
+
+    arf_add(expected.arf_t(), x.arf_t(), y.arf_t(), prec, rnd);
+    REQUIRE((x + y)(prec, round) == expected);
+
+    arf_sub(expected.arf_t(), x.arf_t(), y.arf_t(), prec, rnd);
+    REQUIRE((x - y)(prec, round) == expected);
+
+    arf_mul(expected.arf_t(), x.arf_t(), y.arf_t(), prec, rnd);
+    REQUIRE((x * y)(prec, round) == expected);
+
+    arf_div(expected.arf_t(), x.arf_t(), y.arf_t(), prec, rnd);
+    REQUIRE((x / y)(prec, round) == expected);
+
+    arf_sqrt(expected.arf_t(), x.abs().arf_t(), prec, rnd);
+    REQUIRE(sqrt(x.abs())(prec, round) == expected);
+
+    arf_set_round(expected.arf_t(), x.arf_t(), prec, rnd);
+    REQUIRE(x(prec, round) == expected);
+  }
+}
+
+TEST_CASE("Arithmetic of Arf with Integers", "[arf][yap]") {
+  ArfTester arfs;
+  const prec prec = GENERATE(2, 64, 256);
+  const auto round = GENERATE(Arf::Round::NEAR, Arf::Round::FLOOR, Arf::Round::CEIL);
+  const auto rnd = static_cast<arf_rnd_t>(round);
+
+  for (int i = 0; i < 128; i++) {
+    const Arf x = arfs.random();
+
+    Arf expected;
+
+    arf_add_si(expected.arf_t(), x.arf_t(), -3, prec, rnd);
+    REQUIRE((x + -3)(prec, round) == expected);
+    REQUIRE((-3 + x)(prec, round) == expected);
+
+    arf_sub_ui(expected.arf_t(), x.arf_t(), 3, prec, rnd);
+    REQUIRE((x - 3u)(prec, round) == expected);
+
+    // 3 - x must be rounded as such and not as -(x - 3).
+    arf_neg(expected.arf_t(), x.arf_t());
+    arf_add_ui(expected.arf_t(), expected.arf_t(), 3, prec, rnd);
+    REQUIRE((3u - x)(prec, round) == expected);
+
+    arf_mul_si(expected.arf_t(), x.arf_t(), 3, prec, rnd);
+    REQUIRE((x * 3)(prec, round) == expected);
+    REQUIRE((3 * x)(prec, round) == expected);
+
+    arf_si_div(expected.arf_t(), -3, x.arf_t(), prec, rnd);
+    REQUIRE((-3 / x)(prec, round) == expected);
+
+    const mpz_class large = mpz_class(1) << 256;
+    fmpz_t large_;
+    fmpz_init(large_);
+    fmpz_set_mpz(large_, large.get_mpz_t());
+
+    arf_add_fmpz(expected.arf_t(), x.arf_t(), large_, prec, rnd);
+    REQUIRE((x + large)(prec, round) == expected);
+
+    arf_div_fmpz(expected.arf_t(), x.arf_t(), large_, prec, rnd);
+    REQUIRE((x / large)(prec, round) == expected);
+
+    fmpz_clear(large_);
+  }
+}
+
+TEST_CASE("Fused Multiply Add with Arf", "[arf][yap]") {
+  ArfTester arfs;
+  const prec prec = GENERATE(2, 64, 256);
+  const auto round = GENERATE(Arf::Round::NEAR, Arf::Round::DOWN, Arf::Round::UP, Arf::Round::FLOOR, Arf::Round::CEIL);
+  const auto rnd = static_cast<arf_rnd_t>(round);
+
+  for (int i = 0; i < 128; i++) {
+    const Arf a = arfs.random(), b = arfs.random(), c = arfs.random();
+
+    Arf expected;
+
+    arf_fma(expected.arf_t(), a.arf_t(), b.arf_t(), c.arf_t(), prec, rnd);
+    REQUIRE((a * b + c)(prec, round) == expected);
+    REQUIRE((c + a * b)(prec, round) == expected);
+    REQUIRE(fma(a, b, c)(prec, round) == expected);
+
+    arf_fma(expected.arf_t(), a.arf_t(), b.arf_t(), (-c).arf_t(), prec, rnd);
+    REQUIRE((a * b - c)(prec, round) == expected);
+
+    arf_fma(expected.arf_t(), (-a).arf_t(), b.arf_t(), c.arf_t(), prec, rnd);
+    REQUIRE((c - a * b)(prec, round) == expected);
+
+    Arf x = c;
+    {
+      PrecisionScope scope{prec, round};
+      x -= a * b;
+    }
+    REQUIRE(x == expected);
+  }
+
+  SECTION("Products are not Rounded") {
+    const Arf a{3}, b{3}, c{-1};
+    REQUIRE((a * b + c)(2, Arf::Round::DOWN) == 8);
+    REQUIRE(((a * b)(2, Arf::Round::DOWN) + c)(2, Arf::Round::DOWN) == 6);
+  }
+}
+
+TEST_CASE("Sums of Arf", "[arf][yap]") {
+  ArfTester arfs;
+  const prec prec = GENERATE(2, 64, 256);
+  const auto round = GENERATE(Arf::Round::NEAR, Arf::Round::FLOOR, Arf::Round::CEIL);
+  const auto rnd = static_cast<arf_rnd_t>(round);
+
+  for (int i = 0; i < 128; i++) {
+    const Arf a = arfs.random(), b = arfs.random(), c = arfs.random(), d = arfs.random();
+
+    arf_struct terms[4];
+    terms[0] = *a.arf_t();
+    terms[1] = *b.arf_t();
+    arf_init_neg_shallow(&terms[2], c.arf_t());
+    arf_init_set_si(&terms[3], 7);
+
+    Arf expected;
+    arf_sum(expected.arf_t(), terms, 4, prec, rnd);
+    REQUIRE((a + b - c + 7)(prec, round) == expected);
+    REQUIRE((a - (c - b) + 7)(prec, round) == expected);
+  }
+
+  SECTION("Sums are Rounded Once") {
+    const Arf one{1}, tiny{mpz_class{1}, -100};
+    REQUIRE((one + tiny - one)(2, Arf::Round::NEAR) == tiny);
+  }
+}
+
+TEST_CASE("Directed Rounding of Arf Expressions", "[arf][yap]") {
+  const Arf one{1}, three{3};
+
+  const Arf third = (one / three)(2, Arf::Round::FLOOR);
+  REQUIRE(third == Arf(mpz_class{1}, -2));
+
+  // Negation is exact, so -(x) rounds x in the opposite direction.
+  REQUIRE((-(one / three))(2, Arf::Round::FLOOR) == Arf(mpz_class{-3}, -3));
+  REQUIRE((-(one / three))(2, Arf::Round::CEIL) == -third);
+
+  // In-place arithmetic uses the rounding mode of the current scope.
+  Arf x{1};
+  {
+    PrecisionScope scope{2, Arf::Round::UP};
+    x /= three * 1;
+  }
+  REQUIRE(x == Arf(mpz_class{3}, -3));
+}
+
+TEST_CASE("Exact Arithmetic with Arf", "[arf][yap]") {
+  ArfTester arfs;
+
+  for (int i = 0; i < 128; i++) {
+    const Arf a = arfs.random(256), b = arfs.random(256), c = arfs.random(256);
+
+    const Arf product = (a * b)(ARF_PREC_EXACT, Arf::Round::DOWN);
+    REQUIRE((product / b)(256, Arf::Round::NEAR) == a);
+
+    const Arf sum = (a + b + c)(ARF_PREC_EXACT, Arf::Round::DOWN);
+    REQUIRE((sum - b - c)(ARF_PREC_EXACT, Arf::Round::DOWN) == a);
+
+    REQUIRE((a * b - product)(ARF_PREC_EXACT, Arf::Round::DOWN) == 0);
+  }
+
+  const Arf one{1}, three{3};
+  REQUIRE_THROWS_AS((one / three)(ARF_PREC_EXACT, Arf::Round::NEAR), std::invalid_argument);
+  REQUIRE_THROWS_AS(sqrt(three)(ARF_PREC_EXACT, Arf::Round::NEAR), std::invalid_argument);
+}
+
 }  // namespace arbxx::test
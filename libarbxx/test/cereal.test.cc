@@ -19,15 +19,24 @@
  *********************************************************************/
 
 #include <boost/lexical_cast.hpp>
+#include <cereal/archives/binary.hpp>
 #include <cereal/archives/json.hpp>
+#include <cereal/archives/portable_binary.hpp>
+#include <cereal/types/string.hpp>
+#include <sstream>
+#include <stdexcept>
 
 #include "../arbxx/cereal.hpp"
 #include "arb.hpp"
 #include "arf.hpp"
 #include "external/catch2/single_include/catch2/catch.hpp"
 
+using cereal::BinaryInputArchive;
+using cereal::BinaryOutputArchive;
 using cereal::JSONInputArchive;
 using cereal::JSONOutputArchive;
+using cereal::PortableBinaryInputArchive;
+using cereal::PortableBinaryOutputArchive;
 
 // TODO: Simplify
 
@@ -38,25 +47,25 @@ std::string toString(const T& x) {
   return boost::lexical_cast<std::string>(x);
 }
 
-template <typename T>
+template <typename OutputArchive = JSONOutputArchive, typename InputArchive = JSONInputArchive, typename T>
 T test_serialization(const T& x) {
   std::stringstream s;
 
   {
-    JSONOutputArchive archive(s);
+    OutputArchive archive(s);
     archive(cereal::make_nvp("test", x));
   }
 
   T y;
   {
-    JSONInputArchive archive(s);
+    InputArchive archive(s);
     archive(cereal::make_nvp("test", y));
   }
 
-  if constexpr (std::is_same_v<T, Arb>) {
+  if constexpr (std::is_same_v<T, Arb> || std::is_same_v<T, Acb>) {
     if (x.equal(y)) return y;
   } else {
-    if (x == y) return y;
+    if (x == y || (arf_is_nan(x.arf_t()) && arf_is_nan(y.arf_t()))) return y;
   }
   throw std::runtime_error("deserialization failed to reconstruct element, the original value " + toString(x) + " had serialized to " + s.str() + " which deserialized to " + toString(y));
 }
@@ -70,6 +79,37 @@ TEST_CASE("Serialization of Arb", "[cereal][arb]") {
     // (memmove can handle overlapping addresses.)
     test_serialization(arbs.random());
   }
+
+  SECTION("Binary Archives") {
+    const prec prec = GENERATE(53, 256, 4096);
+    const size mag = GENERATE(10, 1024);
+
+    for (int i = 0; i < 128; i++) {
+      const Arb x = arbs.random(prec, mag);
+      test_serialization<BinaryOutputArchive, BinaryInputArchive>(x);
+      test_serialization<PortableBinaryOutputArchive, PortableBinaryInputArchive>(x);
+    }
+
+    for (const Arb& x : {Arb(), Arb(1), Arb::zero_pm_inf(), Arb::indeterminate(), Arb(std::pair{Arf(1), Arf(1) << (1L << 62)})}) {
+      test_serialization<BinaryOutputArchive, BinaryInputArchive>(x);
+      test_serialization<PortableBinaryOutputArchive, PortableBinaryInputArchive>(x);
+    }
+  }
+}
+
+TEST_CASE("Serialization of Acb", "[cereal][acb]") {
+  ArbTester arbs;
+  for (int i = 0; i < 128; i++) {
+    const Acb x(arbs.random(), arbs.random());
+    test_serialization(x);
+    test_serialization<BinaryOutputArchive, BinaryInputArchive>(x);
+    test_serialization<PortableBinaryOutputArchive, PortableBinaryInputArchive>(x);
+  }
+
+  for (const Acb& x : {Acb(), Acb::i(), Acb::indeterminate(), Acb(Arb(1), Arb::zero_pm_inf())}) {
+    test_serialization<BinaryOutputArchive, BinaryInputArchive>(x);
+    test_serialization<PortableBinaryOutputArchive, PortableBinaryInputArchive>(x);
+  }
 }
 
 TEST_CASE("Serialization of Arf", "[cereal][arf]") {
@@ -81,6 +121,98 @@ TEST_CASE("Serialization of Arf", "[cereal][arf]") {
     // (memmove can handle overlapping addresses.)
     test_serialization(arfs.random());
   }
+
+  SECTION("Binary Archives") {
+    const prec prec = GENERATE(53, 256, 4096);
+    const size mag = GENERATE(10, 1024);
+
+    for (int i = 0; i < 128; i++) {
+      const Arf x = arfs.random(prec, mag);
+      test_serialization<BinaryOutputArchive, BinaryInputArchive>(x);
+      test_serialization<PortableBinaryOutputArchive, PortableBinaryInputArchive>(x);
+    }
+
+    for (const Arf& x : {Arf(), Arf(-1), Arf(mpz_class(1) << 256, -1024), Arf(1) << (1L << 62), -(Arf(3) >> ((1L << 62) + 8))}) {
+      test_serialization<BinaryOutputArchive, BinaryInputArchive>(x);
+      test_serialization<PortableBinaryOutputArchive, PortableBinaryInputArchive>(x);
+    }
+
+    Arf special;
+    for (auto set : {arf_pos_inf, arf_neg_inf, arf_nan}) {
+      set(special.arf_t());
+      test_serialization<BinaryOutputArchive, BinaryInputArchive>(special);
+    }
+  }
+}
+
+TEST_CASE("Binary Archives are Compact", "[cereal][arb]") {
+  const prec prec = GENERATE(64, 65536);
+
+  const Arb x(mpq_class(1, 3), prec);
+
+  std::stringstream binary;
+  {
+    BinaryOutputArchive archive(binary);
+    archive(x);
+  }
+
+  // Older versions of arbxx wrote the hexadecimal output of arb_dump_str()
+  // and a double approximation to binary archives.
+  std::stringstream legacy;
+  {
+    BinaryOutputArchive archive(legacy);
+    char* serialized = arb_dump_str(x.arb_t());
+    archive(std::string(serialized), static_cast<double>(x));
+    flint_free(serialized);
+  }
+
+  REQUIRE(binary.str().size() < legacy.str().size());
+}
+
+TEST_CASE("Load Legacy Binary Archives", "[cereal][arb][arf]") {
+  ArbTester arbs;
+  ArfTester arfs;
+
+  for (int i = 0; i < 128; i++) {
+    const Arb x = arbs.random();
+    const Arf y = arfs.random();
+
+    std::stringstream s;
+    {
+      BinaryOutputArchive archive(s);
+
+      char* serialized = arb_dump_str(x.arb_t());
+      archive(std::string(serialized), static_cast<double>(x));
+      flint_free(serialized);
+
+      serialized = arf_dump_str(y.arf_t());
+      archive(std::string(serialized), static_cast<double>(y));
+      flint_free(serialized);
+    }
+
+    Arb xx;
+    Arf yy;
+    {
+      BinaryInputArchive archive(s);
+      archive(xx, yy);
+    }
+
+    REQUIRE(xx.equal(x));
+    REQUIRE(yy == y);
+  }
+}
+
+TEST_CASE("Load Malformed Binary Archives", "[cereal][arf]") {
+  std::stringstream s;
+  {
+    BinaryOutputArchive archive(s);
+    // An unsupported version of the binary format.
+    archive(std::string(), std::uint8_t{255}, static_cast<std::uint8_t>(FLINT_BITS));
+  }
+
+  Arf x;
+  BinaryInputArchive archive(s);
+  REQUIRE_THROWS_AS(archive(x), std::logic_error);
 }
 
 }  // namespace arbxx::test
@@ -0,0 +1,130 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <climits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../arbxx/arb_vector.hpp"
+#include "../arbxx/compare.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+namespace {
+
+// Return elements that cover the special cases of the comparison: balls
+// that contain zero, exact elements, elements of both signs, elements that
+// only differ in their mantissas, and elements that are not finite.
+std::vector<Arb> random(ArbTester& arbs) {
+  std::vector<Arb> ret;
+  for (int i = 0; i < 1024; i++) {
+    switch (i % 8) {
+      case 0:
+        ret.push_back(Arb(i / 8 - 64));
+        break;
+      case 1:
+        ret.push_back(Arb());
+        break;
+      case 2: {
+        Arb x;
+        arb_mul_2exp_si(x.arb_t(), arbs.random().arb_t(), 1L << 40);
+        ret.push_back(x);
+        break;
+      }
+      case 3: {
+        Arb x;
+        if (i % 16 == 3)
+          arb_zero_pm_inf(x.arb_t());
+        else
+          arb_indeterminate(x.arb_t());
+        ret.push_back(x);
+        break;
+      }
+      default:
+        ret.push_back(arbs.random(53, i % 8));
+    }
+  }
+  return ret;
+}
+
+// Check that the comparison agrees with operator<.
+template <typename Rhs>
+void check(const Comparison& comparison, const std::vector<Arb>& lhs, const Rhs& rhs) {
+  REQUIRE(comparison.lt.size() == static_cast<::arbxx::size>(lhs.size()));
+  REQUIRE(comparison.undecided.size() == static_cast<::arbxx::size>(lhs.size()));
+
+  for (size_t i = 0; i < lhs.size(); i++) {
+    const auto expected = [&]() {
+      if constexpr (std::is_same_v<Rhs, long>)
+        return lhs[i] < rhs;
+      else
+        return lhs[i] < rhs[i];
+    }();
+
+    REQUIRE(comparison.undecided[i] == !expected.has_value());
+    REQUIRE(comparison.lt[i] == expected.value_or(false));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("Bitmask", "[compare]") {
+  Bitmask mask{130};
+  REQUIRE(mask.size() == 130);
+  REQUIRE(mask.count() == 0);
+
+  for (::arbxx::size i : {0, 63, 64, 129})
+    mask.set(i);
+
+  REQUIRE(mask[63]);
+  REQUIRE(!mask[62]);
+  REQUIRE(mask.count() == 4);
+  REQUIRE(mask.indices() == std::vector<::arbxx::size>{0, 63, 64, 129});
+  REQUIRE(mask.words()[1] == 1);
+}
+
+TEST_CASE("Compare many Arb Elements", "[compare]") {
+  ArbTester arbs;
+
+  const auto x = random(arbs);
+  const auto y = random(arbs);
+
+  SECTION("Compare to Elements") {
+    check(compare(x, y), x, y);
+    check(compare(y, x), y, x);
+    check(compare(x, x), x, x);
+    check(compare(ArbVector{x}, ArbVector{y}), x, y);
+  }
+
+  SECTION("Compare to Integers") {
+    for (long n : {0L, 1L, -1L, 7L, -64L, 1L << 40, LONG_MIN, LONG_MAX}) {
+      check(compare(x, n), x, n);
+      check(compare(ArbVector{x}, n), x, n);
+    }
+  }
+
+  SECTION("Mismatched Lengths") {
+    REQUIRE_THROWS_AS(compare(x, std::vector<Arb>{}), std::invalid_argument);
+  }
+}
+
+}  // namespace arbxx::test
@@ -24,13 +24,26 @@
 namespace arbxx::test {
 
 TEST_CASE("Test cppyy's C++ interface to Arb", "[arb][cppyy]") {
-  // TODO
-  /*
   Arb x(1);
   auto y = x + x;
   Arb z = arbxx::cppyy::eval(std::move(y), 10);
   REQUIRE(z.equal(Arb(2)));
-  */
+}
+
+TEST_CASE("Test cppyy's C++ interface to Acb", "[acb][cppyy]") {
+  Acb x(Arb(1), Arb(1));
+  auto y = x * x;
+  Acb z = arbxx::cppyy::eval(std::move(y), 10);
+  REQUIRE(z.equal(Acb(Arb(), Arb(2))));
+  REQUIRE(arbxx::cppyy::eval(x, 10).equal(x));
+  REQUIRE(*arbxx::cppyy::ne(x, 1));
+}
+
+TEST_CASE("Test cppyy's C++ interface to Arf", "[arf][cppyy]") {
+  Arf x(1), y(3);
+  auto z = x / y;
+  Arf w = arbxx::cppyy::eval(std::move(z), 2, Arf::Round::DOWN);
+  REQUIRE(w == Arf(mpz_class(1), -2));
 }
 
 }  // namespace arbxx::test
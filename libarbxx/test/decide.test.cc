@@ -0,0 +1,155 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "../arbxx/decide.hpp"
+#include "../arbxx/yap/arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Decide Relations with Increasing Precision", "[decide]") {
+  std::vector<prec> tried;
+
+  SECTION("Relations that are Decided Immediately") {
+    auto decision = decide([&](prec prec) {
+      tried.push_back(prec);
+      return Arb(1) < Arb(2);
+    });
+
+    REQUIRE(decision);
+    REQUIRE(decision->value);
+    REQUIRE(decision->precision == ARB_PRECISION_FAST);
+    REQUIRE(tried == std::vector<prec>{ARB_PRECISION_FAST});
+  }
+
+  SECTION("Relations that Need More Precision") {
+    const mpq_class a{1, 3};
+    const mpq_class b = a + mpq_class{1, mpz_class{1} << 200};
+
+    auto decision = decide([&](prec prec) {
+      tried.push_back(prec);
+      return Arb(b, prec) <= Arb(a, prec);
+    });
+
+    REQUIRE(decision);
+    REQUIRE(!decision->value);
+    REQUIRE(decision->precision == 256);
+    REQUIRE(tried == std::vector<prec>{64, 128, 256});
+  }
+
+  SECTION("Relations that Cannot be Decided") {
+    auto decision = decide(
+        [&](prec prec) {
+          tried.push_back(prec);
+          return Arb(mpq_class{1, 3}, prec) == Arb(mpq_class{1, 3}, prec);
+        },
+        32, 1024);
+
+    REQUIRE(!decision);
+    REQUIRE(tried == std::vector<prec>{32, 64, 128, 256, 512, 1024});
+  }
+
+  SECTION("The Last Attempt is at the Maximum Precision") {
+    auto never = [&](prec prec) {
+      tried.push_back(prec);
+      return std::optional<bool>{};
+    };
+
+    REQUIRE(!decide(never, 3, 100));
+    REQUIRE(tried == std::vector<prec>{3, 6, 12, 24, 48, 96, 100});
+
+    // Doubling close to the largest precision must not overflow.
+    tried.clear();
+    const prec max = std::numeric_limits<prec>::max();
+    REQUIRE(!decide(never, max / 3, max));
+    REQUIRE(tried == std::vector<prec>{max / 3, 2 * (max / 3), max});
+
+    tried.clear();
+    REQUIRE(!decide(never, 7, 7));
+    REQUIRE(tried == std::vector<prec>{7});
+  }
+
+  SECTION("Invalid Precisions") {
+    auto never = [&](prec) { return std::optional<bool>{}; };
+    REQUIRE_THROWS_AS(decide(never, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(decide(never, -64), std::invalid_argument);
+    REQUIRE_THROWS_AS(decide(never, 128, 64), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Cache Approximations Across Precisions", "[decide]") {
+  int evaluations = 0;
+
+  SECTION("Inexact Approximations") {
+    Approximation third{[&](prec prec) {
+      evaluations++;
+      return Arb(mpq_class{1, 3}, prec);
+    }};
+
+    REQUIRE(third(128).equal(Arb(mpq_class{1, 3}, 128)));
+    REQUIRE(third(64).equal(Arb(mpq_class{1, 3}, 128)));
+    REQUIRE(evaluations == 1);
+
+    REQUIRE(third(256).equal(Arb(mpq_class{1, 3}, 256)));
+    REQUIRE(evaluations == 2);
+  }
+
+  SECTION("Exact Approximations") {
+    Approximation half{[&](prec prec) {
+      evaluations++;
+      return Arb(mpq_class{1, 2}, prec);
+    }};
+
+    REQUIRE(half(64).is_exact());
+    REQUIRE(half(1024).is_exact());
+    REQUIRE(evaluations == 1);
+  }
+
+  SECTION("Approximations in Decisions") {
+    const Arb x(mpq_class{1, 3}, 1024);
+
+    Approximation square{[&](prec prec) {
+      evaluations++;
+      return (x * x)(prec);
+    }};
+
+    const mpq_class ninth = mpq_class{1, 9} + mpq_class{1, mpz_class{1} << 100};
+
+    // The square is evaluated only once for each precision that decide()
+    // tries even though it is used twice in the relation.
+    auto decision = decide([&](prec prec) -> std::optional<bool> {
+      const auto below = square(prec) < ninth;
+      const auto above = square(prec) > mpq_class{1, 10};
+      if (below && above) return *below && *above;
+      return std::nullopt;
+    });
+
+    REQUIRE(decision);
+    REQUIRE(decision->value);
+    REQUIRE(decision->precision == 128);
+    REQUIRE(evaluations == 2);
+  }
+}
+
+}  // namespace arbxx::test
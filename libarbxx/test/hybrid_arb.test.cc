@@ -0,0 +1,195 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <cmath>
+#include <random>
+
+#include "../arbxx/hybrid_arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+namespace {
+
+// Return an exact Arb equal to the double x.
+Arb exact(double x) {
+  Arb ret;
+  arb_set_d(ret.arb_t(), x);
+  return ret;
+}
+
+// Return a random double of modest magnitude.
+double random(std::mt19937_64& rand) {
+  std::uniform_real_distribution<double> mantissa(-1, 1);
+  std::uniform_int_distribution<int> exponent(-64, 64);
+  return std::ldexp(mantissa(rand), exponent(rand));
+}
+
+}  // namespace
+
+TEST_CASE("Arithmetic of Exact HybridArb", "[hybrid_arb]") {
+  std::mt19937_64 rand;
+
+  for (int i = 0; i < 1024; i++) {
+    const double a = random(rand), b = random(rand);
+    const HybridArb x{a}, y{b};
+
+    Arb expected;
+
+    arb_add(expected.arb_t(), exact(a).arb_t(), exact(b).arb_t(), ARF_PREC_EXACT);
+    REQUIRE(!(x + y).is_arb());
+    REQUIRE(arb_contains(static_cast<Arb>(x + y).arb_t(), expected.arb_t()));
+
+    arb_sub(expected.arb_t(), exact(a).arb_t(), exact(b).arb_t(), ARF_PREC_EXACT);
+    REQUIRE(arb_contains(static_cast<Arb>(x - y).arb_t(), expected.arb_t()));
+
+    arb_mul(expected.arb_t(), exact(a).arb_t(), exact(b).arb_t(), ARF_PREC_EXACT);
+    REQUIRE(arb_contains(static_cast<Arb>(x * y).arb_t(), expected.arb_t()));
+
+    arb_div(expected.arb_t(), exact(a).arb_t(), exact(b).arb_t(), 512);
+    REQUIRE(arb_contains(static_cast<Arb>(x / y).arb_t(), expected.arb_t()));
+  }
+
+  SECTION("Exact Results are Exact") {
+    REQUIRE((HybridArb{1} + HybridArb{2}).is_exact());
+    REQUIRE((HybridArb{3} * HybridArb{.5}).is_exact());
+    REQUIRE((HybridArb{3} / HybridArb{4}).is_exact());
+    REQUIRE(!(HybridArb{.1} + HybridArb{.2}).is_exact());
+    REQUIRE(!(HybridArb{1} / HybridArb{3}).is_exact());
+  }
+}
+
+TEST_CASE("Arithmetic of HybridArb Intervals", "[hybrid_arb]") {
+  std::mt19937_64 rand;
+
+  // Return an element enclosing [min(a, b), max(a, b)].
+  const auto interval = [](double a, double b) {
+    Arb ret;
+    arf_t lower, upper;
+    arf_init(lower);
+    arf_init(upper);
+    arf_set_d(lower, std::min(a, b));
+    arf_set_d(upper, std::max(a, b));
+    arb_set_interval_arf(ret.arb_t(), lower, upper, 64);
+    arf_clear(lower);
+    arf_clear(upper);
+    return HybridArb{ret};
+  };
+
+  for (int i = 0; i < 1024; i++) {
+    const double a = random(rand), b = random(rand), c = random(rand), d = random(rand);
+    const HybridArb x = interval(a, b), y = interval(c, d);
+
+    REQUIRE(!x.is_arb());
+    REQUIRE(!y.is_arb());
+
+    // The extremal values of the operations are attained at the endpoints.
+    for (double s : {a, b}) {
+      for (double t : {c, d}) {
+        Arb expected;
+
+        arb_add(expected.arb_t(), exact(s).arb_t(), exact(t).arb_t(), ARF_PREC_EXACT);
+        REQUIRE(arb_contains(static_cast<Arb>(x + y).arb_t(), expected.arb_t()));
+
+        arb_sub(expected.arb_t(), exact(s).arb_t(), exact(t).arb_t(), ARF_PREC_EXACT);
+        REQUIRE(arb_contains(static_cast<Arb>(x - y).arb_t(), expected.arb_t()));
+
+        arb_mul(expected.arb_t(), exact(s).arb_t(), exact(t).arb_t(), ARF_PREC_EXACT);
+        REQUIRE(arb_contains(static_cast<Arb>(x * y).arb_t(), expected.arb_t()));
+
+        if ((c < 0) == (d < 0)) {
+          arb_div(expected.arb_t(), exact(s).arb_t(), exact(t).arb_t(), 512);
+          REQUIRE(arb_contains(static_cast<Arb>(x / y).arb_t(), expected.arb_t()));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Fallback of HybridArb to Arb", "[hybrid_arb]") {
+  const HybridArb huge{std::ldexp(1., 400)};
+
+  SECTION("Overflow") {
+    const auto x = huge * huge;
+    REQUIRE(x.is_arb());
+    REQUIRE(static_cast<Arb>(x).equal(Arb(mpz_class(mpz_class(1) << 800))));
+
+    // Results of modest magnitude are intervals of doubles again.
+    REQUIRE(!(x / huge).is_arb());
+    REQUIRE(*(x / huge == huge));
+  }
+
+  SECTION("Underflow") {
+    const auto x = HybridArb{1} / huge / huge;
+    REQUIRE(x.is_arb());
+    REQUIRE(*(x * huge * huge == HybridArb{1}));
+  }
+
+  SECTION("Division by Zero") {
+    const HybridArb zero;
+    REQUIRE((HybridArb{1} / zero).is_arb());
+    REQUIRE(!arb_is_finite(static_cast<Arb>(HybridArb{1} / zero).arb_t()));
+
+    const auto x = HybridArb{1} - HybridArb{1} / HybridArb{3};
+    const auto y = x - x;
+    REQUIRE((HybridArb{1} / y).is_arb());
+  }
+
+  SECTION("Large Integers") {
+    REQUIRE(!HybridArb{1L << 53}.is_arb());
+    REQUIRE(HybridArb{1L << 53}.is_exact());
+
+    // Integers that are not doubles are enclosed by an interval.
+    const HybridArb x{(1L << 53) + 1};
+    REQUIRE(!x.is_exact());
+    REQUIRE(arb_contains_si(static_cast<Arb>(x).arb_t(), (1L << 53) + 1));
+    REQUIRE(*(x < HybridArb{(1L << 53) + 5}));
+  }
+
+  SECTION("Non-finite Values") {
+    REQUIRE(HybridArb{INFINITY}.is_arb());
+    REQUIRE(HybridArb{NAN}.is_arb());
+  }
+}
+
+TEST_CASE("Relations of HybridArb", "[hybrid_arb]") {
+  const HybridArb one{1}, two{2}, third = one / HybridArb{3};
+
+  REQUIRE(*(one < two));
+  REQUIRE(*(two > one));
+  REQUIRE(*(one <= one));
+  REQUIRE(*(two >= one));
+  REQUIRE(*(one == one));
+  REQUIRE(*(one != two));
+  REQUIRE(!*(two < one));
+  REQUIRE(!*(one == two));
+
+  REQUIRE(!(third < third).has_value());
+  REQUIRE(!(third == third).has_value());
+  REQUIRE(!(third != third).has_value());
+  REQUIRE(*(third < one));
+
+  // Relations agree with the relations of Arb.
+  const HybridArb huge = HybridArb{std::ldexp(1., 400)} * HybridArb{std::ldexp(1., 400)};
+  REQUIRE(huge.is_arb());
+  REQUIRE(*(one < huge));
+  REQUIRE(*(huge == huge));
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,154 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../arbxx/interval_index.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+// Return length balls with random integer endpoints in [0, 4·length).
+std::vector<Arb> balls(::arbxx::size length, unsigned seed) {
+  std::mt19937 rand(seed);
+  std::vector<Arb> ret;
+  for (::arbxx::size i = 0; i < length; i++) {
+    const long lower = static_cast<long>(rand() % (4 * length));
+    const long upper = lower + static_cast<long>(rand() % 8);
+    ret.push_back(Arb{std::pair{Arf{lower}, Arf{upper}}});
+  }
+  return ret;
+}
+
+// Return whether x is certainly less than y, i.e., its upper endpoint is
+// below the lower endpoint of y.
+bool below(const Arb& x, const Arb& y) {
+  const auto [xl, xu] = static_cast<std::pair<Arf, Arf>>(x);
+  const auto [yl, yu] = static_cast<std::pair<Arf, Arf>>(y);
+  return xu < yl;
+}
+
+TEST_CASE("Sort and Cluster Balls", "[interval_index]") {
+  const ::arbxx::size length = GENERATE(0, 1, 2, 17, 1000);
+  const auto original = balls(length, static_cast<unsigned>(length));
+
+  auto x = original;
+  const auto permutation = interval_sort(x);
+
+  REQUIRE(permutation.size() == x.size());
+  for (size_t i = 0; i < x.size(); i++)
+    REQUIRE(x[i].equal(original[permutation[i]]));
+
+  for (size_t i = 1; i < x.size(); i++) {
+    const auto [lower, upper] = static_cast<std::pair<Arf, Arf>>(x[i - 1]);
+    const auto [next_lower, next_upper] = static_cast<std::pair<Arf, Arf>>(x[i]);
+    REQUIRE(lower <= next_lower);
+    if (lower == next_lower)
+      REQUIRE(upper <= next_upper);
+  }
+
+  const auto clusters = interval_clusters(x);
+  REQUIRE(clusters.front() == 0);
+  REQUIRE(clusters.back() == length);
+
+  for (size_t c = 0; c + 1 < clusters.size(); c++) {
+    // Clusters are not empty and connected.
+    REQUIRE(clusters[c] < clusters[c + 1]);
+    for (::arbxx::size i = clusters[c] + 1; i < clusters[c + 1]; i++)
+      REQUIRE(std::any_of(x.begin() + clusters[c], x.begin() + i, [&](const Arb& y) { return arb_overlaps(y.arb_t(), x[i].arb_t()); }));
+
+    // Balls in different clusters are ordered.
+    if (c + 2 < clusters.size())
+      for (::arbxx::size i = clusters[c]; i < clusters[c + 1]; i++)
+        REQUIRE(below(x[i], x[clusters[c + 1]]));
+  }
+}
+
+TEST_CASE("Sort Special Balls", "[interval_index]") {
+  Arb nan;
+  arb_indeterminate(nan.arb_t());
+
+  std::vector<Arb> x{Arb{1}, nan, Arb{0}};
+  REQUIRE(interval_sort(x) == std::vector<::arbxx::size>{1, 2, 0});
+  REQUIRE(interval_clusters(x) == std::vector<::arbxx::size>{0, 3});
+}
+
+TEST_CASE("Query Interval Index", "[interval_index]") {
+  const ::arbxx::size length = GENERATE(0, 1, 2, 17, 1000);
+  const auto x = balls(length, 1337);
+  const IntervalIndex index{x};
+
+  REQUIRE(index.size() == length);
+
+  std::mt19937 rand(42);
+
+  SECTION("Containing a Point") {
+    for (int i = 0; i < 100; i++) {
+      const Arf point{static_cast<long>(rand() % (4 * length + 8))};
+
+      std::vector<::arbxx::size> expected;
+      for (::arbxx::size j = 0; j < length; j++)
+        if (arb_contains_arf(x[j].arb_t(), point.arf_t()))
+          expected.push_back(j);
+
+      auto found = index.containing(point);
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+    }
+  }
+
+  SECTION("Overlapping a Ball") {
+    for (const auto& y : balls(100, 42)) {
+      std::vector<::arbxx::size> expected;
+      for (::arbxx::size j = 0; j < length; j++)
+        if (arb_overlaps(x[j].arb_t(), y.arb_t()))
+          expected.push_back(j);
+
+      auto found = index.overlapping(y);
+      std::sort(found.begin(), found.end());
+      REQUIRE(found == expected);
+    }
+  }
+}
+
+TEST_CASE("Query Interval Index of Random Balls", "[interval_index]") {
+  ArbTester arbs;
+
+  std::vector<Arb> x;
+  for (int i = 0; i < 256; i++)
+    x.push_back(arbs.random(64));
+
+  const IntervalIndex index{x};
+
+  for (int i = 0; i < 32; i++) {
+    const Arb y = arbs.random(64);
+    const auto found = index.overlapping(y);
+
+    // The index may only report more balls if it had to round endpoints.
+    for (size_t j = 0; j < x.size(); j++)
+      if (arb_overlaps(x[j].arb_t(), y.arb_t()))
+        REQUIRE(std::find(found.begin(), found.end(), j) != found.end());
+  }
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,152 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "../arbxx/arb_vector.hpp"
+#include "../arbxx/mapped_arb_array.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+// A file in the temporary directory that is removed at the end of a test.
+struct TemporaryFile {
+  TemporaryFile() : path(std::filesystem::temp_directory_path() / ("arbxx-mapped-arb-array-" + std::to_string(::getpid()) + "-" + std::to_string(counter++) + ".arbs")) {}
+
+  ~TemporaryFile() { std::filesystem::remove(path); }
+
+  std::filesystem::path path;
+
+  static inline int counter = 0;
+};
+
+TEST_CASE("Write and Map Arrays of Arb", "[mapped_arb_array]") {
+  const prec prec = GENERATE(53, 128, 256, 4096);
+  const size mag = GENERATE(10, 1024);
+
+  ArbTester arbs;
+  std::vector<Arb> values;
+  for (int i = 0; i < 256; i++)
+    values.push_back(arbs.random(prec, mag));
+
+  TemporaryFile file;
+  MappedArbArray::write(file.path, values);
+
+  const MappedArbArray array(file.path);
+  REQUIRE(array.size() == 256);
+
+  for (size i = 0; i < array.size(); i++) {
+    REQUIRE(array[i].equal(values[i]));
+    // References into the mapping are stable.
+    REQUIRE(&array[i] == &array[i]);
+  }
+
+  SECTION("Elements can be Used in Computations") {
+    Arb sum;
+    Arb expected;
+    for (size i = 0; i < array.size(); i++) {
+      arb_add(sum.arb_t(), sum.arb_t(), array[i].arb_t(), prec);
+      arb_add(expected.arb_t(), expected.arb_t(), values[i].arb_t(), prec);
+    }
+    REQUIRE(sum.equal(expected));
+
+    Arb copy = array[0];
+    copy += 1;
+    REQUIRE(array[0].equal(values[0]));
+  }
+
+  SECTION("Concurrent Access") {
+    // Threads race to resolve the same elements of a fresh mapping.
+    const MappedArbArray fresh(file.path);
+
+    std::vector<std::thread> threads;
+    std::vector<int> correct(4);
+    std::vector<std::vector<const Arb*>> addresses(4);
+    for (int t = 0; t < 4; t++)
+      threads.emplace_back([&, t]() {
+        for (size i = 0; i < fresh.size(); i++) {
+          correct[t] += fresh[i].equal(values[i]);
+          addresses[t].push_back(&fresh[i]);
+        }
+      });
+    for (auto& thread : threads)
+      thread.join();
+
+    for (int t = 0; t < 4; t++) {
+      REQUIRE(correct[t] == 256);
+      REQUIRE(addresses[t] == addresses[0]);
+    }
+  }
+}
+
+TEST_CASE("Map Special Arb Elements", "[mapped_arb_array]") {
+  const std::vector<Arb> values{
+      Arb(),
+      Arb(1),
+      Arb::zero_pm_inf(),
+      Arb::indeterminate(),
+      Arb(std::pair{Arf(1) << (1L << 62), Arf(1) << (1L << 62)}),
+      Arb(std::pair{-(Arf((mpz_class(1) << 1024) + 1, -1) >> ((1L << 62) + 8)), Arf(1)}),
+  };
+
+  TemporaryFile file;
+  MappedArbArray::write(file.path, ArbVector(values));
+
+  MappedArbArray array(file.path);
+  REQUIRE(array.size() == static_cast<size>(values.size()));
+  for (size i = 0; i < array.size(); i++)
+    REQUIRE(array[i].equal(values[i]));
+
+  MappedArbArray moved = std::move(array);
+  REQUIRE(moved.size() == static_cast<size>(values.size()));
+  REQUIRE(moved[5].equal(values[5]));
+}
+
+TEST_CASE("Map Empty and Malformed Files", "[mapped_arb_array]") {
+  TemporaryFile file;
+
+  MappedArbArray::write(file.path, std::vector<Arb>{});
+  REQUIRE(MappedArbArray(file.path).empty());
+
+  SECTION("Missing File") {
+    REQUIRE_THROWS_AS(MappedArbArray(file.path.string() + ".missing"), std::system_error);
+  }
+
+  SECTION("Not an Array") {
+    std::ofstream(file.path) << std::string(128, 'x');
+    REQUIRE_THROWS_AS(MappedArbArray(file.path), std::logic_error);
+  }
+
+  SECTION("Truncated File") {
+    MappedArbArray::write(file.path, std::vector<Arb>(16));
+    std::filesystem::resize_file(file.path, 128);
+    REQUIRE_THROWS_AS(MappedArbArray(file.path), std::logic_error);
+  }
+}
+
+}  // namespace arbxx::test
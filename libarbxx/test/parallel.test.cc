@@ -0,0 +1,110 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../arbxx/arb_vector.hpp"
+#include "../arbxx/parallel.hpp"
+#include "../arbxx/threads.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Parallel Sums", "[parallel]") {
+  ArbTester arbs;
+
+  const prec prec = GENERATE(2, 64, 256);
+  // Lengths around multiples of the chunk size of the implementation.
+  const ::arbxx::size length = GENERATE(0, 1, 4095, 4096, 4097, 3 * 4096 + 1, 20000);
+
+  std::vector<Arb> x, y;
+  for (::arbxx::size i = 0; i < length; i++) {
+    x.push_back(arbs.random(prec));
+    y.push_back(arbs.random(prec));
+  }
+
+  const Arb sum = parallel::sum(x, prec);
+  const Arb dot = parallel::dot(x, y, prec);
+
+  SECTION("Results do not Depend on the Number of Threads") {
+    const int threads = GENERATE(2, 3, 8);
+    ThreadScope scope{threads};
+
+    REQUIRE(parallel::sum(x, prec).equal(sum));
+    REQUIRE(parallel::dot(x, y, prec).equal(dot));
+  }
+
+  SECTION("Results Contain the Serial Results") {
+    Arb expected;
+    for (const auto& xi : x)
+      arb_add(expected.arb_t(), expected.arb_t(), xi.arb_t(), 4 * prec);
+    REQUIRE(arb_overlaps(sum.arb_t(), expected.arb_t()));
+
+    arb_dot(expected.arb_t(), nullptr, 0, x.empty() ? nullptr : x[0].arb_t(), 1, y.empty() ? nullptr : y[0].arb_t(), 1, length, 4 * prec);
+    REQUIRE(arb_overlaps(dot.arb_t(), expected.arb_t()));
+  }
+}
+
+TEST_CASE("Parallel Sums of Exact Elements", "[parallel]") {
+  ThreadScope scope{4};
+
+  ArbVector x(10000);
+  for (::arbxx::size i = 0; i < x.size(); i++)
+    x[i] = i;
+
+  REQUIRE(*(parallel::sum(x, 64) == 9999 * 10000 / 2));
+  REQUIRE(*(parallel::dot(x, x, 64) == 9999L * 10000 * 19999 / 6));
+}
+
+TEST_CASE("Thread Scopes in Concurrent Threads", "[parallel]") {
+  // Creating and destroying scopes must not disturb other threads that are
+  // using the shared thread pool at the same time.
+  ArbVector x(10000);
+  for (::arbxx::size i = 0; i < x.size(); i++)
+    x[i] = i;
+
+  std::vector<int> correct(4);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      correct[t] = ThreadScope::threads() == 1;
+      for (int i = 0; i < 64; i++) {
+        ThreadScope scope{2 + (i + t) % 4};
+        correct[t] = correct[t] && ThreadScope::threads() == 2 + (i + t) % 4;
+        correct[t] = correct[t] && *(parallel::sum(x, 64) == 9999 * 10000 / 2);
+      }
+      correct[t] = correct[t] && ThreadScope::threads() == 1;
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int t = 0; t < 4; t++)
+    REQUIRE(correct[t]);
+}
+
+TEST_CASE("Parallel Sums of Vectors of Different Length", "[parallel]") {
+  const std::vector<Arb> x(2), y(3);
+  REQUIRE_THROWS_AS(parallel::dot(x, y, 64), std::invalid_argument);
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,202 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "../arbxx/parse.hpp"
+#include "../arbxx/threads.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+// Return a random plain decimal number.
+std::string decimal(std::mt19937& rand) {
+  std::string ret;
+  if (rand() % 2)
+    ret += '-';
+  for (unsigned i = rand() % 30; i > 0; i--)
+    ret += static_cast<char>('0' + rand() % 10);
+  if (rand() % 2) {
+    ret += '.';
+    for (unsigned i = rand() % 30; i > 0; i--)
+      ret += static_cast<char>('0' + rand() % 10);
+  }
+  ret += '1';
+  if (rand() % 2)
+    ret += "e" + std::to_string(static_cast<int>(rand() % 200) - 100);
+  return ret;
+}
+
+TEST_CASE("Parse Decimal Numbers", "[parse]") {
+  const prec prec = GENERATE(2, 64, 256, 1024);
+
+  SECTION("Exact Values") {
+    REQUIRE(parse("0", prec).equal(Arb{}));
+    REQUIRE(parse("-0.000", prec).equal(Arb{}));
+    REQUIRE(parse("+1", prec).equal(Arb{1}));
+    REQUIRE(parse("-0.5", prec).equal(Arb{mpq_class{-1, 2}, prec}));
+    REQUIRE(parse(" 3.25e2\r", prec).equal(parse("325", prec)));
+    REQUIRE(parse("1.", prec).equal(Arb{1}));
+    REQUIRE(parse(".125E+1", prec).equal(Arb{mpq_class{5, 4}, prec}));
+  }
+
+  SECTION("Agrees with arb_set_str()") {
+    std::mt19937 rand(static_cast<unsigned>(prec));
+    for (int i = 0; i < 1024; i++) {
+      const std::string value = decimal(rand);
+      CAPTURE(value);
+
+      Arb x;
+      REQUIRE(parse(x, value, prec));
+
+      const Arb expected(value, prec);
+      REQUIRE(arb_overlaps(x.arb_t(), expected.arb_t()));
+      REQUIRE(arb_rel_accuracy_bits(x.arb_t()) >= arb_rel_accuracy_bits(expected.arb_t()) - 2);
+    }
+  }
+}
+
+TEST_CASE("Parse Other Representations", "[parse]") {
+  for (const std::string value : {"[1.5 +/- 0.25]", "1.5 +/- 0.25", "inf", "-inf", "nan"}) {
+    CAPTURE(value);
+    Arb x;
+    REQUIRE(parse(x, value, 64));
+    REQUIRE(x.equal(Arb(value, 64)));
+  }
+}
+
+TEST_CASE("Parse Malformed Strings", "[parse]") {
+  for (const std::string& value : std::vector<std::string>{"", " ", "1/3", "1e", "e5", "--1", "1.2.3", "1,2", "x", std::string("1\0", 2)}) {
+    CAPTURE(value);
+    Arb x{1};
+    REQUIRE(!parse(x, value, 64));
+    REQUIRE(!x.is_finite());
+    REQUIRE_THROWS_AS(parse(value, 64), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Ingest Buffers", "[parse]") {
+  SECTION("Separators") {
+    std::vector<Arb> x;
+
+    REQUIRE(ingest(x, "", 64).count == 0);
+    REQUIRE(ingest(x, " \n", 64).count == 0);
+
+    auto result = ingest(x, "1,2\r\n3 , 4\n\n", 64);
+    REQUIRE(result.count == 4);
+    REQUIRE(result.errors.empty());
+    for (int i = 0; i < 4; i++)
+      REQUIRE(x[i].equal(Arb{i + 1}));
+
+    result = ingest(x, "1,,2,", 64);
+    REQUIRE(result.count == 3);
+    REQUIRE(result.errors.size() == 1);
+    REQUIRE(result.errors[0].index == 1);
+    REQUIRE(result.errors[0].offset == 2);
+  }
+
+  SECTION("Errors") {
+    std::vector<Arb> x(3);
+    const auto result = ingest(x.data(), x.size(), "1.5,2\nx\n", 64);
+    REQUIRE(result.count == 3);
+    REQUIRE(result.errors.size() == 1);
+    REQUIRE(result.errors[0].index == 2);
+    REQUIRE(result.errors[0].offset == 6);
+    REQUIRE(!x[2].is_finite());
+  }
+
+  SECTION("Capacity") {
+    std::vector<Arb> x(2);
+    REQUIRE_THROWS_AS(ingest(x.data(), x.size(), "1\n2\n3", 64), std::invalid_argument);
+    REQUIRE(x[0].equal(Arb{}));
+  }
+}
+
+TEST_CASE("Ingest Large Buffers", "[parse]") {
+  std::mt19937 rand(1337);
+
+  // Enough input to be split into several chunks by the implementation.
+  std::vector<std::string> values;
+  std::string buffer;
+  for (int i = 0; i < 100000; i++) {
+    values.push_back(i % 997 == 0 ? "?" : decimal(rand));
+    buffer += values.back();
+    buffer += i % 3 ? '\n' : ',';
+  }
+
+  std::vector<Arb> x;
+  const auto result = ingest(x, buffer, 64);
+
+  REQUIRE(result.count == static_cast<::arbxx::size>(values.size()));
+  REQUIRE(result.errors.size() == 101);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    Arb expected;
+    parse(expected, values[i], 64);
+    REQUIRE(x[i].equal(expected));
+  }
+
+  for (const auto& error : result.errors) {
+    REQUIRE(values[error.index] == "?");
+    REQUIRE(buffer[error.offset] == '?');
+  }
+
+  SECTION("Results do not Depend on the Number of Threads") {
+    const int threads = GENERATE(2, 3, 8);
+    ThreadScope scope{threads};
+
+    std::vector<Arb> y;
+    const auto parallel = ingest(y, buffer, 64);
+
+    REQUIRE(parallel.count == result.count);
+    REQUIRE(parallel.errors.size() == result.errors.size());
+    for (size_t i = 0; i < result.errors.size(); i++)
+      REQUIRE(parallel.errors[i].index == result.errors[i].index);
+    for (size_t i = 0; i < x.size(); i++)
+      REQUIRE(y[i].equal(x[i]));
+  }
+}
+
+TEST_CASE("Ingest Files", "[parse]") {
+  const auto path = std::filesystem::temp_directory_path() / ("arbxx-parse-" + std::to_string(::getpid()) + ".csv");
+
+  std::ofstream(path) << "1\n0.25\n[1 +/- 1]\n";
+
+  std::vector<Arb> x;
+  const auto result = ingest_file(x, path, 64);
+  std::filesystem::remove(path);
+
+  REQUIRE(result.count == 3);
+  REQUIRE(result.errors.empty());
+  REQUIRE(x[1].equal(Arb{mpq_class{1, 4}, 64}));
+
+  REQUIRE_THROWS_AS(ingest_file(x, path, 64), std::system_error);
+}
+
+}  // namespace arbxx::test
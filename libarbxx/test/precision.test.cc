@@ -0,0 +1,171 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <thread>
+#include <vector>
+
+#include "../arbxx/precision.hpp"
+#include "../arbxx/yap/arb.hpp"
+#include "arb.hpp"
+#include "arf.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Nesting of Precision Scopes", "[precision]") {
+  REQUIRE(PrecisionScope::precision() == ARB_PRECISION_FAST);
+  REQUIRE(PrecisionScope::round() == Arf::Round::NEAR);
+
+  {
+    PrecisionScope outer(256, Arf::Round::DOWN);
+    REQUIRE(PrecisionScope::precision() == 256);
+    REQUIRE(PrecisionScope::round() == Arf::Round::DOWN);
+
+    {
+      PrecisionScope inner(1024);
+      REQUIRE(PrecisionScope::precision() == 1024);
+      REQUIRE(PrecisionScope::round() == Arf::Round::NEAR);
+    }
+
+    REQUIRE(PrecisionScope::precision() == 256);
+    REQUIRE(PrecisionScope::round() == Arf::Round::DOWN);
+  }
+
+  REQUIRE(PrecisionScope::precision() == ARB_PRECISION_FAST);
+  REQUIRE(PrecisionScope::round() == Arf::Round::NEAR);
+}
+
+TEST_CASE("In-place Arithmetic with Arb", "[precision][arb]") {
+  ArbTester arbs;
+  const prec prec = GENERATE(2, 64, 256);
+
+  PrecisionScope scope(prec);
+
+  for (int i = 0; i < 128; i++) {
+    Arb x = arbs.random(), y = arbs.random(), z = arbs.random();
+    Arb expected;
+
+    Arb actual = x;
+    actual += y;
+    arb_add(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(actual.equal(expected));
+
+    actual = x;
+    actual -= 3;
+    arb_sub_si(expected.arb_t(), x.arb_t(), 3, prec);
+    REQUIRE(actual.equal(expected));
+
+    actual = x;
+    actual *= 3;
+    arb_mul_si(expected.arb_t(), x.arb_t(), 3, prec);
+    REQUIRE(actual.equal(expected));
+
+    actual = x;
+    actual /= y;
+    arb_div(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(actual.equal(expected));
+
+    actual = x;
+    actual += y * z;
+    expected = x;
+    arb_addmul(expected.arb_t(), y.arb_t(), z.arb_t(), prec);
+    REQUIRE(actual.equal(expected));
+
+    actual = x;
+    actual -= actual * y;
+    expected = x;
+    arb_submul(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    REQUIRE(actual.equal(expected));
+
+    actual = x;
+    actual *= actual + y;
+    arb_add(expected.arb_t(), x.arb_t(), y.arb_t(), prec);
+    arb_mul(expected.arb_t(), x.arb_t(), expected.arb_t(), prec);
+    REQUIRE(actual.equal(expected));
+  }
+}
+
+TEST_CASE("In-place Arithmetic with Arf", "[precision][arf]") {
+  ArfTester arfs;
+  const prec prec = GENERATE(2, 64, 256);
+  const Arf::Round round = GENERATE(Arf::Round::NEAR, Arf::Round::DOWN, Arf::Round::UP, Arf::Round::FLOOR, Arf::Round::CEIL);
+
+  PrecisionScope scope(prec, round);
+
+  for (int i = 0; i < 128; i++) {
+    Arf x = arfs.random(), y = arfs.random();
+    Arf expected;
+
+    Arf actual = x;
+    actual += y;
+    arf_add(expected.arf_t(), x.arf_t(), y.arf_t(), prec, static_cast<arf_rnd_t>(round));
+    REQUIRE(actual == expected);
+
+    actual = x;
+    actual -= 3u;
+    arf_sub_ui(expected.arf_t(), x.arf_t(), 3, prec, static_cast<arf_rnd_t>(round));
+    REQUIRE(actual == expected);
+
+    actual = x;
+    actual *= y;
+    arf_mul(expected.arf_t(), x.arf_t(), y.arf_t(), prec, static_cast<arf_rnd_t>(round));
+    REQUIRE(actual == expected);
+
+    if (y != 0) {
+      actual = x;
+      actual /= y;
+      arf_div(expected.arf_t(), x.arf_t(), y.arf_t(), prec, static_cast<arf_rnd_t>(round));
+      REQUIRE(actual == expected);
+    }
+  }
+}
+
+TEST_CASE("Precision Scopes are Thread Local", "[precision]") {
+  PrecisionScope scope(1024);
+
+  std::vector<int> decided(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < decided.size(); i++) {
+    threads.emplace_back([&, i]() {
+      // A new thread does not see the scope of its parent.
+      if (PrecisionScope::precision() != ARB_PRECISION_FAST) return;
+
+      const prec precision = static_cast<prec>(64 * (i + 1));
+      PrecisionScope scope(precision);
+
+      Arb x(1);
+      x /= 3;
+
+      Arb expected(1);
+      arb_div_si(expected.arb_t(), expected.arb_t(), 3, precision);
+
+      decided[i] = x.equal(expected);
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto d : decided)
+    REQUIRE(d);
+
+  REQUIRE(PrecisionScope::precision() == 1024);
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,117 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <thread>
+#include <vector>
+
+#include "../arbxx/shared_arb.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+TEST_CASE("Copies of SharedArb", "[shared_arb]") {
+  ArbTester arbs;
+
+  const Arb x = arbs.random(65536);
+  const SharedArb shared{x};
+
+  REQUIRE(!shared.shared());
+  REQUIRE(shared->equal(x));
+
+  SECTION("Copies Share Storage") {
+    const SharedArb copy = shared;
+    REQUIRE(shared.shared());
+    REQUIRE(&*copy == &*shared);
+    REQUIRE(copy.equal(shared));
+
+    SharedArb assigned;
+    assigned = copy;
+    REQUIRE(&*assigned == &*shared);
+  }
+
+  SECTION("Moved from Elements are Valid") {
+    SharedArb source = shared;
+    const SharedArb target = std::move(source);
+    REQUIRE(target.equal(shared));
+    REQUIRE(source->is_finite());
+  }
+
+  SECTION("Mutation Copies Shared Storage") {
+    SharedArb copy = shared;
+    copy.mutate() = 1;
+
+    REQUIRE(shared->equal(x));
+    REQUIRE(copy->equal(Arb(1)));
+    REQUIRE(!shared.shared());
+    REQUIRE(!copy.shared());
+
+    // Storage that is not shared is modified in place.
+    const Arb* storage = &*copy;
+    copy.mutate() = 2;
+    REQUIRE(&*copy == storage);
+  }
+
+  SECTION("Default Elements") {
+    SharedArb zero;
+    REQUIRE(zero->equal(Arb()));
+
+    zero.mutate() = 1;
+    REQUIRE(SharedArb()->equal(Arb()));
+  }
+
+  SECTION("Relations") {
+    const SharedArb one{Arb(1)}, two{Arb(2)};
+    REQUIRE(*(one < two));
+    REQUIRE(*(two > one));
+    REQUIRE(*(one != two));
+    REQUIRE(!(shared == shared).has_value());
+  }
+}
+
+TEST_CASE("Concurrent Readers of SharedArb", "[shared_arb]") {
+  ArbTester arbs;
+
+  const Arb x = arbs.random(4096);
+  const SharedArb shared{x};
+
+  std::vector<std::thread> threads;
+  std::vector<int> equal(4);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      equal[t] = true;
+      for (int i = 0; i < 1024; i++) {
+        SharedArb copy = shared;
+        equal[t] = equal[t] && copy->equal(x);
+        if (i % 2 == t % 2)
+          copy.mutate() = i;
+        equal[t] = equal[t] && shared->equal(x);
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int t = 0; t < 4; t++)
+    REQUIRE(equal[t]);
+  REQUIRE(!shared.shared());
+}
+
+}  // namespace arbxx::test
@@ -0,0 +1,108 @@
+/**********************************************************************
+ *  This file is part of arbxx.
+ *
+ *        Copyright (C) 2022 Julian Rüth
+ *
+ *  arbxx is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  arbxx is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+ *********************************************************************/
+
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "../arbxx/arb.hpp"
+#include "../arbxx/arf.hpp"
+#include "../arbxx/to_chars.hpp"
+#include "arb.hpp"
+#include "external/catch2/single_include/catch2/catch.hpp"
+
+namespace arbxx::test {
+
+namespace {
+
+template <typename T>
+std::string to_string(const T& x, DecimalFormat format = {}) {
+  char buffer[1024];
+  const auto [end, ec] = to_chars(buffer, buffer + sizeof(buffer), x, format);
+  REQUIRE(ec == std::errc());
+  return std::string(buffer, end);
+}
+
+}  // namespace
+
+TEST_CASE("Decimal Representation of Arb", "[to_chars]") {
+  REQUIRE(to_string(Arb()) == "0");
+  REQUIRE(to_string(Arb(1337)) == "1337.00");
+  REQUIRE(to_string(Arb(-2)) == "-2.00000");
+  REQUIRE(to_string(Arb(mpq_class(1, 2), 1)) == "0.500000");
+  REQUIRE(to_string(Arb(mpq_class(-1, 8), 64)) == "-0.125000");
+  REQUIRE(to_string(Arb(mpq_class(1, 3), 64)) == "[0.333333 +/- 3.34e-7]");
+  REQUIRE(to_string(Arb(mpq_class(1, 3), 64), {3, 2}) == "[0.333 +/- 0.00034]");
+  REQUIRE(to_string(Arb(mpq_class(1, 3), 64), {3, 0}) == "0.333");
+  REQUIRE(to_string(Arb(mpz_class("1" + std::string(300, '0')))) == "1.00000e+300");
+  REQUIRE(to_string(Arb::zero_pm_one()) == "[+/- 1.00]");
+
+  REQUIRE(to_string(Arb::pos_inf()) == "+inf");
+  REQUIRE(to_string(Arb::neg_inf()) == "-inf");
+  REQUIRE(to_string(Arb::zero_pm_inf()) == "[+/- inf]");
+  REQUIRE(to_string(Arb::indeterminate()) == "nan");
+}
+
+TEST_CASE("Decimal Representation of Arf", "[to_chars]") {
+  REQUIRE(to_string(Arf()) == "0");
+  REQUIRE(to_string(Arf(-1) >>= 1) == "-0.500000");
+  REQUIRE(to_string(Arf(1) >>= 100) == "7.88861e-31");
+  REQUIRE(to_string(Arf(1) >>= 100, {2, 0}) == "7.9e-31");
+}
+
+TEST_CASE("Decimal Representations Contain the Original Element", "[to_chars]") {
+  ArbTester arbs;
+
+  const prec prec = GENERATE(2, 64, 256);
+  const int digits = GENERATE(1, 6, 30);
+
+  for (int i = 0; i < 64; i++) {
+    const Arb x = i % 2 ? arbs.random(prec) : Arb::randtest_exact(*arbs.flint_rand, prec, 10);
+    const std::string s = to_string(x, {digits, 3});
+
+    CAPTURE(x, s);
+    const Arb parsed(s, 4 * prec + 4 * digits);
+    REQUIRE(arb_contains(parsed.arb_t(), x.arb_t()));
+  }
+}
+
+TEST_CASE("Decimal Representation in Short Buffers", "[to_chars]") {
+  char buffer[8];
+  auto result = to_chars(buffer, buffer + sizeof(buffer), Arb(mpq_class(1, 3), 64));
+  REQUIRE(result.ec == std::errc::value_too_large);
+  REQUIRE(result.ptr == buffer + sizeof(buffer));
+
+  result = to_chars(buffer, buffer + sizeof(buffer), Arb(1));
+  REQUIRE(result.ec == std::errc());
+  REQUIRE(std::string(buffer, result.ptr) == "1.00000");
+}
+
+TEST_CASE("Bulk Decimal Representation", "[to_chars]") {
+  const std::vector<Arb> x{Arb(1), Arb(mpq_class(1, 3), 64), Arb(-2)};
+
+  DecimalFormatter formatter;
+  std::string out;
+  formatter.append(out, x.data(), static_cast<::arbxx::size>(x.size()));
+  formatter.append(out, x.data(), 1, ';');
+
+  REQUIRE(out == "1.00000\n[0.333333 +/- 3.34e-7]\n-2.00000\n1.00000;");
+  REQUIRE(formatter.format(x[2]) == "-2.00000");
+}
+
+}  // namespace arbxx::test
@@ -110,7 +110,7 @@ def add_pythonization(pythonization, namespace, predicate=lambda *args: True):
 # add_pythonization(enable_arithmetic, "arbxx", arithmetic_predicate)
 
 def enable_optional(proxy, name):
-    if name in  ["Arb"]:
+    if name in  ["Arb", "Acb"]:
         def unwrap_logical_optional(x):
             if not hasattr(x, 'has_value'):
                 return x
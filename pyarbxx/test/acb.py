@@ -0,0 +1,62 @@
+#!/usr/bin/env python
+
+######################################################################
+#  This file is part of arbxx.
+#
+#        Copyright (C)      2019 Vincent Delecroix
+#        Copyright (C) 2019-2022 Julian Rüth
+#
+#  arbxx is free software: you can redistribute it and/or modify
+#  it under the terms of the GNU General Public License as published by
+#  the Free Software Foundation, either version 3 of the License, or
+#  (at your option) any later version.
+#
+#  arbxx is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#  GNU General Public License for more details.
+#
+#  You should have received a copy of the GNU General Public License
+#  along with arbxx. If not, see <https://www.gnu.org/licenses/>.
+######################################################################
+
+import sys
+import pytest
+import cppyy
+
+from pyarbxx import arbxx
+from pyarbxx.cppyy_arbxx import PrecisionError
+Arb = arbxx.Arb
+Acb = arbxx.Acb
+
+def test_relations():
+    a = Acb(Arb(1), Arb(2))
+    b = Acb(Arb(1), Arb(-2))
+
+    assert a == a
+    assert not (a != a)
+    assert a != b
+    assert not (a == b)
+
+    c = Acb(cppyy.gbl.mpq_class(1, 3), 64)
+    with pytest.raises(PrecisionError):
+        c == c
+    with pytest.raises(PrecisionError):
+        c != c
+
+def test_eval():
+    a = Acb(Arb(cppyy.gbl.mpq_class(1, 3), 256), Arb(1))
+    b = arbxx.cppyy.eval(a, 64)
+
+    assert str(b) == "[0.333333 +/- 3.34e-7] + 1.00000*I"
+    assert b != 0
+
+def test_printing():
+    assert str(Acb()) == "0"
+    assert str(Acb(1)) == "1.00000"
+    assert str(Acb.i()) == "1.00000*I"
+    assert str(Acb(Arb(1), Arb(2))) == "1.00000 + 2.00000*I"
+    assert str(Acb(Arb(1), Arb(-2))) == "1.00000 - 2.00000*I"
+    assert repr(Acb(Arb(1), Arb(2))) == "1.00000 + 2.00000*I"
+
+if __name__ == '__main__': sys.exit(pytest.main(sys.argv))